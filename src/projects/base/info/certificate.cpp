@@ -42,6 +42,8 @@ namespace info
 
 		_host_name_list = host_name_list;
 
+		_is_kernel_tls_enabled = tls.IsKernelTlsEnabled();
+
 		ov::String cert_path = tls.GetCertPath();
 		ov::String key_path = tls.GetKeyPath();
 		ov::String chain_cert_path = tls.GetChainCertPath();
@@ -33,6 +33,12 @@ namespace info
 			return _chain_certificate;
 		}
 
+		// Whether to offload the encryption of the records to the kernel (<KernelTLS>)
+		bool IsKernelTlsEnabled() const
+		{
+			return _is_kernel_tls_enabled;
+		}
+
 	protected:
 		std::shared_ptr<ov::Error> PrepareCertificate(const ov::String &certificate_name, const std::vector<ov::String> &host_name_list, const cfg::cmn::Tls &tls);
 
@@ -41,5 +47,7 @@ namespace info
 
 		std::shared_ptr<::Certificate> _certificate;
 		std::shared_ptr<::Certificate> _chain_certificate;
+
+		bool _is_kernel_tls_enabled = false;
 	};
 }  // namespace info
\ No newline at end of file
@@ -323,6 +323,41 @@ public:
 		return 0;
 	}
 
+	// Refer to the memory of the native frame without copying it.
+	// The memory must be kept alive by the native frame (See SetNativeFrame()).
+	void SetBufferReference(const uint8_t *data, int32_t data_size, int32_t plane = 0)
+	{
+		if ((data == nullptr) || (data_size <= 0))
+		{
+			_data_buffer[plane] = std::make_shared<ov::Data>();
+			return;
+		}
+
+		_data_buffer[plane] = std::make_shared<ov::Data>(data, data_size, true);
+	}
+
+	// Attach a reference-counted frame owned by an external library (e.g. AVFrame of FFmpeg).
+	// While the native frame is attached, the planes (See SetBufferReference()) point into it,
+	// so the frame can be passed from the decoder to the filters and the encoders without memcpy.
+	//
+	// The native frame is treated as immutable. If any plane is modified through this instance,
+	// the planes are copied and the native frame is detached (copy-on-write).
+	void SetNativeFrame(std::shared_ptr<void> native_frame)
+	{
+		_native_frame = std::move(native_frame);
+	}
+
+	template <typename T>
+	const T *GetNativeFrame() const
+	{
+		return static_cast<const T *>(_native_frame.get());
+	}
+
+	bool HasNativeFrame() const
+	{
+		return (_native_frame != nullptr);
+	}
+
 	// 메모리만 미리 할당함
 	void Reserve(uint32_t capacity, int32_t plane = 0)
 	{
@@ -559,9 +594,14 @@ public:
 
 			for (int i = 0; i < 3; ++i)
 			{
+				auto plane_data = GetPlainData(i);
+
 				frame->SetStride(GetStride(i), i);
-				frame->SetPlainData(GetPlainData(i)->Clone(), i);
+				frame->SetPlainData((plane_data != nullptr) ? plane_data->Clone() : std::make_shared<ov::Data>(), i);
 			}
+
+			// The planes still refer to the native frame, so share it instead of copying the planes
+			frame->SetNativeFrame(_native_frame);
 		}
 		else if (_media_type == cmn::MediaType::Audio)
 		{
@@ -607,6 +647,11 @@ private:
 
 	std::shared_ptr<ov::Data> AllocPlainData(int32_t plane)
 	{
+		if (_native_frame != nullptr)
+		{
+			DetachNativeFrame();
+		}
+
 		auto item = _data_buffer.find(plane);
 
 		if (item == _data_buffer.end())
@@ -621,8 +666,27 @@ private:
 		return item->second;
 	}
 
+	// Copy the planes that refer to the native frame, then release the native frame
+	void DetachNativeFrame()
+	{
+		for (auto &item : _data_buffer)
+		{
+			auto &plane_data = item.second;
+
+			if ((plane_data != nullptr) && (plane_data->IsEmpty() == false))
+			{
+				// GetWritableData() copies the referenced memory
+				plane_data->GetWritableData();
+			}
+		}
+
+		_native_frame = nullptr;
+	}
+
 	// Data plane, Data
 	std::map<int32_t, std::shared_ptr<ov::Data>> _data_buffer;
+	// Reference-counted frame of an external library that owns the memory of the planes
+	std::shared_ptr<void> _native_frame;
 	cmn::MediaType _media_type = cmn::MediaType::Unknown;
 	int32_t _track_id = 0;
 	int64_t _pts = 0LL;
@@ -516,6 +516,14 @@ namespace ov
 		::SSL_CTX_set_verify(_ssl_ctx, mode, nullptr);
 	}
 
+	void Tls::SetOptions(uint64_t options)
+	{
+		if (_ssl != nullptr)
+		{
+			::SSL_set_options(_ssl, options);
+		}
+	}
+
 	std::shared_ptr<Certificate> Tls::GetPeerCertificate() const
 	{
 		OV_ASSERT2(_ssl != nullptr);
@@ -145,6 +145,9 @@ namespace ov
 
 		void SetVerify(int flags);
 
+		// Adds the options to the SSL session (SSL_set_options())
+		void SetOptions(uint64_t options);
+
 		std::shared_ptr<Certificate> GetPeerCertificate() const;
 		bool ExportKeyingMaterial(unsigned long crypto_suite, const ov::String &label, std::shared_ptr<ov::Data> &server_key, std::shared_ptr<ov::Data> &client_key);
 
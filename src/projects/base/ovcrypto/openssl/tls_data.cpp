@@ -8,6 +8,30 @@
 //==============================================================================
 #include "tls_data.h"
 
+#if defined(__linux__) && defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#	include <linux/tls.h>
+#	include <netinet/tcp.h>
+#	include <sys/socket.h>
+
+#	define OV_TLS_KERNEL_TLS_SUPPORTED 1
+#else
+#	define OV_TLS_KERNEL_TLS_SUPPORTED 0
+#endif
+
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+// BIO_CTRL_SET_KTLS* are not exported by OpenSSL (include/internal/bio.h)
+#	define OV_BIO_CTRL_SET_KTLS 72
+#	define OV_BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG 74
+#	define OV_BIO_CTRL_CLEAR_KTLS_TX_CTRL_MSG 75
+
+#	ifndef SOL_TLS
+#		define SOL_TLS 282
+#	endif	// SOL_TLS
+
+// Set when the kernel doesn't support TLS ULP (tls module is not loaded) to avoid trying it for every connection
+static std::atomic<bool> g_kernel_tls_unavailable(false);
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+
 #define OV_LOG_TAG "OpenSSL"
 
 namespace ov
@@ -23,23 +47,7 @@ namespace ov
 				.read_callback = std::bind(&TlsData::OnTlsRead, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
 				.write_callback = std::bind(&TlsData::OnTlsWrite, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
 				.destroy_callback = nullptr,
-				.ctrl_callback = [](ov::Tls *tls, int cmd, long num, void *arg) -> long {
-					logtd("[TLS] Ctrl: %d, %ld, %p", cmd, num, arg);
-
-					switch (cmd)
-					{
-						case BIO_CTRL_RESET:
-						case BIO_CTRL_WPENDING:
-						case BIO_CTRL_PENDING:
-							return 0;
-
-						case BIO_CTRL_FLUSH:
-							return 1;
-
-						default:
-							return 0;
-					}
-				},
+				.ctrl_callback = std::bind(&TlsData::OnTlsCtrl, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4),
 				.verify_callback = nullptr};
 
 		const SSL_METHOD *tls_method = nullptr;
@@ -140,6 +148,18 @@ namespace ov
 			return false;
 		}
 
+		if (_is_kernel_tls_started)
+		{
+			if (_is_kernel_tls_failed)
+			{
+				return false;
+			}
+
+			// The kernel encrypts the data
+			*cipher_data = plain_data;
+			return true;
+		}
+
 		logtd("Trying to encrypt the data for TLS\n%s", plain_data->Dump(32).CStr());
 
 		size_t written_bytes = 0;
@@ -176,6 +196,17 @@ namespace ov
 
 	ssize_t TlsData::OnTlsWrite(ov::Tls *tls, const void *data, size_t length)
 	{
+		if (_is_kernel_tls_started && (_kernel_tls_record_type != 0))
+		{
+			// The kernel owns the record sequence number, so the record is sent through the socket
+			return SendKernelTlsControlRecord(data, length);
+		}
+
+		if (_kernel_tls_crypto_info != nullptr)
+		{
+			CountKernelTlsRecords(static_cast<const uint8_t *>(data), length);
+		}
+
 		if (_state == State::WaitingForAccept)
 		{
 			if (_write_callback != nullptr)
@@ -200,4 +231,312 @@ namespace ov
 
 		return length;
 	}
+
+	long TlsData::OnTlsCtrl(ov::Tls *tls, int cmd, long num, void *ptr)
+	{
+		logtd("[TLS] Ctrl: %d, %ld, %p", cmd, num, ptr);
+
+		switch (cmd)
+		{
+			case BIO_CTRL_RESET:
+			case BIO_CTRL_WPENDING:
+			case BIO_CTRL_PENDING:
+				return 0;
+
+			case BIO_CTRL_FLUSH:
+				return 1;
+
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+			case OV_BIO_CTRL_SET_KTLS:
+				// num: 1 if the key is for sending (RX offload is not used)
+				if ((num == 0) || (ptr == nullptr))
+				{
+					return 0;
+				}
+
+				if (_is_kernel_tls_started)
+				{
+					// The write key is updated after the handover (TLS 1.3 KeyUpdate)
+					return UpdateKernelTlsKey(ptr) ? 1 : 0;
+				}
+
+				if (_is_kernel_tls_requested)
+				{
+					SaveKernelTlsCryptoInfo(ptr);
+				}
+
+				// Returns 0 to make OpenSSL keep encrypting the records (Finished, NewSessionTicket, ...)
+				// until the handshake is done. StartKernelTls() takes over the rest of the records.
+				return 0;
+
+			case BIO_CTRL_GET_KTLS_SEND:
+				// After the handover, OpenSSL writes the records in plain text and the kernel encrypts them
+				return _is_kernel_tls_started ? 1 : 0;
+
+			case OV_BIO_CTRL_SET_KTLS_TX_SEND_CTRL_MSG:
+				// The next record is not application data
+				_kernel_tls_record_type = static_cast<uint8_t>(num);
+				return 1;
+
+			case OV_BIO_CTRL_CLEAR_KTLS_TX_CTRL_MSG:
+				_kernel_tls_record_type = 0;
+				return 1;
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+
+			default:
+				return 0;
+		}
+	}
+
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+	// @return The length of struct tls12_crypto_info_*, or 0 if the cipher is not supported
+	static size_t GetKernelTlsCryptoInfoLength(const struct tls_crypto_info *crypto_info, size_t *rec_seq_offset)
+	{
+		switch (crypto_info->cipher_type)
+		{
+			case TLS_CIPHER_AES_GCM_128:
+				*rec_seq_offset = offsetof(struct tls12_crypto_info_aes_gcm_128, rec_seq);
+				return sizeof(struct tls12_crypto_info_aes_gcm_128);
+
+			case TLS_CIPHER_AES_GCM_256:
+				*rec_seq_offset = offsetof(struct tls12_crypto_info_aes_gcm_256, rec_seq);
+				return sizeof(struct tls12_crypto_info_aes_gcm_256);
+
+#	ifdef TLS_CIPHER_AES_CCM_128
+			case TLS_CIPHER_AES_CCM_128:
+				*rec_seq_offset = offsetof(struct tls12_crypto_info_aes_ccm_128, rec_seq);
+				return sizeof(struct tls12_crypto_info_aes_ccm_128);
+#	endif	// TLS_CIPHER_AES_CCM_128
+
+#	ifdef TLS_CIPHER_CHACHA20_POLY1305
+			case TLS_CIPHER_CHACHA20_POLY1305:
+				*rec_seq_offset = offsetof(struct tls12_crypto_info_chacha20_poly1305, rec_seq);
+				return sizeof(struct tls12_crypto_info_chacha20_poly1305);
+#	endif	// TLS_CIPHER_CHACHA20_POLY1305
+		}
+
+		return 0;
+	}
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+
+	void TlsData::SaveKernelTlsCryptoInfo(const void *crypto_info)
+	{
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+		size_t rec_seq_offset = 0;
+		// OpenSSL's ktls_crypto_info_t starts with the union of struct tls12_crypto_info_*
+		auto length = GetKernelTlsCryptoInfoLength(static_cast<const struct tls_crypto_info *>(crypto_info), &rec_seq_offset);
+
+		if (length == 0)
+		{
+			logtd("Kernel TLS is not available for the cipher: %u", static_cast<const struct tls_crypto_info *>(crypto_info)->cipher_type);
+			_kernel_tls_crypto_info = nullptr;
+			return;
+		}
+
+		_kernel_tls_crypto_info = std::make_shared<ov::Data>(crypto_info, length);
+		_kernel_tls_record_count = 0;
+
+		// OpenSSL flushes the BIO before changing the key, so the next write starts with a new record
+		_record_header_length = 0;
+		_record_remaining = 0;
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+	}
+
+	void TlsData::CountKernelTlsRecords(const uint8_t *data, size_t length)
+	{
+		while (length > 0)
+		{
+			if (_record_remaining > 0)
+			{
+				auto skip_bytes = std::min(_record_remaining, length);
+
+				data += skip_bytes;
+				length -= skip_bytes;
+				_record_remaining -= skip_bytes;
+
+				continue;
+			}
+
+			// content_type(1) + legacy_record_version(2) + length(2)
+			auto bytes_to_copy = std::min(sizeof(_record_header) - _record_header_length, length);
+
+			::memcpy(_record_header + _record_header_length, data, bytes_to_copy);
+			_record_header_length += bytes_to_copy;
+			data += bytes_to_copy;
+			length -= bytes_to_copy;
+
+			if (_record_header_length == sizeof(_record_header))
+			{
+				_record_remaining = (_record_header[3] << 8) | _record_header[4];
+				_record_header_length = 0;
+				_kernel_tls_record_count++;
+			}
+		}
+	}
+
+	bool TlsData::PrepareKernelTls()
+	{
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+		if (g_kernel_tls_unavailable)
+		{
+			return false;
+		}
+
+		// SSL_OP_ENABLE_KTLS makes OpenSSL pass the negotiated keys to BIO_CTRL_SET_KTLS
+		_tls.SetOptions(SSL_OP_ENABLE_KTLS);
+		_is_kernel_tls_requested = true;
+
+		return true;
+#else	// OV_TLS_KERNEL_TLS_SUPPORTED
+		static std::once_flag warning_flag;
+
+		std::call_once(warning_flag, []() {
+			logtw("Kernel TLS is not supported by the OpenSSL that OvenMediaEngine is built with (OpenSSL 3.0 or later with kTLS is required), TLS records will be encrypted by OpenSSL");
+		});
+
+		return false;
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+	}
+
+	bool TlsData::IsKernelTlsReady() const
+	{
+		return _is_kernel_tls_requested &&
+			   (_is_kernel_tls_started == false) &&
+			   (_state == State::Accepted) &&
+			   (_kernel_tls_crypto_info != nullptr) &&
+			   // Records are not written partially
+			   (_record_header_length == 0) && (_record_remaining == 0) &&
+			   // Encrypted records that are not passed to the caller yet
+			   ((_plain_data == nullptr) || _plain_data->IsEmpty());
+	}
+
+	bool TlsData::StartKernelTls(int native_handle, KernelTlsRecordCallback record_callback)
+	{
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+		if (IsKernelTlsReady() == false)
+		{
+			return false;
+		}
+
+		// Don't try again whether it succeeds or not
+		_is_kernel_tls_requested = false;
+
+		// The kernel continues from the next sequence number of the last record encrypted by OpenSSL
+		auto crypto_info = _kernel_tls_crypto_info->GetWritableDataAs<uint8_t>();
+		size_t rec_seq_offset = 0;
+		auto length = GetKernelTlsCryptoInfoLength(reinterpret_cast<const struct tls_crypto_info *>(crypto_info), &rec_seq_offset);
+		auto rec_seq = crypto_info + rec_seq_offset;
+
+		uint64_t sequence_number = 0;
+
+		for (int index = 0; index < 8; index++)
+		{
+			sequence_number = (sequence_number << 8) | rec_seq[index];
+		}
+
+		sequence_number += _kernel_tls_record_count;
+
+		for (int index = 7; index >= 0; index--)
+		{
+			rec_seq[index] = static_cast<uint8_t>((sequence_number >> ((7 - index) * 8)) & 0xFF);
+		}
+
+		if (::setsockopt(native_handle, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0)
+		{
+			// "tls" module is not loaded
+			if (g_kernel_tls_unavailable.exchange(true) == false)
+			{
+				logtw("Could not enable kernel TLS (TCP_ULP), TLS records will be encrypted by OpenSSL: %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+			}
+
+			_kernel_tls_crypto_info = nullptr;
+			return false;
+		}
+
+		if (::setsockopt(native_handle, SOL_TLS, TLS_TX, crypto_info, length) != 0)
+		{
+			logtw("Could not enable kernel TLS (TLS_TX): %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+			_kernel_tls_crypto_info = nullptr;
+			return false;
+		}
+
+		logtd("Kernel TLS is started (sequence number: %" PRIu64 ")", sequence_number);
+
+		// Clear the key
+		::OPENSSL_cleanse(crypto_info, length);
+		_kernel_tls_crypto_info = nullptr;
+
+		_kernel_tls_native_handle = native_handle;
+		_kernel_tls_record_callback = std::move(record_callback);
+		_is_kernel_tls_started = true;
+
+		return true;
+#else	// OV_TLS_KERNEL_TLS_SUPPORTED
+		return false;
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+	}
+
+	bool TlsData::UpdateKernelTlsKey(const void *crypto_info)
+	{
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+		size_t rec_seq_offset = 0;
+		auto length = GetKernelTlsCryptoInfoLength(static_cast<const struct tls_crypto_info *>(crypto_info), &rec_seq_offset);
+
+		// Older kernels don't support changing the key of TLS_TX
+		if ((length == 0) || (::setsockopt(_kernel_tls_native_handle, SOL_TLS, TLS_TX, crypto_info, length) != 0))
+		{
+			logtw("Could not update the key of kernel TLS, the connection will be closed: %s", ov::Error::CreateErrorFromErrno()->ToString().CStr());
+
+			// The peer uses the new key from the next record, so the records encrypted with the old key can't be sent
+			_is_kernel_tls_failed = true;
+			return false;
+		}
+
+		logtd("The key of kernel TLS is updated");
+
+		return true;
+#else	// OV_TLS_KERNEL_TLS_SUPPORTED
+		return false;
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+	}
+
+	ssize_t TlsData::SendKernelTlsControlRecord(const void *data, size_t length)
+	{
+#if OV_TLS_KERNEL_TLS_SUPPORTED
+		auto record_type = _kernel_tls_record_type;
+
+		if (_is_kernel_tls_failed)
+		{
+			_kernel_tls_record_type = 0;
+			return -1LL;
+		}
+
+		if (_kernel_tls_record_callback == nullptr)
+		{
+			OV_ASSERT2(_kernel_tls_record_callback != nullptr);
+			return -1LL;
+		}
+
+		// The record is queued after the data which has not been sent yet, so close_notify doesn't overtake it.
+		auto sent_bytes = _kernel_tls_record_callback(record_type, data, length);
+
+		if (sent_bytes == 0)
+		{
+			// Tls::TlsWrite() makes OpenSSL retry the record, keep the record type for it
+			return 0LL;
+		}
+
+		// OpenSSL sets the record type before every control record
+		_kernel_tls_record_type = 0;
+
+		if (sent_bytes < 0)
+		{
+			logtd("Could not send TLS record (type: %d, %zu bytes) through kernel TLS", record_type, length);
+		}
+
+		return sent_bytes;
+#else	// OV_TLS_KERNEL_TLS_SUPPORTED
+		return -1LL;
+#endif	// OV_TLS_KERNEL_TLS_SUPPORTED
+	}
 }  // namespace ov
\ No newline at end of file
@@ -16,6 +16,10 @@ namespace ov
 	{
 	public:
 		using WriteCallback = std::function<ssize_t(const void *data, int64_t length)>;
+		// Sends <data> as a record of <record_type> through kernel TLS, after the data which has not been sent yet
+		//
+		// @return The number of bytes sent (or queued to be sent), 0 to retry later, -1 if an error occurred
+		using KernelTlsRecordCallback = std::function<ssize_t(uint8_t record_type, const void *data, size_t length)>;
 
 		enum class Method
 		{
@@ -54,6 +58,31 @@ namespace ov
 		size_t GetDataLength() const;
 		std::shared_ptr<const Data> GetData() const;
 
+		//--------------------------------------------------------------------
+		// Kernel TLS (Linux kTLS, TX only)
+		//--------------------------------------------------------------------
+		// OpenSSL encrypts the records until the handshake is done. After that, the kernel encrypts the records
+		// while sending them, so Encrypt() returns the plain data as it is. The records that OpenSSL still writes
+		// (Alert, KeyUpdate, ...) are passed to the BIO in plain text, and sent through the socket with their record type.
+		//
+		// Requires OpenSSL 3.0 or later built with kTLS (The bundled OpenSSL 1.1.1 doesn't support it).
+		//
+		// Must be called before the first Decrypt()
+		//
+		// @return false if the OpenSSL/kernel headers do not support kTLS
+		bool PrepareKernelTls();
+		// Whether the write key is negotiated and all the records encrypted by OpenSSL are passed to the caller
+		bool IsKernelTlsReady() const;
+		// Installs the write key to the socket.
+		// The caller must make sure that all the records returned by Encrypt() were passed to the kernel.
+		//
+		// @param record_callback Sends the records that OpenSSL still writes (Alert, KeyUpdate, ...) in order with the other data
+		bool StartKernelTls(int native_handle, KernelTlsRecordCallback record_callback);
+		bool IsKernelTlsStarted() const
+		{
+			return _is_kernel_tls_started;
+		}
+
 	protected:
 		//--------------------------------------------------------------------
 		// Called by TLS module
@@ -62,6 +91,17 @@ namespace ov
 		ssize_t OnTlsRead(Tls *tls, void *buffer, size_t length);
 		// Tls::Write() -> SSL_write() -> Tls::TlsWrite() -> BIO_get_data()::write_callback -> TlsData::OnTlsWrite()
 		ssize_t OnTlsWrite(Tls *tls, const void *data, size_t length);
+		// Tls::Accept() -> SSL_accept() -> BIO_ctrl() -> Tls::TlsCtrl() -> BIO_get_data()::ctrl_callback -> TlsData::OnTlsCtrl()
+		long OnTlsCtrl(Tls *tls, int cmd, long num, void *ptr);
+
+		// Keeps the kTLS parameters that OpenSSL passes to BIO_CTRL_SET_KTLS when the write key is changed
+		void SaveKernelTlsCryptoInfo(const void *crypto_info);
+		// Counts the records encrypted by OpenSSL after the write key is changed, to calculate the record sequence number
+		void CountKernelTlsRecords(const uint8_t *data, size_t length);
+		// Installs the new write key to the socket after kernel TLS is started (TLS 1.3 KeyUpdate)
+		bool UpdateKernelTlsKey(const void *crypto_info);
+		// Sends a record which is not application data (Alert, KeyUpdate, ...) after kernel TLS is started
+		ssize_t SendKernelTlsControlRecord(const void *data, size_t length);
 
 		State _state = State::Invalid;
 
@@ -70,5 +110,21 @@ namespace ov
 		WriteCallback _write_callback;
 		std::shared_ptr<Data> _cipher_data;
 		std::shared_ptr<Data> _plain_data;
+
+		bool _is_kernel_tls_requested = false;
+		bool _is_kernel_tls_started = false;
+		// Set if the kernel couldn't take over the new write key, the connection can't be used anymore
+		bool _is_kernel_tls_failed = false;
+		int _kernel_tls_native_handle = -1;
+		KernelTlsRecordCallback _kernel_tls_record_callback;
+		// Record type of the next record that OpenSSL writes (0: application data)
+		uint8_t _kernel_tls_record_type = 0;
+		// struct tls12_crypto_info_* of <linux/tls.h>
+		std::shared_ptr<Data> _kernel_tls_crypto_info;
+		uint64_t _kernel_tls_record_count = 0;
+		// TLS record header which is being parsed by CountKernelTlsRecords()
+		uint8_t _record_header[5];
+		size_t _record_header_length = 0;
+		size_t _record_remaining = 0;
 	};
 }  // namespace ov
\ No newline at end of file
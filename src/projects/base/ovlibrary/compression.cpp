@@ -0,0 +1,129 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "compression.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+
+namespace ov
+{
+	// windowBits + 16: zlib writes a gzip header and trailer instead of a zlib wrapper
+	constexpr int GzipWindowBits = (15 + 16);
+	constexpr int GzipMemoryLevel = 8;
+	// The maximum length of the stored block
+	constexpr size_t MaxStoredBlockLength = 0xFFFF;
+
+	static std::shared_ptr<Data> Deflate(const void *data, size_t length, int flush, uint32_t *crc, int level)
+	{
+		z_stream stream{};
+
+		if (::deflateInit2(&stream, level, Z_DEFLATED, GzipWindowBits, GzipMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			return nullptr;
+		}
+
+		// deflateBound() doesn't include the marker of Z_SYNC_FLUSH (5 bytes)
+		size_t capacity = ::deflateBound(&stream, length) + 16;
+		auto output = std::make_shared<Data>(capacity);
+		output->SetLength(capacity);
+
+		stream.next_in = reinterpret_cast<Bytef *>(const_cast<void *>(data));
+		stream.avail_in = static_cast<uInt>(length);
+		stream.next_out = output->GetWritableDataAs<Bytef>();
+		stream.avail_out = static_cast<uInt>(capacity);
+
+		auto result = ::deflate(&stream, flush);
+
+		// The output buffer is large enough to compress all at once
+		bool succeeded = (flush == Z_FINISH) ? (result == Z_STREAM_END) : ((result == Z_OK) && (stream.avail_in == 0) && (stream.avail_out > 0));
+
+		if (crc != nullptr)
+		{
+			// In gzip mode, adler has CRC-32 of the input
+			*crc = static_cast<uint32_t>(stream.adler);
+		}
+
+		output->SetLength(capacity - stream.avail_out);
+
+		::deflateEnd(&stream);
+
+		return succeeded ? output : nullptr;
+	}
+
+	std::shared_ptr<Data> Compression::Gzip(const void *data, size_t length, int level)
+	{
+		return Deflate(data, length, Z_FINISH, nullptr, level);
+	}
+
+	std::shared_ptr<Data> Compression::Gzip(const std::shared_ptr<const Data> &data, int level)
+	{
+		return (data != nullptr) ? Gzip(data->GetData(), data->GetLength(), level) : nullptr;
+	}
+
+	std::shared_ptr<Data> Compression::GzipHead(const void *data, size_t length, uint32_t *crc, int level)
+	{
+		// Z_SYNC_FLUSH aligns the output to a byte boundary without the last block,
+		// so other deflate blocks can be appended
+		return Deflate(data, length, Z_SYNC_FLUSH, crc, level);
+	}
+
+	std::shared_ptr<Data> Compression::GzipTail(uint32_t head_crc, size_t head_length, const void *tail, size_t tail_length)
+	{
+		auto block_count = std::max<size_t>(1, (tail_length + MaxStoredBlockLength - 1) / MaxStoredBlockLength);
+		auto output = std::make_shared<Data>(tail_length + (block_count * 5) + 8);
+		auto tail_bytes = static_cast<const uint8_t *>(tail);
+
+		size_t offset = 0;
+
+		do
+		{
+			auto block_length = std::min(tail_length - offset, MaxStoredBlockLength);
+			bool is_final = ((offset + block_length) == tail_length);
+
+			// RFC1951 - 3.2.4. Non-compressed blocks: BFINAL(1 bit), BTYPE(2 bits, 00), LEN, NLEN
+			uint8_t header[5] = {
+				static_cast<uint8_t>(is_final ? 0x01 : 0x00),
+				static_cast<uint8_t>(block_length & 0xFF),
+				static_cast<uint8_t>((block_length >> 8) & 0xFF),
+				static_cast<uint8_t>(~block_length & 0xFF),
+				static_cast<uint8_t>((~block_length >> 8) & 0xFF)};
+
+			output->Append(header, sizeof(header));
+
+			if (block_length > 0)
+			{
+				output->Append(tail_bytes + offset, block_length);
+			}
+
+			offset += block_length;
+		} while (offset < tail_length);
+
+		// RFC1952 - 2.3. Member format: CRC32, ISIZE (little endian)
+		auto crc = static_cast<uint32_t>(::crc32_combine(
+			head_crc,
+			::crc32(0L, static_cast<const Bytef *>(tail), static_cast<uInt>(tail_length)),
+			static_cast<z_off_t>(tail_length)));
+		auto size = static_cast<uint32_t>(head_length + tail_length);
+
+		uint8_t trailer[8] = {
+			static_cast<uint8_t>(crc & 0xFF),
+			static_cast<uint8_t>((crc >> 8) & 0xFF),
+			static_cast<uint8_t>((crc >> 16) & 0xFF),
+			static_cast<uint8_t>((crc >> 24) & 0xFF),
+			static_cast<uint8_t>(size & 0xFF),
+			static_cast<uint8_t>((size >> 8) & 0xFF),
+			static_cast<uint8_t>((size >> 16) & 0xFF),
+			static_cast<uint8_t>((size >> 24) & 0xFF)};
+
+		output->Append(trailer, sizeof(trailer));
+
+		return output;
+	}
+}  // namespace ov
@@ -0,0 +1,45 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "./data.h"
+
+namespace ov
+{
+	class Compression
+	{
+	public:
+		// Compresses the data using gzip (RFC1952)
+		//
+		// @param level 0 (no compression) ~ 9 (best compression)
+		//
+		// @return The gzip member, or nullptr if an error occurred
+		static std::shared_ptr<Data> Gzip(const void *data, size_t length, int level = 9);
+		static std::shared_ptr<Data> Gzip(const std::shared_ptr<const Data> &data, int level = 9);
+
+		// Compresses the head of the data which will be followed by a tail that changes frequently.
+		// GzipHead() + GzipTail() makes a complete gzip member, so the head needs to be compressed only once.
+		//
+		// @param crc CRC-32 of the head (it is needed for GzipTail())
+		//
+		// @return The gzip header and the compressed head (byte-aligned, but not finished)
+		static std::shared_ptr<Data> GzipHead(const void *data, size_t length, uint32_t *crc, int level = 9);
+
+		// Makes the rest of the gzip member which is started by GzipHead()
+		//
+		// The tail is not compressed (stored blocks), so it should be small
+		//
+		// @param head_crc CRC-32 returned by GzipHead()
+		// @param head_length The length of the uncompressed head
+		static std::shared_ptr<Data> GzipTail(uint32_t head_crc, size_t head_length, const void *tail, size_t tail_length);
+	};
+}  // namespace ov
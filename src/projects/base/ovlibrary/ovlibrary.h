@@ -14,6 +14,7 @@
 #include "./byte_ordering.h"
 #include "./byte_stream.h"
 #include "./clock.h"
+#include "./compression.h"
 #include "./converter.h"
 #include "./data.h"
 #include "./delay_queue.h"
@@ -30,10 +31,12 @@
 #include "./queue.h"
 #include "./random.h"
 #include "./regex.h"
+#include "./ring_queue.h"
 #include "./semaphore.h"
 #include "./singleton.h"
 #include "./stack_trace.h"
 #include "./stop_watch.h"
 #include "./string.h"
 #include "./url.h"
-#include "./unique.h"
\ No newline at end of file
+#include "./unique.h"
+#include "./worker_pool.h"
\ No newline at end of file
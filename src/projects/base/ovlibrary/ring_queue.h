@@ -0,0 +1,572 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+#include "./clock.h"
+#include "./dump_utilities.h"
+#include "./log.h"
+#include "./ovdata_structure.h"
+#include "./platform.h"
+#include "./string.h"
+
+#if !IS_MACOS
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+
+#	include <climits>
+#endif	// !IS_MACOS
+
+// The capacity of the lock-free ring, it is rounded up to a power of 2
+#define OV_RING_QUEUE_DEFAULT_CAPACITY 4096
+
+namespace ov
+{
+	enum class RingQueueProducer : char
+	{
+		// Only one thread calls Enqueue() at a time (SPSC)
+		Single,
+		// Multiple threads call Enqueue() concurrently (MPSC)
+		Multiple
+	};
+
+	// A bounded lock-free queue which can be used instead of ov::Queue in the media paths
+	//
+	// - Enqueue()/Dequeue() don't take a lock. Each slot has a sequence number that tells whether the slot is
+	//   writable or readable (Dmitry Vyukov's bounded queue)
+	// - The consumer sleeps on a futex only if the queue is empty, and the producer calls futex(FUTEX_WAKE)
+	//   only if a consumer is sleeping
+	// - Like ov::Queue, Enqueue() never drops an item. If the ring is full, the items are kept in an overflow list
+	//   (protected by a mutex) until the consumer catches up, and a warning is logged. While the overflow list is
+	//   not empty, the new items are also appended to it, so the items of a producer are dequeued in order.
+	// - TryEnqueue() doesn't use the overflow list, so the caller can choose another queue if the ring is full
+	template <typename T, RingQueueProducer producer_type = RingQueueProducer::Multiple>
+	class RingQueue
+	{
+	public:
+		RingQueue()
+			: RingQueue(nullptr)
+		{
+		}
+
+		RingQueue(const char *alias, size_t threshold = 0, size_t capacity = OV_RING_QUEUE_DEFAULT_CAPACITY, int log_interval_in_msec = 5000)
+			: _threshold(threshold),
+			  _log_interval(log_interval_in_msec)
+		{
+			size_t slot_count = 2;
+
+			while (slot_count < capacity)
+			{
+				slot_count <<= 1;
+			}
+
+			_mask = slot_count - 1;
+			_slots = std::make_unique<Slot[]>(slot_count);
+
+			for (size_t index = 0; index < slot_count; index++)
+			{
+				_slots[index].sequence.store(index, std::memory_order_relaxed);
+			}
+
+			SetAlias(alias);
+
+			auto shared_lock = std::shared_lock(_name_mutex);
+			logd("ov.RingQueue", "[%p] %s is created with capacity: %zu, threshold: %zu, interval: %d", this, _queue_name.CStr(), slot_count, threshold, log_interval_in_msec);
+		}
+
+		~RingQueue()
+		{
+			auto shared_lock = std::shared_lock(_name_mutex);
+			logd("ov.RingQueue", "[%p] %s is destroyed", this, _queue_name.CStr());
+		}
+
+		String GetAlias() const
+		{
+			auto shared_lock = std::shared_lock(_name_mutex);
+			return _queue_name;
+		}
+
+		void SetAlias(const char *alias)
+		{
+			auto lock_guard = std::lock_guard(_name_mutex);
+
+			if ((alias != nullptr) && (alias[0] != '\0'))
+			{
+				_queue_name = alias;
+			}
+			else
+			{
+				_queue_name.Format("RingQueue<%s>", Demangle(typeid(T).name()).CStr());
+			}
+
+			logd("ov.RingQueue", "[%p] The alias is changed to %s", this, _queue_name.CStr());
+		}
+
+		void SetThreshold(size_t threshold)
+		{
+			_threshold = threshold;
+			logd("ov.RingQueue", "[%p] The threshold is changed to %zu", this, threshold);
+		}
+
+		size_t GetCapacity() const
+		{
+			return _mask + 1;
+		}
+
+		void Enqueue(const T &item)
+		{
+			if (TryEnqueueInternal(item) == false)
+			{
+				EnqueueToOverflow(item);
+			}
+		}
+
+		void Enqueue(T &&item)
+		{
+			if (TryEnqueueInternal(item) == false)
+			{
+				EnqueueToOverflow(std::move(item));
+			}
+		}
+
+		// @return Returns false if the ring is full (the item is not enqueued)
+		bool TryEnqueue(const T &item)
+		{
+			return TryEnqueueInternal(item);
+		}
+
+		bool TryEnqueue(T &&item)
+		{
+			return TryEnqueueInternal(item);
+		}
+
+		// Timeout in milliseconds
+		std::optional<T> Dequeue(int timeout = Infinite)
+		{
+			auto expire = (timeout == Infinite) ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+			T item;
+
+			while (_stop == false)
+			{
+				if (TryDequeue(item))
+				{
+					return item;
+				}
+
+				if (WaitForItem(expire) == false)
+				{
+					// Timed out
+					if ((_stop == false) && TryDequeue(item))
+					{
+						return item;
+					}
+
+					break;
+				}
+			}
+
+			return {};
+		}
+
+		// Waits until at least one item is enqueued, and then moves up to <max_count> items into <items> at once
+		//
+		// @return The number of the items dequeued
+		size_t DequeueBatch(std::vector<T> &items, size_t max_count, int timeout = Infinite)
+		{
+			auto first_item = Dequeue(timeout);
+
+			if (first_item.has_value() == false)
+			{
+				return 0;
+			}
+
+			items.push_back(std::move(first_item.value()));
+
+			size_t count = 1;
+			T item;
+
+			while ((count < max_count) && TryDequeue(item))
+			{
+				items.push_back(std::move(item));
+				count++;
+			}
+
+			return count;
+		}
+
+		// Dequeues an item without waiting
+		bool TryDequeue(T &item)
+		{
+			if (TryDequeueFromRing(item))
+			{
+				return true;
+			}
+
+			if (_overflow_count.load(std::memory_order_acquire) == 0)
+			{
+				return false;
+			}
+
+			auto lock_guard = std::lock_guard(_overflow_mutex);
+
+			if (_overflow.empty())
+			{
+				return false;
+			}
+
+			item = std::move(_overflow.front());
+			_overflow.pop_front();
+			_overflow_count.store(_overflow.size(), std::memory_order_release);
+
+			return true;
+		}
+
+		bool IsEmpty() const
+		{
+			return IsRingEmpty() && (_overflow_count.load(std::memory_order_acquire) == 0);
+		}
+
+		// Dequeues all items (The items enqueued at the same time may remain)
+		void Clear()
+		{
+			T item;
+
+			while (TryDequeue(item))
+			{
+			}
+		}
+
+		// The number of the items (approximate value when other threads are using the queue)
+		size_t Size() const
+		{
+			auto head = _head.load(std::memory_order_acquire);
+			auto tail = _tail.load(std::memory_order_acquire);
+
+			return ((tail > head) ? (tail - head) : 0) + _overflow_count.load(std::memory_order_acquire);
+		}
+
+		bool IsStopped() const
+		{
+			return _stop;
+		}
+
+		void Stop()
+		{
+			_stop = true;
+
+			WakeUp(true);
+		}
+
+	protected:
+		struct Slot
+		{
+			std::atomic<size_t> sequence{0};
+			T value{};
+		};
+
+		bool TryDequeueFromRing(T &item)
+		{
+			Slot *slot;
+			size_t position = _head.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				slot = &(_slots[position & _mask]);
+
+				auto sequence = slot->sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+				if (diff == 0)
+				{
+					if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (diff < 0)
+				{
+					// Empty
+					return false;
+				}
+				else
+				{
+					// Another consumer took the item
+					position = _head.load(std::memory_order_relaxed);
+				}
+			}
+
+			item = std::move(slot->value);
+			// Release the reference as soon as possible
+			slot->value = T();
+
+			// Make the slot writable for the next round
+			slot->sequence.store(position + _mask + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool IsRingEmpty() const
+		{
+			auto position = _head.load(std::memory_order_acquire);
+
+			return (_slots[position & _mask].sequence.load(std::memory_order_acquire) != (position + 1));
+		}
+
+		// The item is moved only if it is enqueued
+		template <typename U>
+		bool TryEnqueueInternal(U &item)
+		{
+			// The items must not pass the items in the overflow list
+			if (_overflow_count.load(std::memory_order_acquire) > 0)
+			{
+				return false;
+			}
+
+			Slot *slot;
+			size_t position = _tail.load(std::memory_order_relaxed);
+
+			if constexpr (producer_type == RingQueueProducer::Single)
+			{
+				slot = &(_slots[position & _mask]);
+
+				if (slot->sequence.load(std::memory_order_acquire) != position)
+				{
+					// Full
+					return false;
+				}
+
+				_tail.store(position + 1, std::memory_order_relaxed);
+			}
+			else
+			{
+				while (true)
+				{
+					slot = &(_slots[position & _mask]);
+
+					auto sequence = slot->sequence.load(std::memory_order_acquire);
+					auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+					if (diff == 0)
+					{
+						if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+					}
+					else if (diff < 0)
+					{
+						// Full
+						return false;
+					}
+					else
+					{
+						// Another producer took the slot
+						position = _tail.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			slot->value = std::move(item);
+			// Make the slot readable
+			slot->sequence.store(position + 1, std::memory_order_release);
+
+			CheckThreshold();
+
+			WakeUp(false);
+
+			return true;
+		}
+
+		template <typename U>
+		void EnqueueToOverflow(U &&item)
+		{
+			size_t overflow_count;
+
+			{
+				auto lock_guard = std::lock_guard(_overflow_mutex);
+
+				_overflow.push_back(std::forward<U>(item));
+				overflow_count = _overflow.size();
+				_overflow_count.store(overflow_count, std::memory_order_release);
+			}
+
+			_overflow_total_count++;
+
+			if (CanLog())
+			{
+				auto shared_lock = std::shared_lock(_name_mutex);
+				logw("ov.RingQueue", "[%p] %s is full, the items are kept in the overflow list: capacity: %zu, overflow: %zu, total overflowed: %zu",
+					 this, _queue_name.CStr(), GetCapacity(), overflow_count, _overflow_total_count.load());
+			}
+
+			CheckThreshold();
+
+			WakeUp(false);
+		}
+
+		// @return Returns false if timed out
+		bool WaitForItem(const std::chrono::steady_clock::time_point &expire)
+		{
+			auto wakeup_count = _wakeup_count.load(std::memory_order_acquire);
+
+			_waiter_count.fetch_add(1);
+			// Pairs with the fence in WakeUp(): the producer either sees the waiter, or the consumer sees the item
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			bool result = true;
+
+			if (IsEmpty() && (_stop == false))
+			{
+				result = WaitForWakeUp(wakeup_count, expire);
+			}
+
+			_waiter_count.fetch_sub(1);
+
+			return result;
+		}
+
+		void WakeUp(bool force)
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if ((force == false) && (_waiter_count.load(std::memory_order_relaxed) == 0))
+			{
+				// Nobody is sleeping
+				return;
+			}
+
+#if !IS_MACOS
+			_wakeup_count.fetch_add(1, std::memory_order_release);
+			::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_wakeup_count), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else	// !IS_MACOS
+			{
+				auto lock_guard = std::lock_guard(_wakeup_mutex);
+				_wakeup_count.fetch_add(1, std::memory_order_release);
+			}
+
+			_wakeup_condition.notify_all();
+#endif	// !IS_MACOS
+		}
+
+		// @return Returns false if timed out
+		bool WaitForWakeUp(uint32_t wakeup_count, const std::chrono::steady_clock::time_point &expire)
+		{
+#if !IS_MACOS
+			timespec timeout_spec;
+			timespec *timeout_ptr = nullptr;
+
+			if (expire != std::chrono::steady_clock::time_point::max())
+			{
+				auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(expire - std::chrono::steady_clock::now()).count();
+
+				if (remaining <= 0)
+				{
+					return false;
+				}
+
+				timeout_spec.tv_sec = remaining / 1000000000LL;
+				timeout_spec.tv_nsec = remaining % 1000000000LL;
+				timeout_ptr = &timeout_spec;
+			}
+
+			// Returns immediately if _wakeup_count is changed after it is read (EAGAIN)
+			auto result = ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_wakeup_count), FUTEX_WAIT_PRIVATE, wakeup_count, timeout_ptr, nullptr, 0);
+
+			return (result == 0) || (errno != ETIMEDOUT);
+#else	// !IS_MACOS
+			auto unique_lock = std::unique_lock(_wakeup_mutex);
+
+			return _wakeup_condition.wait_until(unique_lock, expire, [this, wakeup_count]() -> bool {
+				return _wakeup_count.load(std::memory_order_acquire) != wakeup_count;
+			});
+#endif	// !IS_MACOS
+		}
+
+		inline void CheckThreshold()
+		{
+			size_t threshold = _threshold;
+
+			if (threshold == 0)
+			{
+				return;
+			}
+
+			auto size = Size();
+
+			if (size < threshold)
+			{
+				return;
+			}
+
+			auto peak = _peak.load(std::memory_order_relaxed);
+
+			while ((peak < size) && (_peak.compare_exchange_weak(peak, size, std::memory_order_relaxed) == false))
+			{
+			}
+
+			if (CanLog())
+			{
+				auto shared_lock = std::shared_lock(_name_mutex);
+				logw("ov.RingQueue", "[%p] %s size has exceeded the threshold: queue: %zu, threshold: %zu, peak: %zu", this, _queue_name.CStr(), size, threshold, _peak.load());
+			}
+		}
+
+		// Only one thread can log during the log interval
+		bool CanLog()
+		{
+			auto current = Clock::NowMSec();
+			auto last = _last_log_time.load(std::memory_order_relaxed);
+
+			return ((current - last) >= static_cast<uint64_t>(_log_interval)) &&
+				   _last_log_time.compare_exchange_strong(last, current, std::memory_order_relaxed);
+		}
+
+	private:
+		mutable std::shared_mutex _name_mutex;
+		String _queue_name;
+
+		std::atomic<size_t> _threshold{0};
+		std::atomic<size_t> _peak{0};
+		std::atomic<size_t> _overflow_total_count{0};
+		int _log_interval = 0;
+		std::atomic<uint64_t> _last_log_time{0};
+
+		std::unique_ptr<Slot[]> _slots;
+		size_t _mask = 0;
+
+		// Producers and consumers are placed on different cache lines
+		alignas(64) std::atomic<size_t> _tail{0};
+		alignas(64) std::atomic<size_t> _head{0};
+
+		// Used only if the ring is full
+		std::mutex _overflow_mutex;
+		std::deque<T> _overflow;
+		alignas(64) std::atomic<size_t> _overflow_count{0};
+
+		alignas(64) std::atomic<uint32_t> _wakeup_count{0};
+		std::atomic<int> _waiter_count{0};
+#if IS_MACOS
+		std::mutex _wakeup_mutex;
+		std::condition_variable _wakeup_condition;
+#endif	// IS_MACOS
+
+		std::atomic<bool> _stop{false};
+	};
+}  // namespace ov
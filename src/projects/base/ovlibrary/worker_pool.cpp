@@ -0,0 +1,283 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "./worker_pool.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <set>
+
+#include "./log.h"
+#include "./ovlibrary_private.h"
+
+namespace ov
+{
+	// The pool and the index of the pool thread which is running the current code (nullptr/-1 if the current thread is not a pool thread)
+	static thread_local WorkerPool *g_current_pool = nullptr;
+	static thread_local ssize_t g_pool_thread_index = -1;
+
+	// @return NUMA node of the CPU, or -1 if unknown
+	static int GetNumaNode(int cpu)
+	{
+		int numa_node = -1;
+
+#if !IS_MACOS
+		// /sys/devices/system/cpu/cpu<N>/node<M> exists if NUMA is enabled
+		String path = String::FormatString("/sys/devices/system/cpu/cpu%d", cpu);
+		DIR *dir = ::opendir(path.CStr());
+
+		if (dir != nullptr)
+		{
+			struct dirent *entry = nullptr;
+
+			while ((entry = ::readdir(dir)) != nullptr)
+			{
+				if ((::strncmp(entry->d_name, "node", 4) == 0) && (::isdigit(entry->d_name[4])))
+				{
+					numa_node = ::atoi(entry->d_name + 4);
+					break;
+				}
+			}
+
+			::closedir(dir);
+		}
+#endif	// !IS_MACOS
+
+		return numa_node;
+	}
+
+	WorkerPool::WorkerPool(const char *name, size_t queue_size)
+		: _name(name),
+		  _queue_size(queue_size)
+	{
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		Stop();
+	}
+
+	void WorkerPool::Stop()
+	{
+		_stop = true;
+
+		for (auto &pool_thread : _threads)
+		{
+			pool_thread->queue.Stop();
+		}
+
+		for (auto &pool_thread : _threads)
+		{
+			if (pool_thread->thread.joinable())
+			{
+				pool_thread->thread.join();
+			}
+		}
+	}
+
+	void WorkerPool::StartIfNeeded()
+	{
+		std::call_once(_start_flag, [this]() {
+			std::vector<int> cpu_list;
+
+#if !IS_MACOS
+			// Use the cores that this process is allowed to run on (the container may limit them)
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+
+			if (::sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+			{
+				for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+				{
+					if (CPU_ISSET(cpu, &cpu_set))
+					{
+						cpu_list.push_back(cpu);
+					}
+				}
+			}
+#endif	// !IS_MACOS
+
+			size_t thread_count = cpu_list.empty() ? std::max(std::thread::hardware_concurrency(), 1U) : cpu_list.size();
+			std::set<int> numa_node_list;
+
+			for (size_t index = 0; index < thread_count; index++)
+			{
+				auto alias = String::FormatString("Queue #%zu of worker pool (%s)", index, _name.CStr());
+				auto pool_thread = std::make_unique<PoolThread>(alias.CStr(), _queue_size);
+
+				if (cpu_list.empty() == false)
+				{
+					pool_thread->cpu = cpu_list[index];
+					pool_thread->numa_node = GetNumaNode(pool_thread->cpu);
+				}
+
+				numa_node_list.insert(pool_thread->numa_node);
+
+				_threads.push_back(std::move(pool_thread));
+			}
+
+			for (size_t index = 0; index < thread_count; index++)
+			{
+				_threads[index]->thread = std::thread(&WorkerPool::ThreadProc, this, index);
+				pthread_setname_np(_threads[index]->thread.native_handle(), _name.CStr());
+			}
+
+			logti("Worker pool (%s) is started with %zu threads (NUMA nodes: %zu, queue size: %zu)", _name.CStr(), thread_count, numa_node_list.size(), _queue_size);
+		});
+	}
+
+	size_t WorkerPool::GetThreadCount()
+	{
+		StartIfNeeded();
+
+		return _threads.size();
+	}
+
+	bool WorkerPool::Enqueue(size_t index, const std::shared_ptr<WorkerPoolJob> &job)
+	{
+		return _threads[index]->queue.TryEnqueue(job);
+	}
+
+	void WorkerPool::Schedule(const std::shared_ptr<WorkerPoolJob> &job, uint32_t hint)
+	{
+		StartIfNeeded();
+
+		auto thread_count = _threads.size();
+		size_t preferred_index = hint % thread_count;
+
+		if ((g_current_pool == this) && (static_cast<ssize_t>(preferred_index) == g_pool_thread_index))
+		{
+			// The previous job of the stream is running on this thread - run the job right after it on the same core
+			if (Enqueue(preferred_index, job))
+			{
+				return;
+			}
+		}
+
+		auto target_index = preferred_index;
+
+		if (_threads[preferred_index]->is_busy)
+		{
+			// Spread the jobs across idle cores, prefer the cores of the same NUMA node
+			auto numa_node = _threads[preferred_index]->numa_node;
+			bool found = false;
+
+			for (int pass = 0; (pass < 2) && (found == false); pass++)
+			{
+				for (size_t offset = 1; offset < thread_count; offset++)
+				{
+					auto index = (preferred_index + offset) % thread_count;
+					auto &pool_thread = _threads[index];
+
+					if (((pass == 0) && (pool_thread->numa_node != numa_node)) || pool_thread->is_busy)
+					{
+						continue;
+					}
+
+					target_index = index;
+					found = true;
+					break;
+				}
+			}
+		}
+
+		for (size_t offset = 0; offset < thread_count; offset++)
+		{
+			if (Enqueue((target_index + offset) % thread_count, job))
+			{
+				return;
+			}
+		}
+
+		// All rings are full - the queue of the target thread keeps the job in its overflow list
+		_threads[target_index]->queue.Enqueue(job);
+	}
+
+	bool WorkerPool::Steal(size_t index, std::shared_ptr<WorkerPoolJob> &job)
+	{
+		auto thread_count = _threads.size();
+		auto numa_node = _threads[index]->numa_node;
+
+		// Steal the jobs of the same NUMA node first to keep the data in the local memory
+		for (int pass = 0; pass < 2; pass++)
+		{
+			for (size_t offset = 1; offset < thread_count; offset++)
+			{
+				auto &pool_thread = _threads[(index + offset) % thread_count];
+
+				if ((pass == 0) != (pool_thread->numa_node == numa_node))
+				{
+					continue;
+				}
+
+				if (pool_thread->queue.TryDequeue(job))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void WorkerPool::Run(size_t index, const std::shared_ptr<WorkerPoolJob> &job)
+	{
+		job->Process();
+	}
+
+	void WorkerPool::ThreadProc(size_t index)
+	{
+		auto &pool_thread = _threads[index];
+
+#if !IS_MACOS
+		if (pool_thread->cpu >= 0)
+		{
+			cpu_set_t cpu_set;
+			CPU_ZERO(&cpu_set);
+			CPU_SET(pool_thread->cpu, &cpu_set);
+
+			if (::pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0)
+			{
+				logtw("Could not pin the thread #%zu of worker pool (%s) to CPU %d", index, _name.CStr(), pool_thread->cpu);
+			}
+		}
+#endif	// !IS_MACOS
+
+		g_current_pool = this;
+		g_pool_thread_index = index;
+
+		std::shared_ptr<WorkerPoolJob> job;
+
+		while (_stop == false)
+		{
+			pool_thread->is_busy = true;
+
+			if (pool_thread->queue.TryDequeue(job) || Steal(index, job))
+			{
+				Run(index, job);
+				job = nullptr;
+
+				continue;
+			}
+
+			pool_thread->is_busy = false;
+
+			// Nothing to do - sleep until a job is queued to this thread
+			auto item = pool_thread->queue.Dequeue(OV_WORKER_POOL_STEAL_INTERVAL);
+
+			if (item.has_value())
+			{
+				pool_thread->is_busy = true;
+
+				Run(index, item.value());
+			}
+		}
+	}
+}  // namespace ov
@@ -0,0 +1,97 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./string.h"
+// ring_queue.h (clock.h) uses ov::String
+#include "./ring_queue.h"
+
+// A pool thread wakes up to steal the jobs of the other threads at least every this time (in milliseconds)
+#define OV_WORKER_POOL_STEAL_INTERVAL 100
+
+namespace ov
+{
+	// A job which is run by WorkerPool
+	class WorkerPoolJob
+	{
+	public:
+		virtual ~WorkerPoolJob() = default;
+
+		// Called by a pool thread
+		virtual void Process() = 0;
+	};
+
+	// A thread pool which runs the jobs on all cores that this process is allowed to run on
+	//
+	// - One thread is created per core when the first job is scheduled, and pinned to the core
+	// - A job is queued to the thread of its hint (hint % thread count). If the thread is busy, it is queued to an idle thread,
+	//   the threads of the same NUMA node first.
+	// - If the job is scheduled from the thread of its hint (by the previous job of a stream), it is queued to the thread itself,
+	//   so the jobs of a stream run one after another on a warm core
+	// - A thread that has nothing to do steals the jobs of the other threads, the threads of the same NUMA node first
+	// - The pool doesn't check whether a job is queued already. If a job must not be run concurrently, it must not be scheduled
+	//   again until it is run.
+	class WorkerPool
+	{
+	public:
+		// @param name The name of the threads
+		// @param queue_size The capacity of the ring of each thread. If the rings of all threads are full,
+		//                   the job is kept in the overflow list of a thread.
+		WorkerPool(const char *name, size_t queue_size);
+		virtual ~WorkerPool();
+
+		void Schedule(const std::shared_ptr<WorkerPoolJob> &job, uint32_t hint);
+
+		size_t GetThreadCount();
+
+	protected:
+		struct PoolThread
+		{
+			PoolThread(const char *alias, size_t queue_size)
+				: queue(alias, 0, queue_size)
+			{
+			}
+
+			std::thread thread;
+			RingQueue<std::shared_ptr<WorkerPoolJob>> queue;
+			// The thread is running a job (or about to run)
+			std::atomic<bool> is_busy{false};
+
+			int cpu = -1;
+			int numa_node = -1;
+		};
+
+		// Stops the threads. A derived class which overrides Run() must call this in its destructor,
+		// so that Run() is not called while the derived class is destroyed.
+		void Stop();
+
+		// Runs the job on the thread #index, can be overridden to measure the jobs
+		virtual void Run(size_t index, const std::shared_ptr<WorkerPoolJob> &job);
+
+		void StartIfNeeded();
+		void ThreadProc(size_t index);
+
+		bool Enqueue(size_t index, const std::shared_ptr<WorkerPoolJob> &job);
+		bool Steal(size_t index, std::shared_ptr<WorkerPoolJob> &job);
+
+		String _name;
+		size_t _queue_size;
+
+		std::once_flag _start_flag;
+		std::atomic<bool> _stop{false};
+
+		std::vector<std::unique_ptr<PoolThread>> _threads;
+	};
+}  // namespace ov
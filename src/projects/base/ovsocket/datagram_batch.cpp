@@ -0,0 +1,322 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "datagram_batch.h"
+
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "socket.h"
+#include "socket_private.h"
+
+#ifndef SOL_UDP
+#	define SOL_UDP 17
+#endif	// SOL_UDP
+
+#ifndef UDP_SEGMENT
+#	define UDP_SEGMENT 103
+#endif	// UDP_SEGMENT
+
+#ifndef SCM_TXTIME
+#	define SCM_TXTIME 61
+#endif	// SCM_TXTIME
+
+// A message has either UDP_SEGMENT (uint16_t) or SCM_TXTIME (uint64_t)
+#define OV_DATAGRAM_BATCH_CONTROL_SIZE CMSG_SPACE(sizeof(uint64_t))
+
+// Maximum payload size of a UDP datagram (65535 - 8 (UDP header) - 20 (IPv4 header))
+#define OV_DATAGRAM_BATCH_MAX_GSO_BYTES 65507
+
+namespace ov
+{
+#if !IS_MACOS
+	// If the NIC doesn't support UDP GSO, sendmmsg() fails with EIO. In this case, GSO is disabled for the rest of the process.
+	static std::atomic<bool> gso_enabled{true};
+#else	// !IS_MACOS
+	static std::atomic<bool> gso_enabled{false};
+#endif	// !IS_MACOS
+
+	DatagramBatch::DatagramBatch()
+	{
+		_items.reserve(OV_DATAGRAM_BATCH_MAX_COUNT);
+		_slots.resize(OV_DATAGRAM_BATCH_MAX_COUNT * OV_DATAGRAM_BATCH_SLOT_SIZE);
+	}
+
+	DatagramBatch *DatagramBatch::GetCurrent()
+	{
+		// Each thread has its own batch, so no lock is needed
+		thread_local DatagramBatch batch;
+
+		return &batch;
+	}
+
+	bool DatagramBatch::IsGsoEnabled()
+	{
+		return gso_enabled;
+	}
+
+	void DatagramBatch::SetTxTime(int64_t txtime_ns)
+	{
+		GetCurrent()->_txtime_ns = txtime_ns;
+	}
+
+	void DatagramBatch::Begin()
+	{
+		GetCurrent()->_started = true;
+	}
+
+	void DatagramBatch::Flush()
+	{
+		auto batch = GetCurrent();
+
+		// Stop collecting first, so that the fallback path (Socket::SendTo()) doesn't append the items again
+		batch->_started = false;
+		batch->_txtime_ns = 0;
+		batch->FlushInternal();
+	}
+
+	bool DatagramBatch::Append(const std::shared_ptr<Socket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data)
+	{
+#if !IS_MACOS
+		auto batch = GetCurrent();
+
+		if (batch->_started == false)
+		{
+			return false;
+		}
+
+		return batch->AppendInternal(socket, address, data);
+#else	// !IS_MACOS
+		return false;
+#endif	// !IS_MACOS
+	}
+
+	bool DatagramBatch::AppendInternal(const std::shared_ptr<Socket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data)
+	{
+		auto length = data->GetLength();
+
+		if ((length == 0) || (length > OV_DATAGRAM_BATCH_SLOT_SIZE))
+		{
+			return false;
+		}
+
+		if (_items.size() >= OV_DATAGRAM_BATCH_MAX_COUNT)
+		{
+			_started = false;
+			FlushInternal();
+			_started = true;
+		}
+
+		::memcpy(GetSlot(_items.size()), data->GetData(), length);
+		_items.push_back({socket, address, length, socket->IsTxTimeEnabled() ? _txtime_ns : 0});
+
+		return true;
+	}
+
+	void DatagramBatch::FlushInternal()
+	{
+		if (_items.empty())
+		{
+			return;
+		}
+
+		// Group the items by socket and peer, keeping the order of the datagrams to the same peer
+		std::vector<size_t> indices(_items.size());
+
+		for (size_t index = 0; index < indices.size(); index++)
+		{
+			indices[index] = index;
+		}
+
+		std::stable_sort(indices.begin(), indices.end(), [this](size_t lhs, size_t rhs) -> bool {
+			auto &lhs_item = _items[lhs];
+			auto &rhs_item = _items[rhs];
+
+			if (lhs_item.socket != rhs_item.socket)
+			{
+				return lhs_item.socket < rhs_item.socket;
+			}
+
+			return lhs_item.address < rhs_item.address;
+		});
+
+		size_t begin = 0;
+
+		while (begin < indices.size())
+		{
+			auto &socket = _items[indices[begin]].socket;
+			size_t end = begin + 1;
+
+			while ((end < indices.size()) && (_items[indices[end]].socket == socket))
+			{
+				end++;
+			}
+
+			SendItems(indices, begin, end);
+
+			begin = end;
+		}
+
+		_items.clear();
+	}
+
+	void DatagramBatch::SendItemsOneByOne(const std::vector<size_t> &indices, size_t begin, size_t end)
+	{
+		for (size_t index = begin; index < end; index++)
+		{
+			auto &item = _items[indices[index]];
+
+			// SendTo() queues the data if the socket buffer is full
+			item.socket->SendTo(item.address, GetSlot(indices[index]), item.length);
+		}
+	}
+
+	void DatagramBatch::SendItems(const std::vector<size_t> &indices, size_t begin, size_t end)
+	{
+#if !IS_MACOS
+		auto &socket = _items[indices[begin]].socket;
+
+		if ((socket->GetState() == SocketState::Closed) || socket->HasCommand())
+		{
+			// To keep the order of the datagrams, send them after the queued commands
+			SendItemsOneByOne(indices, begin, end);
+			return;
+		}
+
+		std::vector<mmsghdr> messages;
+		std::vector<iovec> iovs(end - begin);
+		// Index of the first item of each message
+		std::vector<size_t> message_items;
+		std::vector<uint8_t> controls;
+
+		messages.reserve(end - begin);
+		message_items.reserve(end - begin + 1);
+		controls.resize((end - begin) * OV_DATAGRAM_BATCH_CONTROL_SIZE);
+
+		bool use_gso = gso_enabled;
+		size_t current = begin;
+
+		while (current < end)
+		{
+			auto &first_item = _items[indices[current]];
+			size_t segment_size = first_item.length;
+			size_t total_bytes = 0;
+			size_t next = current;
+
+			// Coalesce the datagrams to the same peer: all segments must have the same size except for the last one
+			do
+			{
+				auto &item = _items[indices[next]];
+
+				iovs[next - begin].iov_base = GetSlot(indices[next]);
+				iovs[next - begin].iov_len = item.length;
+				total_bytes += item.length;
+				next++;
+
+				// The datagrams of a GSO message leave at once, so the paced datagrams are not coalesced
+				if ((use_gso == false) || (item.length != segment_size) || (item.txtime_ns != 0))
+				{
+					break;
+				}
+			} while ((next < end) &&
+					 ((next - current) < OV_DATAGRAM_BATCH_MAX_GSO_SEGMENTS) &&
+					 (_items[indices[next]].address == first_item.address) &&
+					 (_items[indices[next]].txtime_ns == 0) &&
+					 (_items[indices[next]].length <= segment_size) &&
+					 ((total_bytes + _items[indices[next]].length) <= OV_DATAGRAM_BATCH_MAX_GSO_BYTES));
+
+			mmsghdr message{};
+			auto &header = message.msg_hdr;
+
+			header.msg_name = const_cast<sockaddr *>(first_item.address.Address());
+			header.msg_namelen = first_item.address.AddressLength();
+			header.msg_iov = &(iovs[current - begin]);
+			header.msg_iovlen = next - current;
+
+			auto control = controls.data() + (messages.size() * OV_DATAGRAM_BATCH_CONTROL_SIZE);
+
+			if ((next - current) > 1)
+			{
+				header.msg_control = control;
+				header.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+
+				auto cmsg = CMSG_FIRSTHDR(&header);
+				cmsg->cmsg_level = SOL_UDP;
+				cmsg->cmsg_type = UDP_SEGMENT;
+				cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+				*reinterpret_cast<uint16_t *>(CMSG_DATA(cmsg)) = static_cast<uint16_t>(segment_size);
+			}
+			else if (first_item.txtime_ns != 0)
+			{
+				header.msg_control = control;
+				header.msg_controllen = CMSG_SPACE(sizeof(uint64_t));
+
+				auto cmsg = CMSG_FIRSTHDR(&header);
+				cmsg->cmsg_level = SOL_SOCKET;
+				cmsg->cmsg_type = SCM_TXTIME;
+				cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+				*reinterpret_cast<uint64_t *>(CMSG_DATA(cmsg)) = static_cast<uint64_t>(first_item.txtime_ns);
+			}
+
+			messages.push_back(message);
+			message_items.push_back(current);
+
+			current = next;
+		}
+
+		message_items.push_back(end);
+
+		size_t sent_messages = 0;
+
+		while (sent_messages < messages.size())
+		{
+			int result = ::sendmmsg(socket->GetNativeHandle(), messages.data() + sent_messages, messages.size() - sent_messages, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+			if (result > 0)
+			{
+				sent_messages += result;
+				continue;
+			}
+
+			auto error = errno;
+			auto failed_begin = message_items[sent_messages];
+			auto failed_end = message_items[sent_messages + 1];
+
+			if ((error == EIO) && (messages[sent_messages].msg_hdr.msg_iovlen > 1))
+			{
+				// The device doesn't support UDP GSO
+				if (gso_enabled.exchange(false))
+				{
+					logtw("UDP GSO is not supported by the device, batched datagrams will be sent without GSO");
+				}
+
+				SendItemsOneByOne(indices, failed_begin, failed_end);
+				sent_messages++;
+				continue;
+			}
+
+			if ((error == EAGAIN) || (error == EWOULDBLOCK) || (error == EINTR))
+			{
+				// Socket buffer is full - SendTo() queues the rest of the datagrams and sends them later
+				SendItemsOneByOne(indices, failed_begin, end);
+				return;
+			}
+
+			// Skip the message which cannot be sent (same as a failure of sendto())
+			logtd("Could not send datagrams using sendmmsg(): %s (%d)", ::strerror(error), error);
+			sent_messages++;
+		}
+#else	// !IS_MACOS
+		SendItemsOneByOne(indices, begin, end);
+#endif	// !IS_MACOS
+	}
+}  // namespace ov
@@ -0,0 +1,93 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <vector>
+
+#include "socket_address.h"
+
+// Maximum number of datagrams to collect before sending them (The batch is flushed when it is full)
+#define OV_DATAGRAM_BATCH_MAX_COUNT 256
+// Datagrams larger than this are sent immediately without batching
+#define OV_DATAGRAM_BATCH_SLOT_SIZE 2048
+// Maximum number of segments in a UDP GSO message (UDP_MAX_SEGMENTS of linux kernel)
+#define OV_DATAGRAM_BATCH_MAX_GSO_SEGMENTS 64
+
+namespace ov
+{
+	class Socket;
+
+	// Collects the datagrams sent by the calling thread, and sends them at once using sendmmsg().
+	// Consecutive datagrams to the same peer are coalesced into one UDP GSO (UDP_SEGMENT) message if the kernel supports it.
+	//
+	// Usage:
+	//     ov::DatagramBatch::Begin();
+	//     ... (socket->SendTo() of UDP sockets are collected) ...
+	//     ov::DatagramBatch::Flush();
+	//
+	// The data is copied into the preallocated slot of the batch, so the caller can reuse its buffer after SendTo() returns.
+	class DatagramBatch
+	{
+	public:
+		// Starts collecting datagrams in the calling thread
+		static void Begin();
+		// Sends the collected datagrams, and stops collecting
+		static void Flush();
+
+		// Called by Socket::SendTo()
+		//
+		// @return Returns false if the batch is not started in the calling thread or the data cannot be batched.
+		//         In this case, the caller must send the data by itself.
+		static bool Append(const std::shared_ptr<Socket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data);
+
+		static bool IsGsoEnabled();
+
+		// Sets the departure time of the datagrams appended by the calling thread after this call (SCM_TXTIME).
+		// It is applied to the sockets which have SO_TXTIME enabled (see Socket::EnableTxTime()).
+		//
+		// @param txtime_ns CLOCK_MONOTONIC in nanoseconds, 0 to send immediately
+		static void SetTxTime(int64_t txtime_ns);
+
+	protected:
+		struct Item
+		{
+			std::shared_ptr<Socket> socket;
+			SocketAddress address;
+			size_t length;
+			// Departure time (0 if the datagram is sent immediately)
+			int64_t txtime_ns;
+		};
+
+		DatagramBatch();
+
+		static DatagramBatch *GetCurrent();
+
+		bool AppendInternal(const std::shared_ptr<Socket> &socket, const SocketAddress &address, const std::shared_ptr<const Data> &data);
+		void FlushInternal();
+
+		// Sends the items of [begin, end) which have the same socket
+		void SendItems(const std::vector<size_t> &indices, size_t begin, size_t end);
+
+		// Sends the items using the non-batched method (Used when sendmmsg() failed)
+		void SendItemsOneByOne(const std::vector<size_t> &indices, size_t begin, size_t end);
+
+		uint8_t *GetSlot(size_t index)
+		{
+			return _slots.data() + (index * OV_DATAGRAM_BATCH_SLOT_SIZE);
+		}
+
+		bool _started = false;
+		int64_t _txtime_ns = 0;
+
+		std::vector<Item> _items;
+		std::vector<uint8_t> _slots;
+	};
+}  // namespace ov
@@ -10,6 +10,7 @@
 #include "datagram_socket.h"
 
 #include "client_socket.h"
+#include "socket_pool/socket_pool_worker.h"
 #include "socket_private.h"
 
 #undef OV_LOG_TAG
@@ -61,6 +62,22 @@ namespace ov
 	{
 		logtp("Trying to read UDP packets...");
 
+#if !IS_MACOS
+		auto error = _worker->RecvDatagrams(this, [this](const SocketAddress &remote, const std::shared_ptr<Data> &data) {
+			if (_datagram_callback != nullptr)
+			{
+				// The data borrows the receive buffer of the worker. If the callback needs to keep it, it must hold the reference.
+				_datagram_callback(GetSharedPtrAs<DatagramSocket>(), remote, data);
+			}
+		});
+
+		if (error != nullptr)
+		{
+			logae("An error occurred while read data: %s", error->ToString().CStr());
+
+			SetState(SocketState::Error);
+		}
+#else	// !IS_MACOS
 		auto data = std::make_shared<ov::Data>(UdpBufferSize);
 
 		while (true)
@@ -89,6 +106,7 @@ namespace ov
 				break;
 			}
 		}
+#endif	// !IS_MACOS
 	}
 
 	String DatagramSocket::ToString() const
@@ -16,6 +16,7 @@
 #include "server_socket.h"
 
 // UDP socket
+#include "datagram_batch.h"
 #include "datagram_socket.h"
 
 // Socket pool
@@ -14,10 +14,23 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#if !IS_MACOS
+#	include <linux/net_tstamp.h>
+
+// <linux/tls.h>
+#	ifndef SOL_TLS
+#		define SOL_TLS 282
+#	endif	// SOL_TLS
+#	ifndef TLS_SET_RECORD_TYPE
+#		define TLS_SET_RECORD_TYPE 1
+#	endif	// TLS_SET_RECORD_TYPE
+#endif	// !IS_MACOS
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 
+#include "datagram_batch.h"
 #include "epoll_wrapper.h"
 #include "socket_pool/socket_pool.h"
 #include "socket_private.h"
@@ -559,6 +572,33 @@ namespace ov
 		}
 	}
 
+	bool Socket::EnableTxTime()
+	{
+#if !IS_MACOS && defined(SO_TXTIME)
+		if (GetType() != SocketType::Udp)
+		{
+			return false;
+		}
+
+		sock_txtime txtime{};
+		txtime.clockid = CLOCK_MONOTONIC;
+		txtime.flags = 0;
+
+		// SetSockOpt() is not used, because a failure is expected on the old kernels
+		if (::setsockopt(GetNativeHandle(), SOL_SOCKET, SO_TXTIME, &txtime, sizeof(txtime)) != 0)
+		{
+			logad("SO_TXTIME is not supported: %s", ::strerror(errno));
+			return false;
+		}
+
+		_is_txtime_enabled = true;
+
+		return true;
+#else	// !IS_MACOS && defined(SO_TXTIME)
+		return false;
+#endif	// !IS_MACOS && defined(SO_TXTIME)
+	}
+
 	std::shared_ptr<ov::SocketAddress> Socket::GetLocalAddress() const
 	{
 		return _local_address;
@@ -661,7 +701,7 @@ namespace ov
 				return DispatchResult::Dispatched;
 
 			case DispatchCommand::Type::Send:
-				sent_bytes = SendInternal(data);
+				sent_bytes = SendInternal(data, command.tls_record_type);
 				break;
 
 			case DispatchCommand::Type::SendTo:
@@ -705,6 +745,43 @@ namespace ov
 		return DispatchResult::PartialDispatched;
 	}
 
+	bool Socket::PostWritableCallback(WritableCallback callback)
+	{
+		if (IsClosing() || (GetState() == SocketState::Closed))
+		{
+			return false;
+		}
+
+		{
+			std::lock_guard lock_guard(_writable_callback_lock);
+			_writable_callbacks.push_back(std::move(callback));
+		}
+
+		// The worker calls OnWritableFromSocket() in its thread
+		return _worker->RequestWritableEvent(GetSharedPtr());
+	}
+
+	void Socket::OnWritableFromSocket()
+	{
+		if (HasCommand())
+		{
+			// Called again when the remaining commands are dispatched
+			return;
+		}
+
+		std::vector<WritableCallback> callbacks;
+
+		{
+			std::lock_guard lock_guard(_writable_callback_lock);
+			std::swap(callbacks, _writable_callbacks);
+		}
+
+		for (auto &callback : callbacks)
+		{
+			callback();
+		}
+	}
+
 	Socket::DispatchResult Socket::DispatchEvents()
 	{
 		SOCKET_PROFILER_INIT();
@@ -805,7 +882,7 @@ namespace ov
 		return result;
 	}
 
-	ssize_t Socket::SendInternal(const std::shared_ptr<const Data> &data)
+	ssize_t Socket::SendInternal(const std::shared_ptr<const Data> &data, uint8_t tls_record_type)
 	{
 		if (GetState() == SocketState::Closed)
 		{
@@ -825,7 +902,37 @@ namespace ov
 			case SocketType::Tcp:
 				while ((remained > 0L) && (_force_stop == false))
 				{
-					ssize_t sent = ::send(GetNativeHandle(), data_to_send, remained, MSG_NOSIGNAL | MSG_DONTWAIT);
+					ssize_t sent;
+
+					if (tls_record_type == 0)
+					{
+						sent = ::send(GetNativeHandle(), data_to_send, remained, MSG_NOSIGNAL | MSG_DONTWAIT);
+					}
+					else
+					{
+#if !IS_MACOS
+						// The kernel encrypts the data as a record of the type in the control message
+						uint8_t control[CMSG_SPACE(sizeof(tls_record_type))] = {};
+						iovec iov = {const_cast<uint8_t *>(data_to_send), remained};
+
+						msghdr message = {};
+						message.msg_iov = &iov;
+						message.msg_iovlen = 1;
+						message.msg_control = control;
+						message.msg_controllen = sizeof(control);
+
+						auto control_message = CMSG_FIRSTHDR(&message);
+						control_message->cmsg_level = SOL_TLS;
+						control_message->cmsg_type = TLS_SET_RECORD_TYPE;
+						control_message->cmsg_len = CMSG_LEN(sizeof(tls_record_type));
+						*CMSG_DATA(control_message) = tls_record_type;
+
+						sent = ::sendmsg(GetNativeHandle(), &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+#else	// !IS_MACOS
+						errno = EOPNOTSUPP;
+						sent = -1L;
+#endif	// !IS_MACOS
+					}
 
 					if (sent < 0L)
 					{
@@ -1083,6 +1190,25 @@ namespace ov
 		}
 	}
 
+	bool Socket::SendTlsRecord(uint8_t record_type, const std::shared_ptr<const Data> &data)
+	{
+		if ((data == nullptr) || (GetType() != SocketType::Tcp))
+		{
+			OV_ASSERT2((data != nullptr) && (GetType() == SocketType::Tcp));
+			return false;
+		}
+
+		CHECK_STATE(== SocketState::Connected, false);
+
+		// The record is sent when the data queued before it is sent (a partial record continues with the same type)
+		if (AppendCommand({record_type, data->Clone()}) == false)
+		{
+			return false;
+		}
+
+		return (DispatchEvents() != DispatchResult::Error);
+	}
+
 	bool Socket::Send(const void *data, size_t length)
 	{
 		return Send((data == nullptr) ? nullptr : std::make_shared<Data>(data, length));
@@ -1135,6 +1261,12 @@ namespace ov
 				}
 			}
 
+			// If the calling thread is collecting datagrams, they will be sent at once in DatagramBatch::Flush()
+			if (DatagramBatch::Append(GetSharedPtr(), address, data))
+			{
+				return true;
+			}
+
 			// Send the data directly
 			auto sent = SendToInternal(address, data);
 
@@ -1489,6 +1621,11 @@ namespace ov
 
 		_post_callback = std::move(_callback);
 
+		{
+			std::lock_guard lock_guard(_writable_callback_lock);
+			_writable_callbacks.clear();
+		}
+
 		if (_socket.IsValid())
 		{
 			switch (GetType())
@@ -24,7 +24,9 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 // Failure to send data for the specified time period will be considered an error.
 // For example, it can occur when EAGAIN continues to occur for a period of time, or when the peer's TCP window is full and no longer receives data.
@@ -95,6 +97,16 @@ namespace ov
 
 		bool SetRecvTimeout(const timeval &tv);
 
+		// Enables SO_TXTIME (CLOCK_MONOTONIC), so a datagram can be sent with its departure time (see DatagramBatch::SetTxTime()).
+		// The departure time is honored by the fq/etf qdisc, otherwise the datagram is sent immediately.
+		//
+		// @return false if the kernel doesn't support SO_TXTIME (Linux 4.19+)
+		bool EnableTxTime();
+		bool IsTxTimeEnabled() const
+		{
+			return _is_txtime_enabled;
+		}
+
 		std::shared_ptr<SocketAddress> GetLocalAddress() const;
 		std::shared_ptr<SocketAddress> GetRemoteAddress() const;
 
@@ -157,6 +169,11 @@ namespace ov
 		bool SendTo(const SocketAddress &address, const std::shared_ptr<const Data> &data);
 		bool SendTo(const SocketAddress &address, const void *data, size_t length);
 
+		// Sends <data> as a TLS record of <record_type> (Alert, Handshake, ...) through kernel TLS (TLS_SET_RECORD_TYPE).
+		// The record is queued after the data which has not been sent yet, so the peer receives them in order.
+		// Only for a TCP socket of which kernel TLS (TLS_TX) is enabled
+		bool SendTlsRecord(uint8_t record_type, const std::shared_ptr<const Data> &data);
+
 		// When Recv is called in non-blocking mode,
 		//
 		// 1. return != nullptr: An error occurred (Include disconnecting the client)
@@ -172,6 +189,15 @@ namespace ov
 		// If MakeNonBlocking() is called, non_block is ignored
 		std::shared_ptr<Error> RecvFrom(std::shared_ptr<Data> &data, SocketAddress *address, bool non_block = false);
 
+		using WritableCallback = std::function<void()>;
+
+		// Calls <callback> once in the epoll thread of the worker when all the queued commands are sent,
+		// so the data produced by another thread can be written without blocking that thread.
+		// The callback is dropped if the socket is closed before it is called.
+		//
+		// @return false if the socket is closing
+		bool PostWritableCallback(WritableCallback callback);
+
 		// Dispatches as many command as possible
 		DispatchResult DispatchEvents();
 
@@ -270,6 +296,14 @@ namespace ov
 			{
 			}
 
+			DispatchCommand(uint8_t tls_record_type, const std::shared_ptr<const Data> &data)
+				: type(Type::Send),
+				  data(data),
+				  tls_record_type(tls_record_type),
+				  enqueued_time(std::chrono::system_clock::now())
+			{
+			}
+
 			DispatchCommand(const SocketAddress &address, const std::shared_ptr<const Data> &data)
 				: type(Type::SendTo),
 				  address(address),
@@ -316,6 +350,8 @@ namespace ov
 			Type type = Type::Close;
 			SocketAddress address;
 			std::shared_ptr<const Data> data;
+			// Record type of kernel TLS (0: application data)
+			uint8_t tls_record_type = 0;
 			std::chrono::time_point<std::chrono::system_clock> enqueued_time;
 		};
 
@@ -328,7 +364,8 @@ namespace ov
 
 		DispatchResult DispatchInternal(DispatchCommand &command);
 
-		ssize_t SendInternal(const std::shared_ptr<const Data> &data);
+		// @param tls_record_type If it isn't 0, <data> is sent as a record of the type through kernel TLS (TCP only)
+		ssize_t SendInternal(const std::shared_ptr<const Data> &data, uint8_t tls_record_type = 0);
 		ssize_t SendToInternal(const SocketAddress &address, const std::shared_ptr<const Data> &data);
 
 		// From SocketPollWorker (Called when EPOLLIN event raised)
@@ -340,6 +377,9 @@ namespace ov
 			}
 		}
 
+		// From SocketPollWorker (Called when the commands are dispatched by EPOLLOUT event or PostWritableCallback())
+		void OnWritableFromSocket();
+
 		std::shared_ptr<Error> RecvInternal(void *data, size_t length, size_t *received_length);
 
 		virtual String ToString(const char *class_name) const;
@@ -360,6 +400,8 @@ namespace ov
 
 		bool _end_of_stream = false;
 
+		std::atomic<bool> _is_txtime_enabled{false};
+
 		std::shared_ptr<SocketAddress> _local_address = nullptr;
 		std::shared_ptr<SocketAddress> _remote_address = nullptr;
 
@@ -373,6 +415,9 @@ namespace ov
 		// A temporary variable used to send callback without mutex lock
 		std::shared_ptr<SocketAsyncInterface> _post_callback;
 
+		std::mutex _writable_callback_lock;
+		std::vector<WritableCallback> _writable_callbacks;
+
 		volatile bool _force_stop = false;
 	};
 }  // namespace ov
@@ -45,6 +45,8 @@ namespace ov
 
 	const ssize_t TcpBufferSize = 4096;
 	const ssize_t UdpBufferSize = 4096;
+	// The number of datagrams read at once using recvmmsg()
+	constexpr const int UdpRecvRingSize = 64;
 
 	enum class SocketConnectionState : int8_t
 	{
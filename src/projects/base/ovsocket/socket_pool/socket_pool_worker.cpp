@@ -224,6 +224,99 @@ namespace ov
 		}
 	}
 
+#if !IS_MACOS
+	void SocketPoolWorker::PrepareRecvSlot(int index)
+	{
+		auto &buffer = _recv_buffers[index];
+
+		if ((buffer == nullptr) || (buffer.use_count() > 1))
+		{
+			// The buffer is still used by someone, so allocate a new one
+			buffer = std::make_shared<Data>(UdpBufferSize);
+		}
+
+		// If a clone of the buffer is still alive, GetWritableData() separates it from the clone (copy-on-write)
+		buffer->SetLength(UdpBufferSize);
+		_recv_iovs[index].iov_base = buffer->GetWritableData();
+
+		// recvmmsg() overwrites only these fields
+		_recv_messages[index].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+		_recv_messages[index].msg_len = 0;
+	}
+#endif	// !IS_MACOS
+
+	std::shared_ptr<Error> SocketPoolWorker::RecvDatagrams(Socket *socket, const DatagramHandler &handler)
+	{
+#if !IS_MACOS
+		if (_recv_buffers.empty())
+		{
+			_recv_buffers.resize(UdpRecvRingSize);
+			_recv_addresses.resize(UdpRecvRingSize);
+			_recv_messages.resize(UdpRecvRingSize);
+			_recv_iovs.resize(UdpRecvRingSize);
+
+			for (int index = 0; index < UdpRecvRingSize; index++)
+			{
+				auto &iov = _recv_iovs[index];
+				iov.iov_len = UdpBufferSize;
+
+				auto &header = _recv_messages[index].msg_hdr;
+				header = {};
+				header.msg_name = &(_recv_addresses[index]);
+				header.msg_iov = &iov;
+				header.msg_iovlen = 1;
+
+				PrepareRecvSlot(index);
+			}
+		}
+
+		while (true)
+		{
+			int count = ::recvmmsg(socket->GetNativeHandle(), _recv_messages.data(), UdpRecvRingSize, MSG_DONTWAIT, nullptr);
+
+			if (count < 0)
+			{
+				auto error = Error::CreateErrorFromErrno();
+
+				if ((error->GetCode() == EAGAIN) || (error->GetCode() == EWOULDBLOCK))
+				{
+					// All datagrams are read
+					return nullptr;
+				}
+
+				if (error->GetCode() == EINTR)
+				{
+					continue;
+				}
+
+				return error;
+			}
+
+			for (int index = 0; index < count; index++)
+			{
+				auto &buffer = _recv_buffers[index];
+
+				buffer->SetLength(_recv_messages[index].msg_len);
+
+				handler(SocketAddress(_recv_addresses[index]), buffer);
+			}
+
+			// The slots which are not filled by this round are still ready
+			for (int index = 0; index < count; index++)
+			{
+				PrepareRecvSlot(index);
+			}
+
+			if (count == 0)
+			{
+				return nullptr;
+			}
+		}
+#else	// !IS_MACOS
+		return Error::CreateError("Socket", "recvmmsg() is not supported");
+#endif	// !IS_MACOS
+	}
+
 	void SocketPoolWorker::ThreadProc()
 	{
 		_gc_interval.Start();
@@ -259,6 +352,7 @@ namespace ov
 						switch (socket->DispatchEvents())
 						{
 							case Socket::DispatchResult::Dispatched:
+								socket->OnWritableFromSocket();
 								break;
 
 							case Socket::DispatchResult::PartialDispatched:
@@ -320,6 +414,7 @@ namespace ov
 					switch (socket->DispatchEvents())
 					{
 						case Socket::DispatchResult::Dispatched:
+							socket->OnWritableFromSocket();
 							break;
 
 						case Socket::DispatchResult::PartialDispatched:
@@ -562,6 +657,38 @@ namespace ov
 		_sockets_to_dispatch.push_back(socket);
 	}
 
+	bool SocketPoolWorker::RequestWritableEvent(const std::shared_ptr<Socket> &socket)
+	{
+#if !IS_MACOS
+		switch (GetType())
+		{
+			case SocketType::Tcp:
+			case SocketType::Udp: {
+				epoll_event event{};
+
+				// Same events as AttachToWorker(), EPOLL_CTL_MOD raises the event again if the socket is ready
+				event.events = EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP | EPOLLRDHUP | EPOLLET;
+				event.data.ptr = socket.get();
+
+				if (::epoll_ctl(_epoll, EPOLL_CTL_MOD, socket->GetNativeHandle(), &event) == 0)
+				{
+					return true;
+				}
+
+				logad("Could not re-arm EPOLLOUT for socket #%d: %s", socket->GetNativeHandle(), Error::CreateErrorFromErrno()->ToString().CStr());
+				break;
+			}
+
+			default:
+				break;
+		}
+#endif	// !IS_MACOS
+
+		EnqueueToDispatchLater(socket);
+
+		return true;
+	}
+
 	bool SocketPoolWorker::RemoveFromEpoll(const std::shared_ptr<Socket> &socket)
 	{
 		if (GetNativeHandle() == InvalidSocket)
@@ -55,6 +55,17 @@ namespace ov
 			return RemoveFromEpoll(socket);
 		}
 
+		using DatagramHandler = std::function<void(const SocketAddress &remote, const std::shared_ptr<Data> &data)>;
+
+		// Reads all pending datagrams of <socket> using recvmmsg() into the receive ring of this worker,
+		// and calls <handler> for each datagram.
+		//
+		// <data> of the handler borrows a buffer of the ring, so no memory is allocated per datagram.
+		// If the handler keeps <data> (or a clone of it), the ring allocates a new buffer for that slot before reusing it.
+		//
+		// Must be called in the epoll thread of this worker (from Socket::OnReadableFromSocket())
+		std::shared_ptr<Error> RecvDatagrams(Socket *socket, const DatagramHandler &handler);
+
 	protected:
 		SocketType GetType() const;
 
@@ -92,6 +103,16 @@ namespace ov
 
 		void EnqueueToDispatchLater(const std::shared_ptr<Socket> &socket);
 
+		// Wakes up the epoll thread to dispatch the commands of <socket> and call Socket::OnWritableFromSocket().
+		// For TCP/UDP, the edge-triggered EPOLLOUT is re-armed, so epoll_wait() returns immediately if the socket is writable.
+		// Otherwise, it is done after the next epoll_wait() (at most 200ms).
+		bool RequestWritableEvent(const std::shared_ptr<Socket> &socket);
+
+#if !IS_MACOS
+		// Makes the slot of the receive ring ready for recvmmsg()
+		void PrepareRecvSlot(int index);
+#endif	// !IS_MACOS
+
 		std::shared_ptr<SocketPool> _pool;
 
 		// The number of sockets is determined in advance and managed separately for processing
@@ -127,6 +148,14 @@ namespace ov
 		// Related to epoll
 		socket_t _epoll = InvalidSocket;
 
+		// Receive ring used by RecvDatagrams() (Only accessed in the epoll thread)
+		std::vector<std::shared_ptr<Data>> _recv_buffers;
+		std::vector<sockaddr_storage> _recv_addresses;
+#if !IS_MACOS
+		std::vector<mmsghdr> _recv_messages;
+#endif	// !IS_MACOS
+		std::vector<iovec> _recv_iovs;
+
 		// Related to SRT
 		SRTSOCKET _srt_epoll = InvalidSocket;
 		std::vector<SRT_EPOLL_EVENT> _srt_epoll_events;
@@ -30,6 +30,18 @@ namespace pub
 		virtual bool SendOutgoingData(const std::any &packet) = 0;
 		virtual void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) = 0;
 
+		// Whether the session can send packets now (e.g. the transport is connected).
+		// The stream holds the cached GOP until the session is ready.
+		virtual bool IsReadyToSend()
+		{
+			return GetState() == SessionState::Started;
+		}
+
+		// Called right before the cached GOP (starting with a key frame) is sent to the session
+		virtual void OnGopCacheStarted()
+		{
+		}
+
 		enum class SessionState : int8_t
 		{
 			Ready,
@@ -2,13 +2,18 @@
 #include "application.h"
 #include "publisher_private.h"
 
+#include "base/ovsocket/datagram_batch.h"
+#include "monitoring/monitoring.h"
+#include "stream_worker_pool.h"
+
 namespace pub
 {
-	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream)
+	StreamWorker::StreamWorker(const std::shared_ptr<Stream> &parent_stream, uint32_t index)
 		: _packet_queue(nullptr, 500)
 	{
 		_stop_thread_flag = true;
 		_parent = parent_stream;
+		_schedule_hint = parent_stream->GetId() + index;
 	}
 
 	StreamWorker::~StreamWorker()
@@ -29,8 +34,6 @@ namespace pub
 		_packet_queue.SetAlias(queue_name.CStr());
 		
 		_stop_thread_flag = false;
-		_worker_thread = std::thread(&StreamWorker::WorkerThread, this);
-		pthread_setname_np(_worker_thread.native_handle(), "StreamWorker");
 
 		return true;
 	}
@@ -43,12 +46,11 @@ namespace pub
 		}
 
 		_stop_thread_flag = true;
-		// Generate Event
-		_packet_queue.Stop();
-		_queue_event.Notify();
-		if(_worker_thread.joinable())
+
 		{
-			_worker_thread.join();
+			// Wait until the pool finishes running this worker
+			std::lock_guard<std::mutex> process_lock(_process_mutex);
+			_packet_queue.Clear();
 		}
 
 		std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
@@ -59,6 +61,12 @@ namespace pub
 		}
 		_sessions.clear();
 
+		for (auto const &x : _pending_sessions)
+		{
+			x.second->session->Stop();
+		}
+		_pending_sessions.clear();
+
 		return true;
 	}
 
@@ -76,6 +84,31 @@ namespace pub
 		return true;
 	}
 
+	bool StreamWorker::AddSession(std::shared_ptr<Session> session, std::vector<std::any> gop_cache, uint64_t last_sequence)
+	{
+		if (gop_cache.empty())
+		{
+			return AddSession(session);
+		}
+
+		// Cannot add session after StreamWorker is stopped
+		if (_stop_thread_flag)
+		{
+			return true;
+		}
+
+		auto pending_session = std::make_shared<PendingSession>();
+
+		pending_session->session = session;
+		pending_session->backlog.assign(std::make_move_iterator(gop_cache.begin()), std::make_move_iterator(gop_cache.end()));
+		pending_session->last_sequence = last_sequence;
+
+		std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
+		_pending_sessions[session->GetId()] = pending_session;
+
+		return true;
+	}
+
 	bool StreamWorker::RemoveSession(session_id_t id)
 	{
 		// Cannot remove session after StreamWorker is stopped
@@ -85,14 +118,25 @@ namespace pub
 		}
 
 		std::unique_lock<std::shared_mutex> lock(_session_map_mutex);
-		if (_sessions.count(id) <= 0)
+		std::shared_ptr<Session> session;
+
+		auto pending_item = _pending_sessions.find(id);
+		if (pending_item != _pending_sessions.end())
 		{
-			logte("Cannot find session : %u", id);
-			return false;
+			session = pending_item->second->session;
+			_pending_sessions.erase(pending_item);
 		}
+		else
+		{
+			if (_sessions.count(id) <= 0)
+			{
+				logte("Cannot find session : %u", id);
+				return false;
+			}
 
-		auto session = _sessions[id];
-		_sessions.erase(id);
+			session = _sessions[id];
+			_sessions.erase(id);
+		}
 		lock.unlock();
 
 		session->Stop();
@@ -105,6 +149,12 @@ namespace pub
 		std::shared_lock<std::shared_mutex> lock(_session_map_mutex);
 		if (_sessions.count(id) <= 0)
 		{
+			auto pending_item = _pending_sessions.find(id);
+			if (pending_item != _pending_sessions.end())
+			{
+				return pending_item->second->session;
+			}
+
 			// logte("Cannot find session : %u", id);
 			return nullptr;
 		}
@@ -112,50 +162,139 @@ namespace pub
 		return _sessions[id];
 	}
 
-	void StreamWorker::SendPacket(const std::any &packet)
+	void StreamWorker::SendPacket(const StreamPacket &packet)
 	{
+		if (_stop_thread_flag)
+		{
+			return;
+		}
+
 		_packet_queue.Enqueue(packet);
-		_queue_event.Notify();
+
+		ScheduleIfNeeded();
 	}
 
-	std::any StreamWorker::PopStreamPacket()
+	void StreamWorker::ScheduleIfNeeded()
 	{
-		if (_packet_queue.IsEmpty())
+		if (_is_scheduled.exchange(true) == false)
 		{
-			return nullptr;
+			StreamWorkerPool::GetInstance()->Schedule(GetSharedPtr(), _schedule_hint);
 		}
+	}
 
-		auto data = _packet_queue.Dequeue();
-		if(data.has_value())
+	void StreamWorker::Process()
+	{
 		{
-			return data.value();
+			std::lock_guard<std::mutex> process_lock(_process_mutex);
+
+			if (_stop_thread_flag)
+			{
+				_is_scheduled = false;
+				return;
+			}
+
+			std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
+
+			// Datagrams produced during one fan-out pass are sent at once using sendmmsg()
+			ov::DatagramBatch::Begin();
+
+			StreamPacket packet;
+			std::vector<session_id_t> caught_up_session_ids;
+
+			for (int count = 0; (count < STREAM_WORKER_MAX_PACKETS_PER_RUN) && (_stop_thread_flag == false); count++)
+			{
+				if (_packet_queue.TryDequeue(packet) == false)
+				{
+					break;
+				}
+
+				for (auto const &x : _sessions)
+				{
+					auto session = std::static_pointer_cast<Session>(x.second);
+					session->SendOutgoingData(packet.packet);
+				}
+
+				for (auto const &x : _pending_sessions)
+				{
+					auto &pending_session = *(x.second);
+
+					// The packets queued before the snapshot of the GOP cache are in the backlog already
+					if (packet.sequence > pending_session.last_sequence)
+					{
+						pending_session.backlog.push_back(packet.packet);
+						pending_session.last_sequence = packet.sequence;
+					}
+
+					// Catches up at a multiple of the live rate, so that the player is not flooded
+					if (SendBacklog(pending_session, STREAM_GOP_CACHE_CATCH_UP_RATE))
+					{
+						caught_up_session_ids.push_back(x.first);
+					}
+				}
+			}
+
+			ov::DatagramBatch::Flush();
+
+			if (caught_up_session_ids.empty() == false)
+			{
+				// Still holding _process_mutex, so no live packet is sent while the sessions are moved
+				session_lock.unlock();
+
+				std::lock_guard<std::shared_mutex> lock(_session_map_mutex);
+
+				for (auto session_id : caught_up_session_ids)
+				{
+					auto pending_item = _pending_sessions.find(session_id);
+					if (pending_item != _pending_sessions.end())
+					{
+						_sessions[session_id] = pending_item->second->session;
+						_pending_sessions.erase(pending_item);
+					}
+				}
+			}
 		}
 
-		return nullptr;
+		_is_scheduled = false;
+
+		// If packets are queued after the last TryDequeue(), SendPacket() may have seen _is_scheduled == true
+		if (_packet_queue.IsEmpty() == false)
+		{
+			ScheduleIfNeeded();
+		}
 	}
 
-	void StreamWorker::WorkerThread()
+	bool StreamWorker::SendBacklog(PendingSession &pending_session, size_t max_count)
 	{
-		std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex, std::defer_lock);
+		auto &session = pending_session.session;
+		auto &backlog = pending_session.backlog;
 
-		while (!_stop_thread_flag)
+		if (session->IsReadyToSend() == false)
 		{
-			_queue_event.Wait();
-
-			auto packet = PopStreamPacket();
-			if (!packet.has_value())
+			if (backlog.size() > (STREAM_GOP_CACHE_MAX_PACKETS * 2))
 			{
-				continue;
-			}
-			
-			session_lock.lock();
-			for (auto const &x : _sessions)
-			{
-				auto session = std::static_pointer_cast<Session>(x.second);
-				session->SendOutgoingData(packet);
+				// The session takes too long to be ready - it will start from the next key frame as if there is no cache
+				logtd("Session %u is not ready to send the cached GOP (%zu packets are pending), the cache is discarded", session->GetId(), backlog.size());
+				backlog.clear();
+
+				return true;
 			}
-			session_lock.unlock();
+
+			return false;
+		}
+
+		if ((pending_session.is_gop_cache_started == false) && (backlog.empty() == false))
+		{
+			session->OnGopCacheStarted();
+			pending_session.is_gop_cache_started = true;
+		}
+
+		for (size_t count = 0; (count < max_count) && (backlog.empty() == false); count++)
+		{
+			session->SendOutgoingData(backlog.front());
+			backlog.pop_front();
 		}
+
+		return backlog.empty();
 	}
 
 	Stream::Stream(const std::shared_ptr<Application> application, const info::Stream &info)
@@ -207,10 +346,10 @@ namespace pub
 		}
 
 		_worker_count = worker_count;
-		// Create WorkerThread
+		// Create workers (They are run by StreamWorkerPool, so no thread is created here)
 		for (uint32_t i = 0; i < _worker_count; i++)
 		{
-			auto stream_worker = std::make_shared<StreamWorker>(GetSharedPtr());
+			auto stream_worker = std::make_shared<StreamWorker>(GetSharedPtr(), i);
 						
 			if (stream_worker->Start() == false)
 			{
@@ -248,6 +387,12 @@ namespace pub
 
 		worker_lock.unlock();
 
+		{
+			std::lock_guard<std::mutex> gop_cache_lock(_gop_cache_mutex);
+			_gop_cache.clear();
+			_gop_cache_started = false;
+		}
+
 		std::lock_guard<std::shared_mutex> session_lock(_session_map_mutex);
 		for(const auto &x : _sessions)
 		{
@@ -292,8 +437,22 @@ namespace pub
 		// For getting session, all sessions
 		_sessions[session->GetId()] = session;
 
+		auto stream_metrics = StreamMetrics(*static_cast<info::Stream *>(this));
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->OnSubscriberAdded();
+		}
+
 		if(_worker_count > 0)
 		{
+			if (_gop_cache_enabled)
+			{
+				// Packets after this snapshot are queued to the worker after the session is added
+				std::lock_guard<std::mutex> gop_cache_lock(_gop_cache_mutex);
+
+				return GetWorkerBySessionID(session->GetId())->AddSession(session, _gop_cache, _last_packet_sequence);
+			}
+
 			return GetWorkerBySessionID(session->GetId())->AddSession(session);
 		}
 
@@ -311,6 +470,12 @@ namespace pub
 		_sessions.erase(id);
 		session_lock.unlock();
 
+		auto stream_metrics = StreamMetrics(*static_cast<info::Stream *>(this));
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->OnSubscriberRemoved();
+		}
+
 		if(_worker_count > 0)
 		{
 			return GetWorkerBySessionID(id)->RemoveSession(id);
@@ -346,25 +511,97 @@ namespace pub
 	{
 		if(_worker_count > 0)
 		{
+			std::unique_lock<std::mutex> gop_cache_lock(_gop_cache_mutex, std::defer_lock);
+			StreamPacket stream_packet;
+
+			stream_packet.packet = packet;
+
+			if (_gop_cache_enabled)
+			{
+				gop_cache_lock.lock();
+
+				stream_packet.sequence = ++_last_packet_sequence;
+				AppendToGopCache(packet);
+			}
+
 			std::shared_lock<std::shared_mutex> worker_lock(_stream_worker_lock);
 			for (uint32_t i = 0; i < _stream_workers.size(); i++)
 			{
-				_stream_workers[i]->SendPacket(packet);
+				_stream_workers[i]->SendPacket(stream_packet);
 			}
 		}
 		else
 		{
 			std::shared_lock<std::shared_mutex> session_lock(_session_map_mutex);
+
+			ov::DatagramBatch::Begin();
 			for (auto const &x : _sessions)
 			{
 				auto session = std::static_pointer_cast<Session>(x.second);
 				session->SendOutgoingData(packet);
 			}
+			ov::DatagramBatch::Flush();
 		}
 	
 		return true;
 	}
 
+	void Stream::SetGopCacheEnabled(bool enabled)
+	{
+		std::lock_guard<std::mutex> gop_cache_lock(_gop_cache_mutex);
+
+		_gop_cache_enabled = enabled;
+
+		if (enabled == false)
+		{
+			_gop_cache.clear();
+			_gop_cache_started = false;
+		}
+	}
+
+	void Stream::StartGopCache(uint32_t track_id)
+	{
+		if (_gop_cache_enabled == false)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> gop_cache_lock(_gop_cache_mutex);
+
+		if (_gop_cache_track_id == -1)
+		{
+			_gop_cache_track_id = track_id;
+		}
+		else if (_gop_cache_track_id != track_id)
+		{
+			return;
+		}
+
+		_gop_cache.clear();
+		_gop_cache_started = true;
+	}
+
+	void Stream::AppendToGopCache(const std::any &packet)
+	{
+		// _gop_cache_mutex must be held
+		if (_gop_cache_started == false)
+		{
+			return;
+		}
+
+		if (_gop_cache.size() >= STREAM_GOP_CACHE_MAX_PACKETS)
+		{
+			logtd("[%s(%u)] GOP is too long to cache, the cache is not used until the next key frame", GetName().CStr(), GetId());
+
+			_gop_cache.clear();
+			_gop_cache_started = false;
+
+			return;
+		}
+
+		_gop_cache.push_back(packet);
+	}
+
 	uint32_t Stream::IssueUniqueSessionId()
 	{
 		auto new_session_id = _last_issued_session_id++;
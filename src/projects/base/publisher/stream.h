@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <shared_mutex>
 #include "base/common_types.h"
 #include "base/info/stream.h"
@@ -7,36 +8,76 @@
 #include "session.h"
 
 #define MAX_STREAM_WORKER_THREAD_COUNT 72
+// Maximum number of packets sent by a StreamWorker at a time, so that the other streams are not delayed
+#define STREAM_WORKER_MAX_PACKETS_PER_RUN 256
+// Maximum number of packets in the GOP cache. If a GOP is longer than this, the cache is not used until the next key frame.
+#define STREAM_GOP_CACHE_MAX_PACKETS 4096
+// While a new session catches up with the live packets, this number of cached packets are sent per live packet
+#define STREAM_GOP_CACHE_CATCH_UP_RATE 4
 
 namespace pub
 {
-	class StreamWorker
+	struct StreamPacket
+	{
+		// Issued by the stream to find out which packets are in the GOP cache already (0 if the GOP cache is disabled)
+		uint64_t sequence = 0;
+		std::any packet;
+	};
+
+	// Sends the packets of a stream to a part of the sessions.
+	// StreamWorker doesn't have its own thread. It is run by StreamWorkerPool when packets are queued.
+	class StreamWorker : public ov::EnableSharedFromThis<StreamWorker>, public ov::WorkerPoolJob
 	{
 	public:
-		StreamWorker(const std::shared_ptr<Stream> &parent_stream);
-		~StreamWorker();
+		StreamWorker(const std::shared_ptr<Stream> &parent_stream, uint32_t index);
+		~StreamWorker() override;
 
 		bool Start();
 		bool Stop();
 
 		bool AddSession(std::shared_ptr<Session> session);
+		// The session is primed with the cached GOP, and the live packets after last_sequence.
+		// It joins the live broadcast when it has caught up.
+		bool AddSession(std::shared_ptr<Session> session, std::vector<std::any> gop_cache, uint64_t last_sequence);
 		bool RemoveSession(session_id_t id);
 		std::shared_ptr<Session> GetSession(session_id_t id);
 
-		void SendPacket(const std::any &packet);
+		void SendPacket(const StreamPacket &packet);
+
+		// Called by StreamWorkerPool: sends the queued packets to the sessions
+		void Process() override;
 
 	private:
-		void WorkerThread();
+		// A session which is being primed with the GOP cache
+		struct PendingSession
+		{
+			std::shared_ptr<Session> session;
+			// The cached GOP, followed by the live packets received while the session is catching up
+			std::deque<std::any> backlog;
+			// The live packets up to this sequence are in the backlog already
+			uint64_t last_sequence = 0;
+			bool is_gop_cache_started = false;
+		};
+
+		void ScheduleIfNeeded();
+
+		// @return true if the session has caught up with the live packets
+		bool SendBacklog(PendingSession &pending_session, size_t max_count);
 
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
+		std::map<session_id_t, std::shared_ptr<PendingSession>> _pending_sessions;
 		std::shared_mutex _session_map_mutex;
-		ov::Semaphore _queue_event;
 
-		std::any PopStreamPacket();
-		ov::Queue<std::any> _packet_queue;
+		ov::RingQueue<StreamPacket> _packet_queue;
+
+		std::atomic<bool> _stop_thread_flag;
+		// Whether the worker is queued to (or being run by) StreamWorkerPool
+		std::atomic<bool> _is_scheduled{false};
+		// Held while the worker is being run
+		std::mutex _process_mutex;
 
-		bool _stop_thread_flag;
-		std::thread _worker_thread;
+		// Used to spread the workers across the threads of the pool
+		uint32_t _schedule_hint = 0;
 
 		std::shared_ptr<Stream> _parent;
 	};
@@ -65,6 +106,10 @@ namespace pub
 		// A child call this function to delivery packet to all sessions
 		bool BroadcastPacket(const std::any &packet);
 
+		// Keeps the packets since the last key frame, so that a new session can start playing immediately.
+		// Works only if the stream has StreamWorkers.
+		void SetGopCacheEnabled(bool enabled);
+
 		// Child must implement this function for packetizing and call BroadcastPacket to delivery to all sessions.
 		virtual void SendVideoFrame(const std::shared_ptr<MediaPacket> &media_packet) = 0;
 		virtual void SendAudioFrame(const std::shared_ptr<MediaPacket> &media_packet) = 0;
@@ -90,7 +135,13 @@ namespace pub
 		Stream(const std::shared_ptr<Application> application, const info::Stream &info);
 		virtual ~Stream();
 
+		// A child calls this function right before it broadcasts the packets of a video key frame.
+		// The cache is anchored to the first video track which calls this function.
+		void StartGopCache(uint32_t track_id);
+
 	private:
+		void AppendToGopCache(const std::any &packet);
+
 		std::shared_ptr<StreamWorker> GetWorkerBySessionID(session_id_t session_id);
 		std::map<session_id_t, std::shared_ptr<Session>> _sessions;
 		std::shared_mutex _session_map_mutex;
@@ -103,6 +154,14 @@ namespace pub
 
 		session_id_t _last_issued_session_id;
 
+		// Held while a packet is queued to the workers, so that a new session doesn't miss the packets after the snapshot of the cache
+		std::mutex _gop_cache_mutex;
+		std::atomic<bool> _gop_cache_enabled{false};
+		bool _gop_cache_started = false;
+		int64_t _gop_cache_track_id = -1;
+		std::vector<std::any> _gop_cache;
+		uint64_t _last_packet_sequence = 0;
+
 		State _state = State::CREATED;
 	};
 }  // namespace pub
\ No newline at end of file
@@ -0,0 +1,25 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "stream_worker_pool.h"
+
+#include "publisher_private.h"
+#include "stream.h"
+
+namespace pub
+{
+	StreamWorkerPool::StreamWorkerPool()
+		: ov::WorkerPool("StreamWorker", STREAM_WORKER_POOL_QUEUE_SIZE)
+	{
+	}
+
+	void StreamWorkerPool::Schedule(const std::shared_ptr<StreamWorker> &worker, uint32_t hint)
+	{
+		ov::WorkerPool::Schedule(worker, hint);
+	}
+}  // namespace pub
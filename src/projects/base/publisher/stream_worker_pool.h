@@ -0,0 +1,37 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <memory>
+
+#include "base/ovlibrary/ovlibrary.h"
+
+// The capacity of the ring of each pool thread. A StreamWorker is queued at most once, so the rings of all threads
+// hold (threads * this) streams with pending packets. Beyond that, the workers wait in the overflow list.
+#define STREAM_WORKER_POOL_QUEUE_SIZE 1024
+
+namespace pub
+{
+	class StreamWorker;
+
+	// A process-wide thread pool which runs the session fan-out jobs of all streams.
+	//
+	// - StreamWorker schedules itself only when it has packets to send, so idle streams don't use any thread
+	// - A StreamWorker is run by only one thread at a time, so the order of packets is kept.
+	//   Busy streams have several StreamWorkers, which are run on different cores at the same time.
+	// (See ov::WorkerPool for the scheduling)
+	class StreamWorkerPool : public ov::WorkerPool, public ov::Singleton<StreamWorkerPool>
+	{
+	public:
+		StreamWorkerPool();
+
+		// @param hint The worker is queued to the thread (hint % thread count) if the thread is idle
+		void Schedule(const std::shared_ptr<StreamWorker> &worker, uint32_t hint);
+	};
+}  // namespace pub
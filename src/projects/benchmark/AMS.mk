@@ -0,0 +1,3 @@
+LOCAL_PATH := $(call get_local_path)
+
+include $(BUILD_SUB_AMS)
@@ -0,0 +1,22 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+// Common functions of the benchmarks
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace benchmark
+{
+	// Steady clock in nanoseconds
+	inline int64_t GetNowNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}  // namespace benchmark
@@ -0,0 +1,14 @@
+LOCAL_PATH := $(call get_local_path)
+include $(DEFAULT_VARIABLES)
+
+LOCAL_STATIC_LIBRARIES := \
+	ovlibrary
+
+LOCAL_LDFLAGS := -lpthread
+
+$(call add_pkg_config,openssl)
+$(call add_pkg_config,srt)
+
+LOCAL_TARGET := ring_queue_benchmark
+
+include $(BUILD_EXECUTABLE)
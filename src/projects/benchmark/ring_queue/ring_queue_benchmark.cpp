@@ -0,0 +1,155 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+// Compares ov::RingQueue with ov::Queue under contention
+//
+// N producers enqueue items to a queue, and a consumer dequeues them (the pattern of the media paths:
+// providers -> MediaRouteStream, mediarouter -> publisher streams). Reports:
+//   - Throughput: items per second while the producers enqueue as fast as they can (the latency of this run
+//     is mostly the time spent in the backlog)
+//   - Latency: time from Enqueue() to the return of Dequeue() (p50/p99/max) while the producers enqueue a burst
+//     of RING_QUEUE_BENCHMARK_BURST items every RING_QUEUE_BENCHMARK_BURST_INTERVAL_US (like the packets of a frame)
+//
+// Usage: ring_queue_benchmark [items per producer] [max producers]
+#include <base/ovlibrary/ovlibrary.h>
+#include <base/ovlibrary/queue.h>
+#include <base/ovlibrary/ring_queue.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "../benchmark_utilities.h"
+
+#define RING_QUEUE_BENCHMARK_BURST 16
+#define RING_QUEUE_BENCHMARK_BURST_INTERVAL_US 200
+
+namespace
+{
+	struct Item
+	{
+		int64_t enqueue_time_ns = 0;
+		// The media paths pass shared_ptrs, so the benchmark does the same
+		std::shared_ptr<int> payload;
+	};
+
+	struct Result
+	{
+		double items_per_second = 0.0;
+		int64_t p50_ns = 0;
+		int64_t p99_ns = 0;
+		int64_t max_ns = 0;
+	};
+
+	template <typename Tqueue>
+	Result Run(Tqueue &queue, size_t producer_count, size_t items_per_producer, bool is_paced)
+	{
+		auto total_count = producer_count * items_per_producer;
+		auto payload = std::make_shared<int>(0);
+
+		std::vector<int64_t> latencies;
+		latencies.reserve(total_count);
+
+		std::atomic<bool> start{false};
+		std::vector<std::thread> producers;
+
+		for (size_t index = 0; index < producer_count; index++)
+		{
+			producers.emplace_back([&]() {
+				while (start == false)
+				{
+					std::this_thread::yield();
+				}
+
+				for (size_t count = 0; count < items_per_producer; count++)
+				{
+					queue.Enqueue(Item{benchmark::GetNowNs(), payload});
+
+					if (is_paced && (((count + 1) % RING_QUEUE_BENCHMARK_BURST) == 0))
+					{
+						std::this_thread::sleep_for(std::chrono::microseconds(RING_QUEUE_BENCHMARK_BURST_INTERVAL_US));
+					}
+				}
+			});
+		}
+
+		auto start_time = benchmark::GetNowNs();
+		start = true;
+
+		for (size_t count = 0; count < total_count; count++)
+		{
+			auto item = queue.Dequeue();
+
+			if (item.has_value() == false)
+			{
+				break;
+			}
+
+			latencies.push_back(benchmark::GetNowNs() - item->enqueue_time_ns);
+		}
+
+		auto elapsed = benchmark::GetNowNs() - start_time;
+
+		for (auto &producer : producers)
+		{
+			producer.join();
+		}
+
+		Result result;
+
+		result.items_per_second = (latencies.size() * 1000000000.0) / std::max<int64_t>(elapsed, 1);
+
+		if (latencies.empty() == false)
+		{
+			std::sort(latencies.begin(), latencies.end());
+
+			result.p50_ns = latencies[latencies.size() / 2];
+			result.p99_ns = latencies[(latencies.size() * 99) / 100];
+			result.max_ns = latencies.back();
+		}
+
+		return result;
+	}
+
+	template <typename Tqueue>
+	void RunAndPrint(const char *name, size_t producer_count, size_t items_per_producer)
+	{
+		Result saturated;
+		Result paced;
+
+		{
+			Tqueue queue(name);
+			saturated = Run(queue, producer_count, items_per_producer, false);
+		}
+
+		{
+			Tqueue queue(name);
+			paced = Run(queue, producer_count, std::max<size_t>(items_per_producer / 10, RING_QUEUE_BENCHMARK_BURST), true);
+		}
+
+		::printf("%-14s producers: %2zu, saturated: %10.0f items/s (p99: %10" PRId64 "ns), paced latency p50: %8" PRId64 "ns, p99: %8" PRId64 "ns, max: %9" PRId64 "ns\n",
+				 name, producer_count, saturated.items_per_second, saturated.p99_ns, paced.p50_ns, paced.p99_ns, paced.max_ns);
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t items_per_producer = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+	size_t max_producer_count = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : std::max(std::thread::hardware_concurrency(), 2U);
+
+	for (size_t producer_count = 1; producer_count <= max_producer_count; producer_count *= 2)
+	{
+		RunAndPrint<ov::Queue<Item>>("ov::Queue", producer_count, items_per_producer);
+		RunAndPrint<ov::RingQueue<Item>>("ov::RingQueue", producer_count, items_per_producer);
+	}
+
+	return 0;
+}
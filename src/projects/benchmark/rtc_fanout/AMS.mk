@@ -0,0 +1,17 @@
+LOCAL_PATH := $(call get_local_path)
+include $(DEFAULT_VARIABLES)
+
+LOCAL_STATIC_LIBRARIES := \
+	dtls_srtp \
+	rtp_rtcp \
+	ovlibrary
+
+LOCAL_LDFLAGS := -lpthread
+
+$(call add_pkg_config,openssl)
+$(call add_pkg_config,srt)
+$(call add_pkg_config,libsrtp2)
+
+LOCAL_TARGET := rtc_fanout_benchmark
+
+include $(BUILD_EXECUTABLE)
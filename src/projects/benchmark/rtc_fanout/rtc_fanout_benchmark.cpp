@@ -0,0 +1,262 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+// Measures the cost of sending an RTP packet of a stream to the WebRTC viewers
+//
+// Compares the two ways of sending a packet that is shared by the sessions of a stream, from RtpRtcp to DTLS:
+//   - Clone: RtcSession copies the RtpPacket for each viewer, and SRTP encrypts the copy in-place
+//     (the path before the packets were shared: RtpPacket copy -> SrtpAdapter::ProtectRtp(data) -> lower node)
+//   - Shared: SrtpTransport::SendData() copies the packet into the buffer of the session, and SRTP encrypts it there
+// The lower node of SRTP (DtlsTransport) is replaced by a node which only counts the data.
+// Reports, per packet per viewer:
+//   - The number of the allocations (operator new) and the allocated bytes
+//   - The elapsed time (including srtp_protect() of AES_CM_128_HMAC_SHA1_80)
+//
+// Usage: rtc_fanout_benchmark [viewers] [packets] [payload size]
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/dtls_srtp/srtp_adapter.h>
+#include <modules/dtls_srtp/srtp_transport.h>
+#include <openssl/rand.h>
+#include <openssl/srtp.h>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "../rtp_benchmark_utilities.h"
+
+namespace
+{
+	std::atomic<bool> g_is_counting{false};
+	std::atomic<uint64_t> g_allocation_count{0};
+	std::atomic<uint64_t> g_allocated_bytes{0};
+
+	void *Allocate(size_t size)
+	{
+		if (g_is_counting.load(std::memory_order_relaxed))
+		{
+			g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+			g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+		}
+
+		auto memory = std::malloc((size > 0) ? size : 1);
+
+		if (memory == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+
+		return memory;
+	}
+}  // namespace
+
+void *operator new(size_t size)
+{
+	return Allocate(size);
+}
+
+void *operator new[](size_t size)
+{
+	return Allocate(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+namespace
+{
+	// Replaces DtlsTransport, which passes the data to the socket
+	class SinkNode : public ov::Node
+	{
+	public:
+		SinkNode()
+			: ov::Node(NodeType::Dtls)
+		{
+		}
+
+		bool SendData(NodeType from_node, const std::shared_ptr<ov::Data> &data) override
+		{
+			_sent_bytes += data->GetLength();
+			return true;
+		}
+
+		bool OnDataReceived(NodeType from_node, const std::shared_ptr<const ov::Data> &data) override
+		{
+			return false;
+		}
+
+	protected:
+		uint64_t _sent_bytes = 0;
+	};
+
+	struct Viewer
+	{
+		std::shared_ptr<SinkNode> sink;
+
+		// Clone
+		std::shared_ptr<SrtpAdapter> srtp;
+		// Shared
+		std::shared_ptr<SrtpTransport> srtp_transport;
+	};
+
+	struct Result
+	{
+		double allocations = 0.0;
+		double allocated_bytes = 0.0;
+		double elapsed_ns = 0.0;
+	};
+
+	std::shared_ptr<ov::Data> CreateKey()
+	{
+		// AES_CM_128_HMAC_SHA1_80: 16 bytes of the master key + 14 bytes of the master salt
+		auto key = std::make_shared<ov::Data>(30);
+		key->SetLength(30);
+		::RAND_bytes(key->GetWritableDataAs<uint8_t>(), 30);
+
+		return key;
+	}
+
+	std::vector<Viewer> CreateViewers(size_t viewer_count)
+	{
+		std::vector<Viewer> viewers;
+
+		for (size_t index = 0; index < viewer_count; index++)
+		{
+			Viewer viewer;
+
+			viewer.sink = std::make_shared<SinkNode>();
+			viewer.sink->Start();
+
+			viewer.srtp = std::make_shared<SrtpAdapter>();
+			viewer.srtp_transport = std::make_shared<SrtpTransport>();
+
+			if ((viewer.srtp->SetKey(ssrc_any_outbound, SRTP_AES128_CM_SHA1_80, CreateKey()) == false) ||
+				(viewer.srtp_transport->SetKeyMeterial(SRTP_AES128_CM_SHA1_80, CreateKey(), CreateKey()) == false))
+			{
+				::fprintf(stderr, "Could not create the SRTP session\n");
+				::exit(1);
+			}
+
+			viewer.srtp_transport->RegisterLowerNode(viewer.sink);
+			viewer.srtp_transport->Start();
+
+			viewers.push_back(std::move(viewer));
+		}
+
+		return viewers;
+	}
+
+	void ReleaseViewers(std::vector<Viewer> &viewers)
+	{
+		for (auto &viewer : viewers)
+		{
+			viewer.srtp->Release();
+			viewer.srtp_transport->Stop();
+			viewer.sink->Stop();
+		}
+	}
+
+	// The SRTP sessions are created for each run, because libsrtp rejects the sequence numbers which are already sent
+	template <typename Tfunction>
+	Result Run(const std::vector<std::shared_ptr<RtpPacket>> &packets, size_t viewer_count, Tfunction function)
+	{
+		auto viewers = CreateViewers(viewer_count);
+
+		g_allocation_count = 0;
+		g_allocated_bytes = 0;
+		g_is_counting = true;
+
+		auto start_time = benchmark::GetNowNs();
+
+		for (const auto &packet : packets)
+		{
+			for (auto &viewer : viewers)
+			{
+				if (function(packet, viewer) == false)
+				{
+					::fprintf(stderr, "Could not send the packet\n");
+					::exit(1);
+				}
+			}
+		}
+
+		auto elapsed = benchmark::GetNowNs() - start_time;
+
+		g_is_counting = false;
+
+		ReleaseViewers(viewers);
+
+		double count = static_cast<double>(packets.size() * viewer_count);
+
+		Result result;
+
+		result.allocations = g_allocation_count / count;
+		result.allocated_bytes = g_allocated_bytes / count;
+		result.elapsed_ns = elapsed / count;
+
+		return result;
+	}
+
+	void Print(const char *name, const Result &result)
+	{
+		::printf("%-8s allocations: %6.2f (%8.1f bytes), elapsed: %8.1f ns per packet per viewer\n",
+				 name, result.allocations, result.allocated_bytes, result.elapsed_ns);
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t viewer_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100;
+	size_t packet_count = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 2000;
+	size_t payload_size = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 1200;
+
+	if (::srtp_init() != srtp_err_status_ok)
+	{
+		::fprintf(stderr, "Could not initialize libsrtp\n");
+		return 1;
+	}
+
+	auto packets = benchmark::CreateRtpPackets(packet_count, payload_size);
+
+	::printf("viewers: %zu, packets: %zu, packet size: %zu bytes\n", viewer_count, packet_count, packets[0]->GetData()->GetLength());
+
+	// RtcSession::SendOutgoingData() and SrtpTransport::SendData() before the packets were shared
+	Print("Clone", Run(packets, viewer_count, [](const std::shared_ptr<RtpPacket> &packet, Viewer &viewer) -> bool {
+			  auto copy_packet = std::make_shared<RtpPacket>(*packet);
+			  auto data = copy_packet->GetData();
+
+			  return viewer.srtp->ProtectRtp(data) && viewer.sink->SendData(NodeType::Srtp, data);
+		  }));
+
+	// RtpRtcp::SendOutgoingData() -> SrtpTransport::SendData()
+	Print("Shared", Run(packets, viewer_count, [](const std::shared_ptr<RtpPacket> &packet, Viewer &viewer) -> bool {
+			  return viewer.srtp_transport->SendData(NodeType::Rtp, packet->GetData());
+		  }));
+
+	return 0;
+}
@@ -0,0 +1,42 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+// Common functions of the benchmarks of the RTP/SRTP paths (link rtp_rtcp)
+#pragma once
+
+#include <modules/rtp_rtcp/rtp_packet.h>
+
+#include <memory>
+#include <vector>
+
+#include "benchmark_utilities.h"
+
+namespace benchmark
+{
+	// Creates <packet_count> video packets of a stream (consecutive sequence numbers from 0)
+	inline std::vector<std::shared_ptr<RtpPacket>> CreateRtpPackets(size_t packet_count, size_t payload_size)
+	{
+		std::vector<std::shared_ptr<RtpPacket>> packets;
+		std::vector<uint8_t> payload(payload_size, 0xAB);
+
+		for (size_t index = 0; index < packet_count; index++)
+		{
+			auto packet = std::make_shared<RtpPacket>();
+
+			packet->SetPayloadType(96);
+			packet->SetSsrc(0x12345678);
+			packet->SetSequenceNumber(static_cast<uint16_t>(index));
+			packet->SetTimestamp(static_cast<uint32_t>(index * 3000));
+			packet->SetPayload(payload.data(), payload.size());
+
+			packets.push_back(std::move(packet));
+		}
+
+		return packets;
+	}
+}  // namespace benchmark
@@ -0,0 +1,131 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+// Measures the cost of SrtpAdapter::ProtectRtp() for each SRTP profile negotiated by DTLS
+//
+// Encrypts the same RTP packets with a session of each profile, and reports the time per packet,
+// the throughput and the bytes added to each packet (authentication tag).
+// AEAD_AES_128_GCM and AEAD_AES_256_GCM need libsrtp built with the OpenSSL crypto backend.
+//
+// Usage: srtp_protect_benchmark [packets] [payload size...]
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/dtls_srtp/srtp_adapter.h>
+#include <openssl/rand.h>
+#include <openssl/srtp.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../rtp_benchmark_utilities.h"
+
+namespace
+{
+	struct Profile
+	{
+		const char *name;
+		uint64_t crypto_suite;
+		// Master key + master salt
+		size_t key_length;
+	};
+
+	const Profile PROFILES[] = {
+		{"SRTP_AES128_CM_SHA1_80", SRTP_AES128_CM_SHA1_80, 16 + 14},
+		{"SRTP_AES128_CM_SHA1_32", SRTP_AES128_CM_SHA1_32, 16 + 14},
+		{"SRTP_AEAD_AES_128_GCM", SRTP_AEAD_AES_128_GCM, 16 + 12},
+		{"SRTP_AEAD_AES_256_GCM", SRTP_AEAD_AES_256_GCM, 32 + 12},
+	};
+
+	// A session is created for each run, because libsrtp rejects the sequence numbers which are already sent
+	void Run(const Profile &profile, const std::vector<std::shared_ptr<RtpPacket>> &packets)
+	{
+		auto key = std::make_shared<ov::Data>(profile.key_length);
+		key->SetLength(profile.key_length);
+		::RAND_bytes(key->GetWritableDataAs<uint8_t>(), static_cast<int>(profile.key_length));
+
+		SrtpAdapter srtp;
+
+		if (srtp.SetKey(ssrc_any_outbound, profile.crypto_suite, key) == false)
+		{
+			::printf("%-24s not supported by libsrtp\n", profile.name);
+			return;
+		}
+
+		// Same as SrtpTransport::_protect_buffer
+		auto protect_buffer = std::make_shared<ov::Data>(RTP_DEFAULT_MAX_PACKET_SIZE + SRTP_MAX_TRAILER_LEN);
+		size_t total_bytes = 0;
+		size_t added_bytes = 0;
+
+		auto start_time = benchmark::GetNowNs();
+
+		for (const auto &packet : packets)
+		{
+			auto data = packet->GetData();
+
+			if (srtp.ProtectRtp(data, protect_buffer) == false)
+			{
+				::fprintf(stderr, "Could not protect the packet\n");
+				::exit(1);
+			}
+
+			total_bytes += data->GetLength();
+			added_bytes = protect_buffer->GetLength() - data->GetLength();
+		}
+
+		auto elapsed = benchmark::GetNowNs() - start_time;
+
+		srtp.Release();
+
+		::printf("%-24s %8.1f ns/packet, %8.1f MB/s, +%zu bytes/packet\n",
+				 profile.name,
+				 static_cast<double>(elapsed) / packets.size(),
+				 (total_bytes * 1000.0) / std::max<int64_t>(elapsed, 1),
+				 added_bytes);
+	}
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t packet_count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 50000;
+	std::vector<size_t> payload_sizes;
+
+	for (int index = 2; index < argc; index++)
+	{
+		payload_sizes.push_back(std::strtoul(argv[index], nullptr, 10));
+	}
+
+	if (payload_sizes.empty())
+	{
+		payload_sizes = {200, 1200};
+	}
+
+	// The sequence number must not wrap around in a session
+	packet_count = std::min<size_t>(packet_count, 65535);
+
+	if (::srtp_init() != srtp_err_status_ok)
+	{
+		::fprintf(stderr, "Could not initialize libsrtp\n");
+		return 1;
+	}
+
+	for (auto payload_size : payload_sizes)
+	{
+		auto packets = benchmark::CreateRtpPackets(packet_count, payload_size);
+
+		::printf("packets: %zu, packet size: %zu bytes\n", packet_count, packets[0]->GetData()->GetLength());
+
+		for (const auto &profile : PROFILES)
+		{
+			Run(profile, packets);
+		}
+	}
+
+	return 0;
+}
@@ -18,11 +18,13 @@ namespace cfg
 			ov::String _cert_path;
 			ov::String _key_path;
 			ov::String _chain_cert_path;
+			bool _kernel_tls = false;
 
 		public:
 			CFG_DECLARE_REF_GETTER_OF(GetCertPath, _cert_path)
 			CFG_DECLARE_REF_GETTER_OF(GetKeyPath, _key_path)
 			CFG_DECLARE_REF_GETTER_OF(GetChainCertPath, _chain_cert_path)
+			CFG_DECLARE_REF_GETTER_OF(IsKernelTlsEnabled, _kernel_tls)
 
 		protected:
 			void MakeList() override
@@ -30,6 +32,8 @@ namespace cfg
 				Register<ResolvePath>("CertPath", &_cert_path);
 				Register<ResolvePath>("KeyPath", &_key_path);
 				Register<Optional, ResolvePath>("ChainCertPath", &_chain_cert_path);
+				// Offloads the encryption of the records to the kernel after TLS handshake (Linux only)
+				Register<Optional>("KernelTLS", &_kernel_tls);
 			}
 		};
 	}  // namespace cmn
@@ -24,11 +24,17 @@ namespace cfg
 					ov::String _name;
 					ov::String _output_stream_name;
 					Encodes _encodes;
+					// Encodes the output stream only while it is played
+					bool _on_demand = false;
+					// The encoding is paused if nobody plays the output stream for this time (milliseconds)
+					int _on_demand_idle_timeout = 30 * 1000;
 
 				public:
 					CFG_DECLARE_REF_GETTER_OF(GetName, _name)
 					CFG_DECLARE_REF_GETTER_OF(GetOutputStreamName, _output_stream_name)
 					CFG_DECLARE_REF_GETTER_OF(GetEncodes, _encodes)
+					CFG_DECLARE_REF_GETTER_OF(IsOnDemand, _on_demand)
+					CFG_DECLARE_REF_GETTER_OF(GetOnDemandIdleTimeout, _on_demand_idle_timeout)
 
 				protected:
 					void MakeList() override
@@ -36,6 +42,8 @@ namespace cfg
 						Register("Name", &_name);
 						Register("OutputStreamName", &_output_stream_name);
 						Register<Optional>("Encodes", &_encodes);
+						Register<Optional>("OnDemand", &_on_demand);
+						Register<Optional>("OnDemandIdleTimeout", &_on_demand_idle_timeout);
 					}
 				};
 			}  // namespace oprf
@@ -24,6 +24,18 @@ namespace cfg
 					{
 						return PublisherType::Ovt;
 					}
+
+					CFG_DECLARE_REF_GETTER_OF(IsGopCacheEnabled, _gop_cache)
+
+				protected:
+					void MakeList() override
+					{
+						Publisher::MakeList();
+
+						Register<Optional>("GopCache", &_gop_cache);
+					}
+
+					bool _gop_cache = false;
 				};
 			}  // namespace pub
 		}	   // namespace app
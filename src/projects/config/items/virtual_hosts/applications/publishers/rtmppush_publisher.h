@@ -26,6 +26,7 @@ namespace cfg
 					}
 
 					CFG_DECLARE_REF_GETTER_OF(GetCrossDomains, _cross_domains.GetUrls())
+					CFG_DECLARE_REF_GETTER_OF(IsGopCacheEnabled, _gop_cache)
 
 				protected:
 					void MakeList() override
@@ -33,9 +34,11 @@ namespace cfg
 						Publisher::MakeList();
 
 						Register<Optional>("CrossDomains", &_cross_domains);
+						Register<Optional>("GopCache", &_gop_cache);
 					}
 
 					cmn::CrossDomains _cross_domains;
+					bool _gop_cache = false;
 				};
 			}  // namespace pub
 		}	   // namespace app
@@ -0,0 +1,45 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+namespace cfg
+{
+	namespace vhost
+	{
+		namespace app
+		{
+			namespace pub
+			{
+				// Makes the thumbnail from the last key frame of the video when it is requested
+				struct ThumbnailOnDemand : public Item
+				{
+				protected:
+					// Size of the thumbnail (If one of them is 0, it is calculated by the aspect ratio. If both are 0, the size of the video is used)
+					int _width = 0;
+					int _height = 0;
+					// The thumbnail is reused for this time (milliseconds)
+					int _cache_ttl = 1000;
+
+				public:
+					CFG_DECLARE_REF_GETTER_OF(GetWidth, _width)
+					CFG_DECLARE_REF_GETTER_OF(GetHeight, _height)
+					CFG_DECLARE_REF_GETTER_OF(GetCacheTtl, _cache_ttl)
+
+				protected:
+					void MakeList() override
+					{
+						Register<Optional>("Width", &_width);
+						Register<Optional>("Height", &_height);
+						Register<Optional>("CacheTTL", &_cache_ttl);
+					}
+				};
+			}  // namespace pub
+		}	   // namespace app
+	}		   // namespace vhost
+}  // namespace cfg
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "publisher.h"
+#include "thumbnail_on_demand.h"
 
 namespace cfg
 {
@@ -27,6 +28,7 @@ namespace cfg
 
 					CFG_DECLARE_REF_GETTER_OF(GetCrossDomainList, _cross_domains.GetUrls())
 					CFG_DECLARE_REF_GETTER_OF(GetCrossDomains, _cross_domains)
+					CFG_DECLARE_REF_GETTER_OF(GetOnDemand, _on_demand)
 
 				protected:
 					void MakeList() override
@@ -34,9 +36,11 @@ namespace cfg
 						Publisher::MakeList();
 
 						Register<Optional>("CrossDomains", &_cross_domains);
+						Register<Optional>("OnDemand", &_on_demand);
 					}
 
 					cmn::CrossDomains _cross_domains;
+					ThumbnailOnDemand _on_demand;
 				};
 			}  // namespace pub
 		}	   // namespace app
@@ -28,6 +28,11 @@ namespace cfg
 					CFG_DECLARE_REF_GETTER_OF(GetTimeout, _timeout)
 					CFG_DECLARE_REF_GETTER_OF(IsRtxEnabled, _rtx)
 					CFG_DECLARE_REF_GETTER_OF(IsUlpfecEnalbed, _ulpfec)
+					CFG_DECLARE_REF_GETTER_OF(IsGopCacheEnabled, _gop_cache)
+					CFG_DECLARE_REF_GETTER_OF(IsBandwidthEstimationEnabled, _bandwidth_estimation)
+					CFG_DECLARE_REF_GETTER_OF(IsPacingEnabled, _pacing)
+					CFG_DECLARE_REF_GETTER_OF(GetPacingMaxDelay, _pacing_max_delay)
+					CFG_DECLARE_REF_GETTER_OF(IsPacingTxTimeEnabled, _pacing_txtime)
 
 				protected:
 					void MakeList() override
@@ -37,11 +42,22 @@ namespace cfg
 						Register<Optional>("Timeout", &_timeout);
 						Register<Optional>("Rtx", &_rtx);
 						Register<Optional>("Ulpfec", &_ulpfec);
+						Register<Optional>("GopCache", &_gop_cache);
+						Register<Optional>("BandwidthEstimation", &_bandwidth_estimation);
+						Register<Optional>("Pacing", &_pacing);
+						Register<Optional>("PacingMaxDelay", &_pacing_max_delay);
+						Register<Optional>("PacingTxTime", &_pacing_txtime);
 					}
 
 					int _timeout = 30000;
 					bool _rtx = true;
 					bool _ulpfec = true;
+					bool _gop_cache = false;
+					bool _bandwidth_estimation = false;
+					bool _pacing = false;
+					// Unit: milliseconds
+					int _pacing_max_delay = 40;
+					bool _pacing_txtime = false;
 				};
 			}  // namespace pub
 		}	   // namespace app
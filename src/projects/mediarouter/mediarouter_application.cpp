@@ -44,11 +44,11 @@ MediaRouteApplication::MediaRouteApplication(const info::Application &applicatio
 
 	for (uint32_t worker_id = 0; worker_id < _max_worker_thread_count; worker_id++)
 	{
-		_inbound_stream_indicator.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
+		_inbound_stream_indicator.push_back(std::make_shared<ov::RingQueue<std::shared_ptr<MediaRouteStream>>>(
 			ov::String::FormatString("%s - Mediarouter inbound indicator (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count),
 			100));
 
-		_outbound_stream_indicator.push_back(std::make_shared<ov::Queue<std::shared_ptr<MediaRouteStream>>>(
+		_outbound_stream_indicator.push_back(std::make_shared<ov::RingQueue<std::shared_ptr<MediaRouteStream>>>(
 			ov::String::FormatString("%s - Mediarouter outbound indicator (%d/%d)", _application_info.GetName().CStr(), worker_id, _max_worker_thread_count),
 			100));
 	}
@@ -139,6 +139,8 @@ bool MediaRouteApplication::Stop()
 
 	_connectors.clear();
 	_observers.clear();
+	_inbound_observers.clear();
+	_outbound_observers.clear();
 
 	logti("Mediarouter application. id(%u), app(%s) has been stopped", _application_info.GetId(), _application_info.GetName().CStr());
 
@@ -200,6 +202,7 @@ bool MediaRouteApplication::RegisterObserverApp(
 	}
 
 	_observers.push_back(app_obsrv);
+	UpdateObserverList();
 
 	logtd("Registered observer. %p app(%s) type(%d)", app_obsrv.get(), _application_info.GetName().CStr(), app_obsrv->GetObserverType());
 
@@ -223,12 +226,38 @@ bool MediaRouteApplication::UnregisterObserverApp(
 	}
 
 	_observers.erase(position);
+	UpdateObserverList();
 
 	logti("Unregistered observer. %p app(%s) type(%d)", app_obsrv.get(), _application_info.GetName().CStr(), app_obsrv->GetObserverType());
 
 	return true;
 }
 
+void MediaRouteApplication::UpdateObserverList()
+{
+	_inbound_observers.clear();
+	_outbound_observers.clear();
+
+	for (const auto &observer : _observers)
+	{
+		switch (observer->GetObserverType())
+		{
+			// Packets of the inbound streams are delivered to the transcoder
+			case MediaRouteApplicationObserver::ObserverType::Transcoder:
+				_inbound_observers.push_back(observer);
+				break;
+
+			// Packets of the outbound streams are delivered to the publishers
+			case MediaRouteApplicationObserver::ObserverType::Publisher:
+				_outbound_observers.push_back(observer);
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
 // OnStreamCreated is called from Provider, Transcoder, Relay
 bool MediaRouteApplication::OnStreamCreated(
 	const std::shared_ptr<MediaRouteApplicationConnector> &app_conn,
@@ -544,7 +573,7 @@ bool MediaRouteApplication::OnPacketReceived(
 
 			stream->Push(packet);
 
-			_inbound_stream_indicator[stream_info->GetId() % _max_worker_thread_count]->Enqueue(stream);
+			IndicateStream(_inbound_stream_indicator[stream_info->GetId() % _max_worker_thread_count], stream);
 		}
 		break;
 
@@ -559,7 +588,7 @@ bool MediaRouteApplication::OnPacketReceived(
 
 			stream->Push(packet);
 
-			_outbound_stream_indicator[stream_info->GetId() % _max_worker_thread_count]->Enqueue(stream);
+			IndicateStream(_outbound_stream_indicator[stream_info->GetId() % _max_worker_thread_count], stream);
 		}
 		break;
 		default: {
@@ -645,25 +674,32 @@ bool MediaRouteApplication::IsExistingInboundStream(ov::String stream_name)
 	return false;
 }
 
-void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
+void MediaRouteApplication::IndicateStream(const std::shared_ptr<ov::RingQueue<std::shared_ptr<MediaRouteStream>>> &indicator, const std::shared_ptr<MediaRouteStream> &stream)
 {
-	logtd("Created Inbound worker thread #%d", worker_id);
-
-	while (!_kill_flag)
+	// If the stream is already queued, the worker will deliver this packet together with the others
+	if (stream->MarkIndicated() == false)
 	{
-		auto msg = _inbound_stream_indicator[worker_id]->Dequeue(ov::Infinite);
-		if (msg.has_value() == false)
-		{
-			// It may be called due to a normal stop signal.
-			continue;
-		}
-		auto stream = msg.value();
-		if (stream == nullptr)
-		{
-			logtw("Not found stream info");
-			continue;
-		}
+		return;
+	}
+
+	indicator->Enqueue(stream);
+}
+
+void MediaRouteApplication::DeliverPackets(
+	const std::shared_ptr<ov::RingQueue<std::shared_ptr<MediaRouteStream>>> &indicator,
+	std::shared_ptr<MediaRouteStream> &stream,
+	const std::vector<std::shared_ptr<MediaRouteApplicationObserver>> &observers)
+{
+	// Packets pushed after this point will indicate the stream again
+	stream->ClearIndicated();
 
+	// Get Stream Info
+	auto stream_info = stream->GetStream();
+
+	// Pop() may return nullptr even if the queue is not empty (e.g. the packet is stashed),
+	// so check the queue instead of the result
+	for (int count = 0; (count < MEDIA_ROUTE_MAX_PACKETS_PER_PASS) && (stream->IsPacketQueueEmpty() == false); count++)
+	{
 		// StreamDeliver media packet to Publiser(observer) of Transcoder(observer)
 		auto media_packet = stream->Pop();
 		if (media_packet == nullptr)
@@ -671,77 +707,100 @@ void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
 			continue;
 		}
 
-		// When the inbound stream is finished parsing track information,
+		// When the stream is finished parsing track information,
 		// Notify the Observer that the stream is parsed
 		if (stream->IsNotifyStreamPrepared() == false && stream->IsParseTrackAll() == true)
 		{
 			NotifyStreamPrepared(stream);
 		}
 
-		std::shared_lock<std::shared_mutex> lock(_observers_lock);
-		for (const auto &observer : _observers)
+		for (const auto &observer : observers)
 		{
-			auto observer_type = observer->GetObserverType();
-
-			if (observer_type == MediaRouteApplicationObserver::ObserverType::Transcoder)
-			{
-				// Get Stream Info
-				auto stream_info = stream->GetStream();
-
-				// observer->OnSendFrame(stream_info, std::move(media_packet->ClonePacket()));
-				observer->OnSendFrame(stream_info, media_packet);
-			}
+			observer->OnSendFrame(stream_info, media_packet);
 		}
 	}
 
-	logtd("Inbound worker thread #%d has beed stopped", worker_id);
+	// The remaining packets are delivered after the other streams of this worker
+	if (stream->IsPacketQueueEmpty() == false)
+	{
+		IndicateStream(indicator, stream);
+	}
 }
 
-void MediaRouteApplication::OutboundWorkerThread(uint32_t worker_id)
+void MediaRouteApplication::InboundWorkerThread(uint32_t worker_id)
 {
-	logtd("Created outbound worker thread #%d", worker_id);
+	logtd("Created Inbound worker thread #%d", worker_id);
+
+	auto &indicator = _inbound_stream_indicator[worker_id];
+	std::vector<std::shared_ptr<MediaRouteStream>> streams;
+	std::vector<std::shared_ptr<MediaRouteApplicationObserver>> observers;
 
 	while (!_kill_flag)
 	{
-		auto msg = _outbound_stream_indicator[worker_id]->Dequeue(ov::Infinite);
-		if (msg.has_value() == false)
+		streams.clear();
+
+		if (indicator->DequeueBatch(streams, MEDIA_ROUTE_INDICATOR_BATCH_SIZE, ov::Infinite) == 0)
 		{
 			// It may be called due to a normal stop signal.
 			continue;
 		}
-		auto stream = msg.value();
-		if (stream == nullptr)
+
+		// Take the observers once per batch, so the lock is not acquired for every packet.
+		// (The lock must not be held while delivering, because the observers may call back into this application)
 		{
-			logtw("Not found stream info");
-			continue;
+			std::shared_lock<std::shared_mutex> lock(_observers_lock);
+			observers = _inbound_observers;
 		}
 
-		// StreamDeliver media packet to Publiser(observer) of Transcoder(observer)
-		auto media_packet = stream->Pop();
-		if (media_packet == nullptr)
+		for (auto &stream : streams)
 		{
-			continue;
+			if (stream == nullptr)
+			{
+				logtw("Not found stream info");
+				continue;
+			}
+
+			DeliverPackets(indicator, stream, observers);
 		}
+	}
 
-		
+	logtd("Inbound worker thread #%d has beed stopped", worker_id);
+}
 
-		if (stream->IsNotifyStreamPrepared() == false && stream->IsParseTrackAll() == true)
+void MediaRouteApplication::OutboundWorkerThread(uint32_t worker_id)
+{
+	logtd("Created outbound worker thread #%d", worker_id);
+
+	auto &indicator = _outbound_stream_indicator[worker_id];
+	std::vector<std::shared_ptr<MediaRouteStream>> streams;
+	std::vector<std::shared_ptr<MediaRouteApplicationObserver>> observers;
+
+	while (!_kill_flag)
+	{
+		streams.clear();
+
+		if (indicator->DequeueBatch(streams, MEDIA_ROUTE_INDICATOR_BATCH_SIZE, ov::Infinite) == 0)
 		{
-			NotifyStreamPrepared(stream);
+			// It may be called due to a normal stop signal.
+			continue;
 		}
 
-		std::shared_lock<std::shared_mutex> lock(_observers_lock);
-		for (const auto &observer : _observers)
+		// Take the observers once per batch, so the lock is not acquired for every packet.
+		// (The lock must not be held while delivering, because the observers may call back into this application)
 		{
-			auto observer_type = observer->GetObserverType();
+			std::shared_lock<std::shared_mutex> lock(_observers_lock);
+			observers = _outbound_observers;
+		}
 
-			if (observer_type == MediaRouteApplicationObserver::ObserverType::Publisher)
+		for (auto &stream : streams)
+		{
+			if (stream == nullptr)
 			{
-				// Get Stream Info
-				auto stream_info = stream->GetStream();
-
-				observer->OnSendFrame(stream_info, media_packet);
+				logtw("Not found stream info");
+				continue;
 			}
+
+			DeliverPackets(indicator, stream, observers);
 		}
 	}
 
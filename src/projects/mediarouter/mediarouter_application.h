@@ -21,6 +21,11 @@
 #include "base/mediarouter/media_route_interface.h"
 #include "mediarouter_stream.h"
 
+// Maximum number of streams that a worker takes from the indicator at a time
+#define MEDIA_ROUTE_INDICATOR_BATCH_SIZE 64
+// Maximum number of packets of a stream delivered in one pass, so that the other streams of the worker are not delayed
+#define MEDIA_ROUTE_MAX_PACKETS_PER_PASS 256
+
 class ApplicationInfo;
 class Stream;
 class RelayServer;
@@ -115,6 +120,9 @@ private:
 
 	// Information of Observer instance
 	std::vector<std::shared_ptr<MediaRouteApplicationObserver>> _observers;
+	// Observers that receive the packets of the inbound/outbound streams (rebuilt when _observers is changed)
+	std::vector<std::shared_ptr<MediaRouteApplicationObserver>> _inbound_observers;
+	std::vector<std::shared_ptr<MediaRouteApplicationObserver>> _outbound_observers;
 	std::shared_mutex _observers_lock;
 
 	// Information of MediaStream instance
@@ -131,6 +139,17 @@ private:
 	void InboundWorkerThread(uint32_t worker_id);
 	void OutboundWorkerThread(uint32_t worker_id);
 
+	void IndicateStream(const std::shared_ptr<ov::RingQueue<std::shared_ptr<MediaRouteStream>>> &indicator, const std::shared_ptr<MediaRouteStream> &stream);
+
+	// Delivers the pending packets of the stream to the observers
+	void DeliverPackets(
+		const std::shared_ptr<ov::RingQueue<std::shared_ptr<MediaRouteStream>>> &indicator,
+		std::shared_ptr<MediaRouteStream> &stream,
+		const std::vector<std::shared_ptr<MediaRouteApplicationObserver>> &observers);
+
+	// Must be called while _observers_lock is locked
+	void UpdateObserverList();
+
 	volatile bool _kill_flag;
 	std::vector<std::thread> _inbound_threads;
 	std::vector<std::thread> _outbound_threads;
@@ -138,6 +157,6 @@ private:
 	uint32_t _max_worker_thread_count;
 
 private:
-	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _inbound_stream_indicator;
-	std::vector<std::shared_ptr<ov::Queue<std::shared_ptr<MediaRouteStream>>>> _outbound_stream_indicator;
+	std::vector<std::shared_ptr<ov::RingQueue<std::shared_ptr<MediaRouteStream>>>> _inbound_stream_indicator;
+	std::vector<std::shared_ptr<ov::RingQueue<std::shared_ptr<MediaRouteStream>>>> _outbound_stream_indicator;
 };
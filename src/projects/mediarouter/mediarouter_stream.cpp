@@ -958,22 +958,31 @@ void MediaRouteStream::Push(std::shared_ptr<MediaPacket> media_packet)
 	_packets_queue.Enqueue(std::move(media_packet));
 }
 
+bool MediaRouteStream::IsPacketQueueEmpty()
+{
+	return _packets_queue.IsEmpty();
+}
+
+bool MediaRouteStream::MarkIndicated()
+{
+	return (_is_indicated.exchange(true) == false);
+}
+
+void MediaRouteStream::ClearIndicated()
+{
+	_is_indicated = false;
+}
+
 std::shared_ptr<MediaPacket> MediaRouteStream::Pop()
 {
 	// Get Media Packet
-	if (_packets_queue.IsEmpty())
-	{
-		return nullptr;
-	}
+	std::shared_ptr<MediaPacket> media_packet;
 
-	auto media_packet_ref = _packets_queue.Dequeue();
-	if (media_packet_ref.has_value() == false)
+	if (_packets_queue.TryDequeue(media_packet) == false)
 	{
 		return nullptr;
 	}
 
-	auto &media_packet = media_packet_ref.value();
-
 	////////////////////////////////////////////////////////////////////////////////////
 	// [ Calculating Packet Timestamp, Duration]
 
@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -49,6 +50,12 @@ public:
 		std::shared_ptr<MediaPacket> &media_packet);
 
 	std::shared_ptr<MediaPacket> Pop();
+	bool IsPacketQueueEmpty();
+
+	// A stream is queued to the indicator of the worker only once until the worker starts to process it.
+	// Returns true if the caller has to queue the stream to the indicator.
+	bool MarkIndicated();
+	void ClearIndicated();
 
 	// Query original stream information
 	std::shared_ptr<info::Stream> GetStream();
@@ -120,7 +127,10 @@ private:
 	std::map<MediaTrackId, std::shared_ptr<MediaPacket>> _media_packet_stash;
 
 	// Packets queue
-	ov::Queue<std::shared_ptr<MediaPacket>> _packets_queue;
+	ov::RingQueue<std::shared_ptr<MediaPacket>> _packets_queue;
+
+	// Whether the stream is queued to the indicator of the worker
+	std::atomic<bool> _is_indicated{false};
 
 	// Store the correction values in case of sudden change in PTS.
 	// If the PTS suddenly increases, the filter behaves incorrectly.
@@ -3,6 +3,7 @@
 
 #include "h264_decoder_configuration_record.h"
 #include "h264_parser.h"
+#include "../nalu/nal_unit_scanner.h"
 
 #define OV_LOG_TAG "H264Converter"
 
@@ -131,55 +132,6 @@ bool H264Converter::ConvertAvccToAnnexb(cmn::PacketType type, const std::shared_
 	return true;
 }
 
-static inline int GetStartPatternSize(const void *data, size_t length, int first_pattern_size)
-{
-	if (data != nullptr)
-	{
-		auto buffer = static_cast<const uint8_t *>(data);
-
-		if (first_pattern_size > 0)
-		{
-			if ((buffer[0] == 0x00) && (buffer[1] == 0x00))
-			{
-				if (
-					(first_pattern_size == 4) &&
-					((length >= 4) && (buffer[2] == 0x00) && (buffer[3] == 0x01)))
-				{
-					// 0x00 0x00 0x00 0x01 pattern
-					return 4;
-				}
-				else if (
-					(first_pattern_size == 3) &&
-					((length >= 3) && (buffer[2] == 0x01)))
-				{
-					// 0x00 0x00 0x01 pattern
-					return 3;
-				}
-			}
-
-			// pattern_size must be the same with the first_pattern_size
-			return -1;
-		}
-		else
-		{
-			// probe mode
-
-			if ((length >= 4) && ((buffer[0] == 0x00) && (buffer[1] == 0x00) && (buffer[2] == 0x00) && (buffer[3] == 0x01)))
-			{
-				// 0x00 0x00 0x00 0x01 pattern
-				return 4;
-			}
-			if ((length >= 3) && ((buffer[0] == 0x00) && (buffer[1] == 0x00) && (buffer[2] == 0x01)))
-			{
-				// 0x00 0x00 0x01 pattern
-				return 3;
-			}
-		}
-	}
-
-	return -1;
-}
-
 #if 0
 static bool ExtractSpsPpsOffset(const std::shared_ptr<const ov::Data> &data, const std::vector<size_t> &offset_list, const std::vector<size_t> &pattern_size_list,
 								const std::shared_ptr<ov::Data> &sps, const std::shared_ptr<ov::Data> &pps)
@@ -261,60 +213,29 @@ static bool ExtractSpsPpsOffset(const std::shared_ptr<const ov::Data> &data, con
 
 std::shared_ptr<const ov::Data> H264Converter::ConvertAnnexbToAvcc(const std::shared_ptr<const ov::Data> &data)
 {
-	// size_t total_pattern_length = 0;
-
 	auto buffer = data->GetDataAs<uint8_t>();
-	size_t remained = data->GetLength();
-	off_t offset = 0;
-	off_t last_offset = 0;
 
-	auto avcc_data = std::make_shared<ov::Data>();
-	ov::ByteStream byte_stream(avcc_data);
-
-	int first_pattern_size = 0;
-
-	// This code assumes that (NALULengthSizeMinusOne == 3)
-	while (remained > 0)
+	std::vector<NalUnitView> nal_units;
+	if ((NalUnitScanner::Scan(buffer, data->GetLength(), nal_units) == false) && (data->GetLength() > 0))
 	{
-		if (*buffer == 0x00)
-		{
-			auto pattern_size = GetStartPatternSize(buffer, remained, first_pattern_size);
-
-			if (pattern_size > 0)
-			{
-				if (last_offset < offset)
-				{
-					auto nalu = data->Subdata(last_offset, offset - last_offset);
-
-					byte_stream.WriteBE32(nalu->GetLength());
-					byte_stream.Write(nalu);
-
-					last_offset = offset;
-				}
+		// There is no start code - regard the whole data as a NAL unit
+		NalUnitView view;
+		view.length = data->GetLength();
+		nal_units.push_back(view);
+	}
 
-				buffer += pattern_size;
-				offset += pattern_size;
-				last_offset += pattern_size;
-				remained -= pattern_size;
+	auto avcc_data = std::make_shared<ov::Data>();
 
-				continue;
-			}
-		}
+	// Each start code (3 or 4 bytes) is replaced with 4 bytes length field
+	avcc_data->Reserve(data->GetLength() + nal_units.size());
 
-		buffer++;
-		offset++;
-		remained--;
-	}
+	ov::ByteStream byte_stream(avcc_data);
 
-	if (last_offset < offset)
+	// This code assumes that (NALULengthSizeMinusOne == 3)
+	for (const auto &nal_unit : nal_units)
 	{
-		// Append remained data
-		auto nalu = data->Subdata(last_offset, offset - last_offset);
-
-		byte_stream.WriteBE32(nalu->GetLength());
-		byte_stream.Write(nalu);
-
-		last_offset = offset;
+		byte_stream.WriteBE32(nal_unit.length);
+		byte_stream.Write(buffer + nal_unit.offset, nal_unit.length);
 	}
 
 	return avcc_data;
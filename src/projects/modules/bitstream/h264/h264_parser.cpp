@@ -1,54 +1,44 @@
 #include "h264_parser.h"
 
+#include <modules/bitstream/nalu/nal_unit_scanner.h>
+
 bool H264Parser::CheckKeyframe(const uint8_t *bitstream, size_t length)
 {
-    size_t offset = 0;
-    while(offset < length)
-    {
-        size_t remaining = length - offset;
-        const uint8_t* data = bitstream + offset;
-
-        if((remaining >= 3 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x01) || 
-            (remaining >= 4 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x00 && data[3] == 0x01))
-        {
-            if(data[2] == 0x01)
-            {
-                offset += 3;
-            }
-            else
-            {
-                offset += 4;
-            }
-
-			if(length - offset > H264_NAL_UNIT_HEADER_SIZE)
-			{
-				H264NalUnitHeader header;
-				ParseNalUnitHeader(bitstream+offset, H264_NAL_UNIT_HEADER_SIZE, header);
+	uint8_t start_code_size = 0;
+	size_t offset = NalUnitScanner::FindStartCode(bitstream, length, 0, &start_code_size);
+
+	while (offset < length)
+	{
+		offset += start_code_size;
 
-				if(header.GetNalUnitType() == H264NalUnitType::IdrSlice ||
+		if (length - offset > H264_NAL_UNIT_HEADER_SIZE)
+		{
+			H264NalUnitHeader header;
+			ParseNalUnitHeader(bitstream + offset, H264_NAL_UNIT_HEADER_SIZE, header);
+
+			if (header.GetNalUnitType() == H264NalUnitType::IdrSlice ||
 				header.GetNalUnitType() == H264NalUnitType::Sps)
-				{
-					return true;
-				}
+			{
+				return true;
 			}
 		}
-		else
-		{
-			offset ++;
-		}
+
+		offset = NalUnitScanner::FindStartCode(bitstream, length, offset, &start_code_size);
 	}
+
 	return false;
 }
 
 bool H264Parser::ParseNalUnitHeader(const uint8_t *nalu, size_t length, H264NalUnitHeader &header)
 {
-    NalUnitBitstreamParser parser(nalu, length);
-
 	if(length < H264_NAL_UNIT_HEADER_SIZE)
 	{
 		return false;
 	}
 
+	// Only the header is needed, so don't copy the whole NAL unit
+	NalUnitBitstreamParser parser(nalu, H264_NAL_UNIT_HEADER_SIZE);
+
     return ParseNalUnitHeader(parser, header);
 }
 
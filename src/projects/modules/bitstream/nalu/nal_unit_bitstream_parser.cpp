@@ -1,5 +1,7 @@
 #include "nal_unit_bitstream_parser.h"
 
+#include "nal_unit_scanner.h"
+
 NalUnitBitstreamParser::NalUnitBitstreamParser(const uint8_t *bitstream, size_t length)
 	: BitReader(nullptr, 0)
 {
@@ -18,19 +20,20 @@ NalUnitBitstreamParser::NalUnitBitstreamParser(const uint8_t *bitstream, size_t
                 rbsp_byte[ NumBytesInRBSP++ ] All b(8)
         }
     */
-    for (size_t original_bitstream_offset = 0; original_bitstream_offset < length;)
-    {
-        if (original_bitstream_offset < length + 2 && bitstream[original_bitstream_offset] == 0x00 && bitstream[original_bitstream_offset + 1] == 0x00 && bitstream[original_bitstream_offset + 2] == 0x03)
-        {
-            _bitstream.emplace_back(bitstream[original_bitstream_offset++]);
-            _bitstream.emplace_back(bitstream[original_bitstream_offset++]);
-            original_bitstream_offset++;
-        }
-        else
-        {
-            _bitstream.emplace_back(bitstream[original_bitstream_offset++]);
-        }
-    }
+	_bitstream.reserve(length);
+
+	// Copy the bytes between emulation_prevention_three_bytes at once
+	size_t offset = 0;
+
+	while (offset < length)
+	{
+		auto epb_offset = NalUnitScanner::FindEmulationPreventionByte(bitstream, length, offset);
+
+		_bitstream.insert(_bitstream.end(), bitstream + offset, bitstream + epb_offset);
+
+		// Skip emulation_prevention_three_byte
+		offset = epb_offset + 1;
+	}
     
 	_buffer = _bitstream.data();
 	_capacity = _bitstream.size();
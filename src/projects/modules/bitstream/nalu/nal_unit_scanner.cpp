@@ -0,0 +1,207 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "nal_unit_scanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#	include <immintrin.h>
+#	define NAL_UNIT_SCANNER_USE_X86_SIMD 1
+#else
+#	define NAL_UNIT_SCANNER_USE_X86_SIMD 0
+#endif
+
+using FindPatternFunction = size_t (*)(const uint8_t *bitstream, size_t length, size_t offset, uint8_t last_byte);
+
+// Finds the first (0x00 0x00 <last_byte>) pattern in [offset, length)
+static size_t FindPatternScalar(const uint8_t *bitstream, size_t length, size_t offset, uint8_t last_byte)
+{
+	size_t index = offset;
+
+	while ((index + 2) < length)
+	{
+		uint8_t third = bitstream[index + 2];
+
+		if (third == last_byte)
+		{
+			if ((bitstream[index] == 0x00) && (bitstream[index + 1] == 0x00))
+			{
+				return index;
+			}
+
+			index += 3;
+		}
+		else if (third != 0x00)
+		{
+			// The pattern can't start at index, index + 1 and index + 2
+			index += 3;
+		}
+		else
+		{
+			index++;
+		}
+	}
+
+	return length;
+}
+
+#if NAL_UNIT_SCANNER_USE_X86_SIMD
+static size_t FindPatternSse2(const uint8_t *bitstream, size_t length, size_t offset, uint8_t last_byte)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i last = _mm_set1_epi8(static_cast<char>(last_byte));
+
+	size_t index = offset;
+
+	// Compares 16 candidates at a time: bitstream[index + n], [index + n + 1] and [index + n + 2]
+	while ((index + 16 + 2) <= length)
+	{
+		auto first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + index));
+		auto second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + index + 1));
+		auto third = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bitstream + index + 2));
+
+		auto matched = _mm_and_si128(
+			_mm_and_si128(_mm_cmpeq_epi8(first, zero), _mm_cmpeq_epi8(second, zero)),
+			_mm_cmpeq_epi8(third, last));
+
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matched));
+
+		if (mask != 0)
+		{
+			return index + __builtin_ctz(mask);
+		}
+
+		index += 16;
+	}
+
+	return FindPatternScalar(bitstream, length, index, last_byte);
+}
+
+__attribute__((target("avx2"))) static size_t FindPatternAvx2(const uint8_t *bitstream, size_t length, size_t offset, uint8_t last_byte)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i last = _mm256_set1_epi8(static_cast<char>(last_byte));
+
+	size_t index = offset;
+
+	while ((index + 32 + 2) <= length)
+	{
+		auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + index));
+		auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + index + 1));
+		auto third = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitstream + index + 2));
+
+		auto matched = _mm256_and_si256(
+			_mm256_and_si256(_mm256_cmpeq_epi8(first, zero), _mm256_cmpeq_epi8(second, zero)),
+			_mm256_cmpeq_epi8(third, last));
+
+		auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matched));
+
+		if (mask != 0)
+		{
+			return index + __builtin_ctz(mask);
+		}
+
+		index += 32;
+	}
+
+	return FindPatternSse2(bitstream, length, index, last_byte);
+}
+#endif	// NAL_UNIT_SCANNER_USE_X86_SIMD
+
+static FindPatternFunction GetFindPatternFunction()
+{
+	static const FindPatternFunction function = []() -> FindPatternFunction {
+#if NAL_UNIT_SCANNER_USE_X86_SIMD
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return FindPatternAvx2;
+		}
+
+		if (__builtin_cpu_supports("sse2"))
+		{
+			return FindPatternSse2;
+		}
+#endif	// NAL_UNIT_SCANNER_USE_X86_SIMD
+
+		return FindPatternScalar;
+	}();
+
+	return function;
+}
+
+size_t NalUnitScanner::FindStartCode(const uint8_t *bitstream, size_t length, size_t offset, uint8_t *start_code_size)
+{
+	if ((bitstream == nullptr) || (offset >= length))
+	{
+		return length;
+	}
+
+	auto position = GetFindPatternFunction()(bitstream, length, offset, 0x01);
+	uint8_t size = 3;
+
+	if ((position < length) && (position > offset) && (bitstream[position - 1] == 0x00))
+	{
+		// 0x00 0x00 0x00 0x01
+		position--;
+		size = 4;
+	}
+
+	if (start_code_size != nullptr)
+	{
+		*start_code_size = size;
+	}
+
+	return position;
+}
+
+size_t NalUnitScanner::FindEmulationPreventionByte(const uint8_t *bitstream, size_t length, size_t offset)
+{
+	if ((bitstream == nullptr) || (offset >= length))
+	{
+		return length;
+	}
+
+	auto position = GetFindPatternFunction()(bitstream, length, offset, 0x03);
+
+	return (position < length) ? (position + 2) : length;
+}
+
+bool NalUnitScanner::Scan(const uint8_t *bitstream, size_t length, std::vector<NalUnitView> &nal_units)
+{
+	uint8_t start_code_size = 0;
+	auto position = FindStartCode(bitstream, length, 0, &start_code_size);
+
+	if (position >= length)
+	{
+		return false;
+	}
+
+	while (position < length)
+	{
+		size_t nal_offset = position + start_code_size;
+		uint8_t next_start_code_size = 0;
+		auto next_position = FindStartCode(bitstream, length, nal_offset, &next_start_code_size);
+
+		if (next_position > nal_offset)
+		{
+			NalUnitView view;
+
+			view.offset = nal_offset;
+			view.length = next_position - nal_offset;
+			view.start_code_size = start_code_size;
+
+			nal_units.push_back(view);
+		}
+
+		position = next_position;
+		start_code_size = next_start_code_size;
+	}
+
+	return true;
+}
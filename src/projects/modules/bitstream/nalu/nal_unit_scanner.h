@@ -0,0 +1,48 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <cstdint>
+#include <vector>
+
+// Location of a NAL unit in the Annex-B bitstream (without the start code)
+struct NalUnitView
+{
+	// Offset of the first byte of the NAL unit (NAL unit header)
+	size_t offset = 0;
+	size_t length = 0;
+	// 3 (0x00 0x00 0x01) or 4 (0x00 0x00 0x00 0x01)
+	uint8_t start_code_size = 0;
+};
+
+// Finds start codes/emulation prevention bytes of the H.264/H.265 bitstream.
+//
+// Uses AVX2 or SSE2 if the CPU supports them, otherwise falls back to the scalar implementation.
+class NalUnitScanner
+{
+public:
+	// Finds the first 0x00 0x00 0x01 pattern in [offset, length)
+	//
+	// @param start_code_size If not nullptr, 4 is stored if the pattern is preceded by 0x00 in [offset, length), otherwise 3
+	//
+	// @return The offset of the start code (including the leading 0x00 of the 4 bytes start code), or length if not found
+	static size_t FindStartCode(const uint8_t *bitstream, size_t length, size_t offset, uint8_t *start_code_size = nullptr);
+
+	// Finds the first 0x00 0x00 0x03 pattern (emulation_prevention_three_byte) in [offset, length)
+	//
+	// @return The offset of the 0x03, or length if not found
+	static size_t FindEmulationPreventionByte(const uint8_t *bitstream, size_t length, size_t offset);
+
+	// Splits the Annex-B bitstream into NAL units. Bytes before the first start code are ignored.
+	//
+	// @return false if no start code is found
+	static bool Scan(const uint8_t *bitstream, size_t length, std::vector<NalUnitView> &nal_units);
+};
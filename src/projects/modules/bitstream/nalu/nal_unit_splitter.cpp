@@ -1,52 +1,21 @@
 #include "nal_unit_splitter.h"
 
-std::shared_ptr<NalUnitList> NalUnitSplitter::Parse(const uint8_t* bitstream, size_t bitstream_length)
+std::shared_ptr<NalUnitList> NalUnitSplitter::Parse(const std::shared_ptr<const ov::Data> &bitstream)
 {
     auto nal_unit_list = std::make_shared<NalUnitList>();
 
-    size_t offset = 0;
-    size_t start_pos = 0, end_pos = 0;
-    while(offset < bitstream_length)
+    if(bitstream == nullptr)
     {
-        size_t remaining = bitstream_length - offset;
-        const uint8_t* data = bitstream + offset;
-
-        if((remaining >= 3 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x01) || 
-            (remaining >= 4 && data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x00 && data[3] == 0x01))
-        {
-            end_pos = offset;
+        return nal_unit_list;
+    }
 
-            if(data[2] == 0x01)
-            {
-                offset += 3;
-            }
-            else
-            {
-                offset += 4;
-            }
+    nal_unit_list->_bitstream = bitstream;
+    NalUnitScanner::Scan(bitstream->GetDataAs<uint8_t>(), bitstream->GetLength(), nal_unit_list->_nal_list);
 
-            if(start_pos == 0)
-            {
-                start_pos = offset;
-            }
-            else
-            {
-                nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, end_pos - start_pos));
-                start_pos = offset;
-            }
-        }
-        else
-        {
-            offset ++;
-        }
-        
-        // last nal unit
-        if(offset == bitstream_length && start_pos != 0)
-        {
-            end_pos = offset;
-            nal_unit_list->_nal_list.emplace_back(std::make_shared<ov::Data>(bitstream + start_pos, end_pos - start_pos));
-        }
-    }
-    
     return nal_unit_list;
-}
\ No newline at end of file
+}
+
+std::shared_ptr<NalUnitList> NalUnitSplitter::Parse(const uint8_t* bitstream, size_t bitstream_length)
+{
+    return Parse(std::make_shared<const ov::Data>(bitstream, bitstream_length));
+}
@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <vector>
 
+#include "nal_unit_scanner.h"
+
 class NalUnitSplitter;
 class NalUnitList
 {
@@ -12,20 +14,42 @@ public:
     {
         return _nal_list.size();
     }
-    std::shared_ptr<ov::Data>   GetNalUnit(uint32_t index)
+
+    // Returns the NAL unit which shares the memory of the original bitstream (no copy)
+    std::shared_ptr<const ov::Data>   GetNalUnit(uint32_t index)
+    {
+        if(index >= GetCount())
+        {
+            return nullptr;
+        }
+
+        auto &view = _nal_list[index];
+        return _bitstream->Subdata(view.offset, view.length);
+    }
+
+    const NalUnitView *GetNalUnitView(uint32_t index)
     {
-        if(index > GetCount() - 1)
+        if(index >= GetCount())
         {
             return nullptr;
         }
 
-        return _nal_list[index];
+        return &_nal_list[index];
+    }
+
+    const uint8_t *GetNalUnitData(uint32_t index)
+    {
+        if(index >= GetCount())
+        {
+            return nullptr;
+        }
+
+        return _bitstream->GetDataAs<uint8_t>() + _nal_list[index].offset;
     }
 
 private:
-    std::vector<std::shared_ptr<ov::Data>>   _nal_list;
-    uint8_t _bitstream;
-    size_t _bitstream_length;
+    std::vector<NalUnitView>   _nal_list;
+    std::shared_ptr<const ov::Data> _bitstream;
 
     friend class NalUnitSplitter;
 };
@@ -33,6 +57,8 @@ private:
 class NalUnitSplitter
 {
 public:
+    static std::shared_ptr<NalUnitList> Parse(const std::shared_ptr<const ov::Data> &bitstream);
+    // The bitstream is copied once, and then NAL units refer to the copy
     static std::shared_ptr<NalUnitList> Parse(const uint8_t* bitstream, size_t bitstream_length);
 private:
-};
\ No newline at end of file
+};
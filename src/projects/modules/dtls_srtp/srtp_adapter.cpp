@@ -50,6 +50,15 @@ bool SrtpAdapter::SetKey(srtp_ssrc_type_t type, uint64_t crypto_suite, std::shar
 			srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtp);
 			srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtcp);
 			break;
+		// AES-GCM of libsrtp requires the OpenSSL crypto backend (--enable-openssl), which uses AES-NI if the CPU has it
+		case SRTP_AEAD_AES_128_GCM:
+			srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
+			srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
+			break;
+		case SRTP_AEAD_AES_256_GCM:
+			srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
+			srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
+			break;
 		default:
 			logte("Failed to create srtp adapter. Unsupported crypto suite %d", crypto_suite);
 			return false;
@@ -75,7 +84,7 @@ bool SrtpAdapter::SetKey(srtp_ssrc_type_t type, uint64_t crypto_suite, std::shar
 	_rtp_auth_tag_len = policy.rtp.auth_tag_len;
     _rtcp_auth_tag_len = policy.rtcp.auth_tag_len;
 
-    logtd("srtp teg size rtp(%d) rtcp(%d)", _rtp_auth_tag_len, _rtcp_auth_tag_len);
+    logtd("srtp crypto suite(%" PRIu64 ") teg size rtp(%d) rtcp(%d)", crypto_suite, _rtp_auth_tag_len, _rtcp_auth_tag_len);
 
 
 	return true;
@@ -117,6 +126,42 @@ bool SrtpAdapter::ProtectRtp(std::shared_ptr<ov::Data> data)
 	return true;
 }
 
+bool SrtpAdapter::ProtectRtp(const std::shared_ptr<const ov::Data> &data, const std::shared_ptr<ov::Data> &protected_data)
+{
+	if(!_session)
+	{
+		return false;
+	}
+
+	size_t data_len = data->GetLength();
+	uint32_t need_len = data_len + _rtp_auth_tag_len;
+
+	// SetLength() doesn't reallocate the memory when the capacity is enough
+	if(protected_data->SetLength(need_len) == false)
+	{
+		logte("Could not allocate the buffer to protect (%d)", need_len);
+		return false;
+	}
+
+	auto buffer = protected_data->GetWritableDataAs<uint8_t>();
+	::memcpy(buffer, data->GetData(), data_len);
+
+	int out_len = static_cast<int>(data_len);
+
+	std::lock_guard<std::mutex> lock(_session_lock);
+	int err = srtp_protect(_session, buffer, &out_len);
+	if(err != srtp_err_status_ok)
+	{
+		logte("Failed to protect SRTP packet, err=%d, len=%d, seq=%u, payload_type=%d",
+			  err, out_len, ByteReader<uint16_t>::ReadBigEndian(&buffer[2]), buffer[1] & 0x7F);
+		return false;
+	}
+
+	protected_data->SetLength(out_len);
+
+	return true;
+}
+
 bool SrtpAdapter::ProtectRtcp(std::shared_ptr<ov::Data> data)
 {
     if(!_session)
@@ -22,6 +22,9 @@ public:
 	bool	SetKey(srtp_ssrc_type_t type, uint64_t crypto_suite, std::shared_ptr<ov::Data> key);
 
 	bool	ProtectRtp(std::shared_ptr<ov::Data> data);
+	// Encrypts <data> into <protected_data> instead of in-place, so <data> can be shared among sessions.
+	// <protected_data> is reused by the caller, so no memory is allocated per packet.
+	bool	ProtectRtp(const std::shared_ptr<const ov::Data> &data, const std::shared_ptr<ov::Data> &protected_data);
     bool	ProtectRtcp(std::shared_ptr<ov::Data> data);
 	bool	UnprotectRtp(const std::shared_ptr<ov::Data> &data);
     bool	UnprotectRtcp(const std::shared_ptr<ov::Data> &data);
@@ -14,7 +14,7 @@
 SrtpTransport::SrtpTransport()
 	: ov::Node(NodeType::Srtp)
 {
-
+	_protect_buffer = std::make_shared<ov::Data>(RTP_DEFAULT_MAX_PACKET_SIZE + SRTP_MAX_TRAILER_LEN);
 }
 
 SrtpTransport::~SrtpTransport()
@@ -23,6 +23,8 @@ SrtpTransport::~SrtpTransport()
 
 bool SrtpTransport::Stop()
 {
+	_is_send_ready = false;
+
 	if(_send_session != nullptr)
 	{
 		_send_session->Release();
@@ -51,10 +53,22 @@ bool SrtpTransport::SendData(NodeType from_node, const std::shared_ptr<ov::Data>
 	
 	if(from_node == NodeType::Rtp)
 	{
-		if(!_send_session->ProtectRtp(data))
+		// To DTLS transport
+		auto node = GetLowerNode();
+		if(!node)
 		{
 			return false;
 		}
+
+		// The lower nodes send the buffer synchronously (or queue a copy-on-write clone of it), so it can be reused after SendData() returns
+		std::lock_guard<std::mutex> lock(_protect_buffer_lock);
+
+		if(!_send_session->ProtectRtp(data, _protect_buffer))
+		{
+			return false;
+		}
+
+		return node->SendData(GetNodeType(), _protect_buffer);
 	}
 	else if(from_node == NodeType::Rtcp)
 	{
@@ -175,5 +189,7 @@ bool SrtpTransport::SetKeyMeterial(uint64_t crypto_suite, std::shared_ptr<ov::Da
 		return false;
 	}
 
+	_is_send_ready = true;
+
 	return true;
 }
\ No newline at end of file
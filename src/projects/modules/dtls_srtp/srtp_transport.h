@@ -27,7 +27,19 @@ public:
 
 	bool SetKeyMeterial(uint64_t crypto_suite, std::shared_ptr<ov::Data> server_key, std::shared_ptr<ov::Data> client_key);
 
+	// Whether the SRTP keys are negotiated, so that RTP packets can be sent
+	bool IsSendReady() const
+	{
+		return _is_send_ready;
+	}
+
 private:
 	std::shared_ptr<SrtpAdapter>		_send_session = nullptr;
 	std::shared_ptr<SrtpAdapter>		_recv_session = nullptr;
+	std::atomic<bool>					_is_send_ready{false};
+
+	// RTP packets are shared by all sessions of the stream, so they are encrypted into this buffer instead of in-place.
+	// It is preallocated once per session and reused for every packet.
+	std::mutex							_protect_buffer_lock;
+	std::shared_ptr<ov::Data>			_protect_buffer = nullptr;
 };
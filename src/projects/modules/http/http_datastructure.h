@@ -57,7 +57,9 @@ enum class HttpConnectionPolicy : char
 	// Send "Connection: Closed" header
 	Closed,
 	// Send "Connection: Keep-Alive" header
-	KeepAlive
+	KeepAlive,
+	// The response is still being sent by the module (e.g. chunked transfer), and the module completes the connection later
+	Pending
 };
 
 enum class HttpInterceptorResult : char
@@ -37,3 +37,143 @@ std::shared_ptr<const HttpResponse> HttpConnection::GetResponse() const
 {
 	return _response;
 }
+
+bool HttpConnection::PrepareKeepAlive()
+{
+	auto request_count = GetRequestCount();
+	bool keep_alive = false;
+
+	// Keep-alive is used only for the requests without body
+	if ((request_count < HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS) && (_request->GetContentLength() == 0L))
+	{
+		auto connection = _request->GetHeader("CONNECTION").LowerCaseString();
+
+		if (_request->GetHttpVersionAsNumber() > 1.0)
+		{
+			// RFC7230 - 6.3. Persistence
+			// HTTP/1.1 defaults to the use of "persistent connections"
+			keep_alive = (connection.IndexOf("close") < 0L);
+		}
+		else
+		{
+			// HTTP/1.0 client must send "Connection: keep-alive" to use persistent connection
+			keep_alive = (connection.IndexOf("keep-alive") >= 0L);
+		}
+	}
+
+	if (keep_alive)
+	{
+		_response->SetHeader("Connection", "keep-alive");
+		_response->SetHeader("Keep-Alive", ov::String::FormatString("timeout=%d, max=%u",
+																	HTTP_SERVER_KEEP_ALIVE_TIMEOUT / 1000,
+																	HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS - request_count));
+	}
+	else
+	{
+		_response->SetHeader("Connection", "close");
+	}
+
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+	_keep_alive = keep_alive;
+
+	return keep_alive;
+}
+
+bool HttpConnection::IsKeepAlive() const
+{
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+
+	return _keep_alive;
+}
+
+uint32_t HttpConnection::GetRequestCount() const
+{
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+
+	return _request_count;
+}
+
+bool HttpConnection::CompleteResponse()
+{
+	if (IsKeepAlive() && _server->ProcessNextRequest(GetSharedPtr()))
+	{
+		return true;
+	}
+
+	return _response->Close();
+}
+
+void HttpConnection::BeginProcessing(const std::shared_ptr<const ov::Data> &remaining_data)
+{
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+
+	_is_processing = true;
+	_request_count++;
+
+	if ((remaining_data != nullptr) && (remaining_data->IsEmpty() == false))
+	{
+		// The remaining data must be processed before the data received after it
+		auto pending_data = remaining_data->Clone();
+
+		if (_pending_data != nullptr)
+		{
+			pending_data->Append(_pending_data.get());
+		}
+
+		_pending_data = pending_data;
+	}
+}
+
+bool HttpConnection::KeepDataIfProcessing(const std::shared_ptr<const ov::Data> &data)
+{
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+
+	if (_is_processing == false)
+	{
+		return false;
+	}
+
+	if (_pending_data == nullptr)
+	{
+		_pending_data = data->Clone();
+	}
+	else
+	{
+		_pending_data->Append(data.get());
+	}
+
+	return true;
+}
+
+std::shared_ptr<const ov::Data> HttpConnection::TakePendingData()
+{
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+
+	if ((_pending_data == nullptr) || _pending_data->IsEmpty())
+	{
+		_pending_data = nullptr;
+		_is_processing = false;
+		return nullptr;
+	}
+
+	return std::move(_pending_data);
+}
+
+void HttpConnection::ResetForNextRequest(const std::shared_ptr<HttpRequestInterceptor> &interceptor)
+{
+	_request->ResetForNextRequest(interceptor);
+	_response->ResetForNextRequest();
+
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+	_keep_alive = false;
+	_last_response_time = ov::Clock::NowMSec();
+}
+
+bool HttpConnection::IsIdleTimedOut(uint64_t current_msec) const
+{
+	std::lock_guard<std::mutex> lock_guard(_keep_alive_mutex);
+
+	return (_is_processing == false) &&
+		   (_last_response_time > 0) &&
+		   ((current_msec - _last_response_time) > HTTP_SERVER_KEEP_ALIVE_TIMEOUT);
+}
@@ -18,13 +18,13 @@ class HttpServer;
 // HttpRequest: Contains request informations (Request HTTP Header & Body)
 // HttpResponse: Contains socket & response informations (Response HTTP Header & Body)
 
-class HttpConnection
+class HttpConnection : public ov::EnableSharedFromThis<HttpConnection>
 {
 public:
 	friend class HttpServer;
 
 	HttpConnection(const std::shared_ptr<HttpServer> &server, std::shared_ptr<HttpRequest> &http_request, std::shared_ptr<HttpResponse> &http_response);
-	virtual ~HttpConnection() = default;
+	~HttpConnection() override = default;
 
 	std::shared_ptr<HttpRequest> GetRequest();
 	std::shared_ptr<HttpResponse> GetResponse();
@@ -32,9 +32,48 @@ public:
 	std::shared_ptr<const HttpRequest> GetRequest() const;
 	std::shared_ptr<const HttpResponse> GetResponse() const;
 
+	// Decides whether the connection can be reused for the next request (HTTP persistent connection),
+	// and sets "Connection" and "Keep-Alive" headers of the response.
+	// This must be called before the header of the response is sent.
+	//
+	// @return Returns true if the connection will be kept after the response
+	bool PrepareKeepAlive();
+	bool IsKeepAlive() const;
+
+	// Number of the requests received through this connection
+	uint32_t GetRequestCount() const;
+
+	// Called when the response is sent completely.
+	// If keep-alive is prepared, the connection waits for the next request. Otherwise, the connection is closed.
+	bool CompleteResponse();
+
 protected:
+	// Called when a request without body is parsed. The request is being processed until CompleteResponse() is called,
+	// and the data received meanwhile (pipelined requests) is kept to be processed later.
+	void BeginProcessing(const std::shared_ptr<const ov::Data> &remaining_data);
+
+	// @return Returns true if the data is kept because a request is being processed
+	bool KeepDataIfProcessing(const std::shared_ptr<const ov::Data> &data);
+
+	// @return Returns the data received while processing the previous request.
+	//         If there is no data, returns nullptr and the connection is no longer processing a request.
+	std::shared_ptr<const ov::Data> TakePendingData();
+
+	// Reset the request and the response to receive the next request
+	void ResetForNextRequest(const std::shared_ptr<HttpRequestInterceptor> &interceptor);
+
+	bool IsIdleTimedOut(uint64_t current_msec) const;
+
 	std::shared_ptr<HttpServer> _server = nullptr;
 
 	std::shared_ptr<HttpRequest> _request = nullptr;
 	std::shared_ptr<HttpResponse> _response = nullptr;
+
+	mutable std::mutex _keep_alive_mutex;
+	bool _keep_alive = false;
+	bool _is_processing = false;
+	std::shared_ptr<ov::Data> _pending_data;
+	uint32_t _request_count = 0;
+	// The time when the last response is completed (0 if the connection has not been reused)
+	uint64_t _last_response_time = 0;
 };
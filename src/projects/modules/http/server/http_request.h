@@ -165,6 +165,23 @@ public:
 		_http_version = "";
 	}
 
+	// Reset the request to receive the next request through the same connection (HTTP persistent connection)
+	void ResetForNextRequest(const std::shared_ptr<HttpRequestInterceptor> &interceptor)
+	{
+		InitParseInfo();
+
+		_connection_type = HttpRequestConnectionType::Unknown;
+		_interceptor = interceptor;
+
+		_request_uri = "";
+		_match_result = ov::MatchResult();
+
+		_content_length = 0L;
+		_request_body = nullptr;
+
+		_extra.reset();
+	}
+
 protected:
 	// HttpRequestInterceptorInterface를 통해, 다른 interceptor에서 사용됨
 	const std::shared_ptr<ov::Data> &GetRequestBodyInternal()
@@ -67,6 +67,30 @@ const ov::String &HttpResponse::GetHeader(const ov::String &key)
 	return item->second;
 }
 
+bool HttpResponse::RemoveHeader(const ov::String &key)
+{
+	if (_is_header_sent)
+	{
+		logtw("Cannot modify header: Header is sent: %s", _client_socket->ToString().CStr());
+		return false;
+	}
+
+	return (_response_header.erase(key) > 0);
+}
+
+bool HttpResponse::SetPreparedHeaderFields(const std::shared_ptr<const ov::Data> &header_fields)
+{
+	if (_is_header_sent)
+	{
+		logtw("Cannot modify header: Header is sent: %s", _client_socket->ToString().CStr());
+		return false;
+	}
+
+	_prepared_header_fields = header_fields;
+
+	return true;
+}
+
 bool HttpResponse::AppendData(const std::shared_ptr<const ov::Data> &data)
 {
 	if (data == nullptr)
@@ -115,7 +139,7 @@ uint32_t HttpResponse::SendHeaderIfNeeded()
 	std::shared_ptr<ov::Data> response = std::make_shared<ov::Data>();
 	ov::ByteStream stream(response.get());
 
-	if (_chunked_transfer == false)
+	if ((_chunked_transfer == false) && (_prepared_header_fields == nullptr) && (_response_header.find("Content-Length") == _response_header.end()))
 	{
 		// Calculate the content length
 		SetHeader("Content-Length", ov::Converter::ToString(_response_data_size));
@@ -134,6 +158,11 @@ uint32_t HttpResponse::SendHeaderIfNeeded()
 		stream.Append("\r\n", 2);
 	});
 
+	if (_prepared_header_fields != nullptr)
+	{
+		stream.Append(_prepared_header_fields);
+	}
+
 	stream.Append("\r\n", 2);
 
 	if (Send(response))
@@ -169,6 +198,16 @@ bool HttpResponse::Send(const std::shared_ptr<const ov::Data> &data)
 	}
 	else
 	{
+		if (_tls_data->IsKernelTlsReady() && (_client_socket->HasCommand() == false))
+		{
+			// All the records encrypted by OpenSSL have been passed to the kernel, so the kernel can encrypt the rest
+			_tls_data->StartKernelTls(
+				_client_socket->GetNativeHandle(),
+				[client_socket = _client_socket](uint8_t record_type, const void *data, size_t length) -> ssize_t {
+					return client_socket->SendTlsRecord(record_type, std::make_shared<ov::Data>(data, length)) ? static_cast<ssize_t>(length) : -1L;
+				});
+		}
+
 		if (_tls_data->Encrypt(data, &send_data) == false)
 		{
 			return false;
@@ -245,6 +284,23 @@ uint32_t HttpResponse::SendResponse()
 	return sent_bytes;
 }
 
+void HttpResponse::ResetForNextRequest()
+{
+	std::lock_guard<decltype(_response_mutex)> lock(_response_mutex);
+
+	_status_code = HttpStatusCode::OK;
+	_reason = StringFromHttpStatusCode(HttpStatusCode::OK);
+
+	_is_header_sent = false;
+	_response_header.clear();
+	_prepared_header_fields = nullptr;
+
+	_response_data_list.clear();
+	_response_data_size = 0;
+
+	_chunked_transfer = false;
+}
+
 bool HttpResponse::Close()
 {
 	OV_ASSERT2(_client_socket != nullptr);
@@ -57,6 +57,12 @@ public:
 
 	bool SetHeader(const ov::String &key, const ov::String &value);
 	const ov::String &GetHeader(const ov::String &key);
+	bool RemoveHeader(const ov::String &key);
+
+	// Set the header fields serialized in advance ("<Name>: <Value>\r\n" list).
+	// They are sent after the headers set by SetHeader(), so the same fields must not be set by SetHeader().
+	// Content-Length is not calculated if the fields are set.
+	bool SetPreparedHeaderFields(const std::shared_ptr<const ov::Data> &header_fields);
 
 	// Enqueue the data into the queue (This data will be sent when SendResponse() is called)
 	// Can be used for response with content-length
@@ -81,6 +87,9 @@ public:
 
 	bool Close();
 
+	// Reset the status, headers and data to send the next response through the same connection (HTTP persistent connection)
+	void ResetForNextRequest();
+
 	void SetKeepAlive()
 	{
 		SetHeader("Connection", "keep-alive");
@@ -112,6 +121,7 @@ protected:
 	bool _is_header_sent = false;
 
 	std::map<ov::String, ov::String> _response_header;
+	std::shared_ptr<const ov::Data> _prepared_header_fields;
 
 	// FIXME(dimiden): It is supposed to be synchronized whenever a packet is sent, but performance needs to be improved
 	std::recursive_mutex _response_mutex;
@@ -41,6 +41,9 @@ bool HttpServer::Start(const ov::SocketAddress &address, int worker_count)
 
 	if (_physical_port != nullptr)
 	{
+		_keep_alive_timer.Push(std::bind(&HttpServer::CloseIdleConnections, this, std::placeholders::_1), 1000);
+		_keep_alive_timer.Start();
+
 		return _physical_port->AddObserver(this);
 	}
 
@@ -62,6 +65,8 @@ bool HttpServer::Stop()
 		return false;
 	}
 
+	_keep_alive_timer.Stop();
+
 	physical_port->RemoveObserver(this);
 	PhysicalPortManager::GetInstance()->DeletePort(physical_port);
 	physical_port = nullptr;
@@ -138,121 +143,191 @@ void HttpServer::ProcessData(const std::shared_ptr<HttpConnection> &client, cons
 {
 	if (client != nullptr)
 	{
-		std::shared_ptr<HttpRequest> request = client->GetRequest();
-		std::shared_ptr<HttpResponse> response = client->GetResponse();
+		if (client->KeepDataIfProcessing(data))
+		{
+			// The data will be processed after the response of the previous request is completed (HTTP pipelining)
+			return;
+		}
 
-		bool need_to_disconnect = false;
+		ProcessDataInternal(client, data);
+	}
+}
 
-		switch (request->ParseStatus())
-		{
-			case HttpStatusCode::OK: {
-				auto interceptor = request->GetRequestInterceptor();
+bool HttpServer::ProcessDataInternal(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const ov::Data> &data)
+{
+	bool is_processing = false;
 
-				if (interceptor != nullptr)
-				{
-					// If the request is parsed, bypass to the interceptor
-					need_to_disconnect = (interceptor->OnHttpData(client, data) == HttpInterceptorResult::Disconnect);
-				}
-				else
-				{
-					OV_ASSERT2(false);
-					need_to_disconnect = true;
-				}
+	std::shared_ptr<HttpRequest> request = client->GetRequest();
+	std::shared_ptr<HttpResponse> response = client->GetResponse();
+
+	bool need_to_disconnect = false;
+
+	switch (request->ParseStatus())
+	{
+		case HttpStatusCode::OK: {
+			auto interceptor = request->GetRequestInterceptor();
 
-				break;
+			if (interceptor != nullptr)
+			{
+				// If the request is parsed, bypass to the interceptor
+				need_to_disconnect = (interceptor->OnHttpData(client, data) == HttpInterceptorResult::Disconnect);
 			}
+			else
+			{
+				OV_ASSERT2(false);
+				need_to_disconnect = true;
+			}
+
+			break;
+		}
 
-			case HttpStatusCode::PartialContent: {
-				// Need to parse HTTP header
-				ssize_t processed_length = TryParseHeader(client, data);
+		case HttpStatusCode::PartialContent: {
+			// Need to parse HTTP header
+			ssize_t processed_length = TryParseHeader(client, data);
 
-				if (processed_length >= 0)
+			if (processed_length >= 0)
+			{
+				if (request->ParseStatus() == HttpStatusCode::OK)
 				{
-					if (request->ParseStatus() == HttpStatusCode::OK)
+					// Probe scheme
+					if (IsWebSocketRequest(request) == true)
 					{
-						// Probe scheme
-						if (IsWebSocketRequest(request) == true)
-						{
-							request->SetConnectionType(HttpRequestConnectionType::WebSocket);
-						}
-						else
-						{
-							request->SetConnectionType(HttpRequestConnectionType::HTTP);
-						}
+						request->SetConnectionType(HttpRequestConnectionType::WebSocket);
+					}
+					else
+					{
+						request->SetConnectionType(HttpRequestConnectionType::HTTP);
+					}
 
-						// Parsing is completed
-						bool found_interceptor = false;
-						// Find interceptor for the request
-						{
-							std::shared_lock<std::shared_mutex> guard(_interceptor_list_mutex);
+					// Parsing is completed
+					bool found_interceptor = false;
+					// Find interceptor for the request
+					{
+						std::shared_lock<std::shared_mutex> guard(_interceptor_list_mutex);
 
-							for (auto &interceptor : _interceptor_list)
+						for (auto &interceptor : _interceptor_list)
+						{
+							if (interceptor->IsInterceptorForRequest(client))
 							{
-								if (interceptor->IsInterceptorForRequest(client))
-								{
-									found_interceptor = true;
-									request->SetRequestInterceptor(interceptor);
-									break;
-								}
+								found_interceptor = true;
+								request->SetRequestInterceptor(interceptor);
+								break;
 							}
 						}
+					}
 
-						auto interceptor = request->GetRequestInterceptor();
-
-						if (interceptor == nullptr)
-						{
-							response->SetStatusCode(HttpStatusCode::InternalServerError);
-							need_to_disconnect = true;
-							OV_ASSERT2(false);
-						}
+					auto interceptor = request->GetRequestInterceptor();
 
-						auto remote = request->GetRemote();
+					if (interceptor == nullptr)
+					{
+						response->SetStatusCode(HttpStatusCode::InternalServerError);
+						need_to_disconnect = true;
+						OV_ASSERT2(false);
+					}
 
-						if (remote != nullptr)
-						{
-							logti("Client(%s) is requested uri: [%s]", remote->ToString().CStr(), request->GetUri().CStr());
-						}
+					auto remote = request->GetRemote();
 
-						if (found_interceptor == false)
-						{
-							logtw("No module could be found to handle this connection request : [%s]", request->GetUri().CStr());
-						}
+					if (remote != nullptr)
+					{
+						logti("Client(%s) is requested uri: [%s]", remote->ToString().CStr(), request->GetUri().CStr());
+					}
 
-						need_to_disconnect = need_to_disconnect || (interceptor->OnHttpPrepare(client) == HttpInterceptorResult::Disconnect);
-						need_to_disconnect = need_to_disconnect || (interceptor->OnHttpData(client, data->Subdata(processed_length)) == HttpInterceptorResult::Disconnect);
+					if (found_interceptor == false)
+					{
+						logtw("No module could be found to handle this connection request : [%s]", request->GetUri().CStr());
 					}
-					else if (request->ParseStatus() == HttpStatusCode::PartialContent)
+
+					auto body_data = data->Subdata(processed_length);
+
+					if ((request->GetConnectionType() == HttpRequestConnectionType::HTTP) && (request->GetContentLength() == 0L))
 					{
-						// Need more data
+						// The request has no body, so the rest of the data belongs to the next request
+						client->BeginProcessing(body_data);
+						body_data = std::make_shared<ov::Data>();
+						is_processing = true;
 					}
+
+					need_to_disconnect = need_to_disconnect || (interceptor->OnHttpPrepare(client) == HttpInterceptorResult::Disconnect);
+					need_to_disconnect = need_to_disconnect || (interceptor->OnHttpData(client, body_data) == HttpInterceptorResult::Disconnect);
 				}
-				else
+				else if (request->ParseStatus() == HttpStatusCode::PartialContent)
 				{
-					// An error occurred with the request
-					request->GetRequestInterceptor()->OnHttpError(client, HttpStatusCode::BadRequest);
-					need_to_disconnect = true;
+					// Need more data
 				}
-
-				break;
 			}
-
-			default:
-				// 이전에 parse 할 때 오류가 발생했다면 response한 뒤 close() 했으므로, 정상적인 상황이라면 여기에 진입하면 안됨
-				logte("Invalid parse status: %d", request->ParseStatus());
-				OV_ASSERT2(false);
+			else
+			{
+				// An error occurred with the request
+				request->GetRequestInterceptor()->OnHttpError(client, HttpStatusCode::BadRequest);
 				need_to_disconnect = true;
-				break;
+			}
+
+			break;
 		}
 
-		if (need_to_disconnect)
+		default:
+			// 이전에 parse 할 때 오류가 발생했다면 response한 뒤 close() 했으므로, 정상적인 상황이라면 여기에 진입하면 안됨
+			logte("Invalid parse status: %d", request->ParseStatus());
+			OV_ASSERT2(false);
+			need_to_disconnect = true;
+			break;
+	}
+
+	if (need_to_disconnect)
+	{
+		// 연결을 종료해야 함
+		response->Response();
+		response->Close();
+	}
+
+	return is_processing;
+}
+
+bool HttpServer::ProcessNextRequest(const std::shared_ptr<HttpConnection> &client)
+{
+	if (client->GetResponse()->GetRemote()->GetState() != ov::SocketState::Connected)
+	{
+		return false;
+	}
+
+	client->ResetForNextRequest(_default_interceptor);
+	SetDefaultHeaders(client->GetResponse());
+
+	while (true)
+	{
+		auto data = client->TakePendingData();
+
+		if (data == nullptr)
+		{
+			// Wait for the next request
+			return true;
+		}
+
+		if (ProcessDataInternal(client, data))
 		{
-			// 연결을 종료해야 함
-			response->Response();
-			response->Close();
+			// The next request is being processed, and the rest of the data is kept again
+			return true;
 		}
 	}
 }
 
+void HttpServer::SetDefaultHeaders(const std::shared_ptr<HttpResponse> &response)
+{
+	response->SetHeader("Server", "OvenMediaEngine");
+	response->SetHeader("Content-Type", "text/html");
+}
+
+ov::DelayQueueAction HttpServer::CloseIdleConnections(void *parameter)
+{
+	auto current_msec = ov::Clock::NowMSec();
+
+	DisconnectIf([current_msec](const std::shared_ptr<HttpConnection> &client) -> bool {
+		return client->IsIdleTimedOut(current_msec);
+	});
+
+	return ov::DelayQueueAction::Repeat;
+}
+
 std::shared_ptr<HttpConnection> HttpServer::ProcessConnect(const std::shared_ptr<ov::Socket> &remote)
 {
 	logti("Client(%s) is connected on %s", remote->ToString().CStr(), _physical_port->GetAddress().ToString().CStr());
@@ -270,9 +345,7 @@ std::shared_ptr<HttpConnection> HttpServer::ProcessConnect(const std::shared_ptr
 
 	if (response != nullptr)
 	{
-		// Set default headers
-		response->SetHeader("Server", "OvenMediaEngine");
-		response->SetHeader("Content-Type", "text/html");
+		SetDefaultHeaders(response);
 	}
 
 	std::lock_guard<std::shared_mutex> guard(_client_list_mutex);
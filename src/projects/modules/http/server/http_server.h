@@ -18,6 +18,11 @@
 
 #define HTTP_SERVER_USE_DEFAULT_COUNT PHYSICAL_PORT_USE_DEFAULT_COUNT
 
+// A persistent connection is closed if the next request is not received within this time (in milliseconds)
+#define HTTP_SERVER_KEEP_ALIVE_TIMEOUT (15 * 1000)
+// Maximum number of requests that can be received through a persistent connection
+#define HTTP_SERVER_KEEP_ALIVE_MAX_REQUESTS 100
+
 // References
 //
 // RFC7230 - Hypertext Transfer Protocol (HTTP/1.1): Message Syntax and Routing (https://tools.ietf.org/html/rfc7230)
@@ -33,6 +38,7 @@ class HttpServer : protected PhysicalPortObserver, public ov::EnableSharedFromTh
 {
 protected:
 	friend class HttpServerManager;
+	friend class HttpConnection;
 
 public:
 	using ClientList = std::map<ov::Socket *, std::shared_ptr<HttpConnection>>;
@@ -63,6 +69,16 @@ protected:
 
 	std::shared_ptr<HttpConnection> ProcessConnect(const std::shared_ptr<ov::Socket> &remote);
 	void ProcessData(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const ov::Data> &data);
+	// @return Returns true if a request without body is parsed and passed to the interceptor
+	bool ProcessDataInternal(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const ov::Data> &data);
+
+	// Called by HttpConnection::CompleteResponse() to receive the next request through the connection
+	bool ProcessNextRequest(const std::shared_ptr<HttpConnection> &client);
+
+	void SetDefaultHeaders(const std::shared_ptr<HttpResponse> &response);
+
+	// Close the persistent connections which have not received the next request for a while
+	ov::DelayQueueAction CloseIdleConnections(void *parameter);
 
 	//--------------------------------------------------------------------
 	// Implementation of PhysicalPortObserver
@@ -91,6 +107,8 @@ protected:
 
 	std::vector<std::shared_ptr<ocst::VirtualHost>> _virtual_host_list;
 
+	ov::DelayQueue _keep_alive_timer;
+
 private:
 	bool IsWebSocketRequest(const std::shared_ptr<const HttpRequest> &request);
 };
@@ -52,6 +52,12 @@ void HttpsServer::OnConnected(const std::shared_ptr<ov::Socket> &remote)
 			return remote->Send(data, length) ? length : -1L;
 		});
 
+		if (_certificate->IsKernelTlsEnabled())
+		{
+			// HttpResponse::Send() hands over the encryption to the kernel after the handshake
+			tls_data->PrepareKernelTls();
+		}
+
 		client->GetRequest()->SetTlsData(tls_data);
 		client->GetResponse()->SetTlsData(tls_data);
 	}
@@ -168,6 +168,12 @@ std::shared_ptr<PhysicalPort> IcePort::CreatePhysicalPort(const ov::SocketAddres
 	{
 		if (physical_port->AddObserver(this))
 		{
+			if (type == ov::SocketType::Udp)
+			{
+				// Used by the pacer of WebRTC sessions. If it is not enabled, the pacer holds the packets by itself.
+				physical_port->GetSocket()->EnableTxTime();
+			}
+
 			return physical_port;
 		}
 
@@ -0,0 +1,682 @@
+//==============================================================================
+//
+//  MPEGTS Packetizer
+//
+//  Created by Getroot
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "mpegts_packetizer.h"
+
+#include <array>
+
+#define OV_LOG_TAG "MpegTsPacketizer"
+
+namespace mpegts
+{
+	// CRC-32/MPEG-2 (polynomial: 0x04C11DB7, not reflected, no final XOR) used by PSI sections
+	static constexpr std::array<uint32_t, 256> MakeCrc32Table()
+	{
+		std::array<uint32_t, 256> table{};
+
+		for (uint32_t index = 0; index < 256; index++)
+		{
+			uint32_t crc = index << 24;
+
+			for (int bit = 0; bit < 8; bit++)
+			{
+				crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04C11DB7) : (crc << 1);
+			}
+
+			table[index] = crc;
+		}
+
+		return table;
+	}
+
+	static constexpr auto CRC32_TABLE = MakeCrc32Table();
+
+	static uint32_t Crc32(const uint8_t *data, size_t length)
+	{
+		uint32_t crc = 0xFFFFFFFF;
+
+		for (size_t index = 0; index < length; index++)
+		{
+			crc = (crc << 8) ^ CRC32_TABLE[((crc >> 24) ^ data[index]) & 0xFF];
+		}
+
+		return crc;
+	}
+
+	// Calculates CRC of [section, current) and writes it at current
+	static inline uint8_t *WriteCrc32(uint8_t *current, const uint8_t *section)
+	{
+		auto crc = Crc32(section, current - section);
+
+		current[0] = static_cast<uint8_t>(crc >> 24);
+		current[1] = static_cast<uint8_t>(crc >> 16);
+		current[2] = static_cast<uint8_t>(crc >> 8);
+		current[3] = static_cast<uint8_t>(crc);
+
+		return current + 4;
+	}
+
+	static inline uint8_t *WriteTimestamp(uint8_t *buffer, uint8_t prefix, int64_t timestamp)
+	{
+		// '<prefix:4>' TS[32..30] marker_bit TS[29..15] marker_bit TS[14..0] marker_bit
+		buffer[0] = static_cast<uint8_t>((prefix << 4) | (((timestamp >> 30) & 0x07) << 1) | 0x01);
+		buffer[1] = static_cast<uint8_t>(timestamp >> 22);
+		buffer[2] = static_cast<uint8_t>((((timestamp >> 15) & 0x7F) << 1) | 0x01);
+		buffer[3] = static_cast<uint8_t>(timestamp >> 7);
+		buffer[4] = static_cast<uint8_t>(((timestamp & 0x7F) << 1) | 0x01);
+
+		return buffer + 5;
+	}
+
+	static inline uint8_t *WritePcr(uint8_t *buffer, int64_t pcr_base)
+	{
+		// program_clock_reference_base(33) reserved(6) program_clock_reference_extension(9)
+		buffer[0] = static_cast<uint8_t>(pcr_base >> 25);
+		buffer[1] = static_cast<uint8_t>(pcr_base >> 17);
+		buffer[2] = static_cast<uint8_t>(pcr_base >> 9);
+		buffer[3] = static_cast<uint8_t>(pcr_base >> 1);
+		buffer[4] = static_cast<uint8_t>(((pcr_base & 0x01) << 7) | 0x7E);
+		buffer[5] = 0x00;
+
+		return buffer + 6;
+	}
+
+	static inline size_t GetStartCodeSize(const uint8_t *data, size_t length)
+	{
+		if ((length >= 4) && (data[0] == 0x00) && (data[1] == 0x00) && (data[2] == 0x00) && (data[3] == 0x01))
+		{
+			return 4;
+		}
+
+		if ((length >= 3) && (data[0] == 0x00) && (data[1] == 0x00) && (data[2] == 0x01))
+		{
+			return 3;
+		}
+
+		return 0;
+	}
+
+	bool MpegTsPacketizer::AddTrack(const std::shared_ptr<const MediaTrack> &media_track)
+	{
+		if (media_track == nullptr)
+		{
+			return false;
+		}
+
+		auto track = std::make_shared<Track>();
+
+		switch (media_track->GetCodecId())
+		{
+			case cmn::MediaCodecId::H264:
+				track->stream_type = WellKnownStreamTypes::H264;
+				break;
+
+			case cmn::MediaCodecId::H265:
+				track->stream_type = WellKnownStreamTypes::H265;
+				break;
+
+			case cmn::MediaCodecId::Aac:
+				track->stream_type = WellKnownStreamTypes::AAC;
+				break;
+
+			case cmn::MediaCodecId::Mp3:
+				track->stream_type = WellKnownStreamTypes::MP3;
+				break;
+
+			default:
+				logte("Not supported codec: %s", ::StringFromMediaCodecId(media_track->GetCodecId()).CStr());
+				return false;
+		}
+
+		if ((media_track->GetTimeBase().GetNum() <= 0) || (media_track->GetTimeBase().GetDen() <= 0))
+		{
+			logte("Invalid timebase: %s", media_track->GetTimeBase().ToString().CStr());
+			return false;
+		}
+
+		auto lock_guard = std::lock_guard(_track_mutex);
+
+		uint8_t video_count = 0;
+		uint8_t audio_count = 0;
+
+		for (auto &item : _track_list)
+		{
+			(item->media_track->GetMediaType() == cmn::MediaType::Video) ? video_count++ : audio_count++;
+		}
+
+		track->media_track = media_track;
+		track->pid = MPEGTS_FIRST_ES_PID + _track_list.size();
+
+		if (media_track->GetMediaType() == cmn::MediaType::Video)
+		{
+			// 1110 xxxx: video stream number xxxx
+			track->stream_id = 0xE0 | (video_count & 0x0F);
+
+			if (video_count == 0)
+			{
+				_pcr_pid = track->pid;
+			}
+		}
+		else
+		{
+			// 110x xxxx: audio stream number xxxxx
+			track->stream_id = 0xC0 | (audio_count & 0x1F);
+
+			if (_pcr_pid == static_cast<uint16_t>(WellKnownPacketId::NULL_PACKET))
+			{
+				_pcr_pid = track->pid;
+			}
+		}
+
+		_track_list.push_back(track);
+		_track_map[media_track->GetId()] = track;
+
+		logtd("Track %s is added (pid: 0x%04X, stream_id: 0x%02X)", ::StringFromMediaType(media_track->GetMediaType()).CStr(), track->pid, track->stream_id);
+
+		return true;
+	}
+
+	bool MpegTsPacketizer::Prepare()
+	{
+		if (_segment_data != nullptr)
+		{
+			logte("Packetizer is already prepared");
+			return false;
+		}
+
+		{
+			auto lock_guard = std::lock_guard(_track_mutex);
+
+			if (_track_list.empty())
+			{
+				logte("There is no track to packetize");
+				return false;
+			}
+
+			for (auto &track : _track_list)
+			{
+				track->Reset();
+			}
+		}
+
+		// Segments of a stream have similar sizes, so allocate enough memory at once to avoid reallocation
+		size_t capacity = (_last_segment_length > 0) ? (_last_segment_length + (_last_segment_length / 4)) : MPEGTS_DEFAULT_SEGMENT_CAPACITY;
+
+		_segment_data = std::make_shared<ov::Data>(capacity);
+
+		if ((WritePat() == false) || (WritePmt() == false))
+		{
+			_segment_data = nullptr;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool MpegTsPacketizer::PrepareIfNeeded()
+	{
+		if (_segment_data != nullptr)
+		{
+			return true;
+		}
+
+		return Prepare();
+	}
+
+	std::shared_ptr<const ov::Data> MpegTsPacketizer::Finalize()
+	{
+		auto segment_data = std::move(_segment_data);
+		_segment_data = nullptr;
+
+		if (segment_data != nullptr)
+		{
+			_last_segment_length = segment_data->GetLength();
+		}
+
+		return segment_data;
+	}
+
+	int64_t MpegTsPacketizer::GetFirstPts(uint32_t track_id) const
+	{
+		auto lock_guard = std::lock_guard(_track_mutex);
+		auto track_item = _track_map.find(track_id);
+
+		if (track_item != _track_map.end())
+		{
+			auto &track = track_item->second;
+			return (track->first_packet_received) ? track->first_pts : 0L;
+		}
+
+		return 0L;
+	}
+
+	int64_t MpegTsPacketizer::GetFirstPts(cmn::MediaType type) const
+	{
+		auto lock_guard = std::lock_guard(_track_mutex);
+
+		for (auto &track : _track_list)
+		{
+			if (track->media_track->GetMediaType() == type)
+			{
+				return track->first_pts;
+			}
+		}
+
+		return 0L;
+	}
+
+	int64_t MpegTsPacketizer::GetDuration(uint32_t track_id) const
+	{
+		auto lock_guard = std::lock_guard(_track_mutex);
+		auto track_item = _track_map.find(track_id);
+
+		if (track_item != _track_map.end())
+		{
+			return track_item->second->duration;
+		}
+
+		return 0L;
+	}
+
+	int64_t MpegTsPacketizer::ConvertTimestamp(const std::shared_ptr<const MediaTrack> &media_track, int64_t timestamp)
+	{
+		auto &timebase = media_track->GetTimeBase();
+		int64_t num = static_cast<int64_t>(timebase.GetNum()) * MPEGTS_TIMESCALE;
+		int64_t den = timebase.GetDen();
+
+		if (num == den)
+		{
+			return timestamp;
+		}
+
+		// Split the calculation to avoid overflow
+		return ((timestamp / den) * num) + (((timestamp % den) * num) / den);
+	}
+
+	uint8_t *MpegTsPacketizer::AllocatePacket(uint16_t pid, uint8_t &continuity_counter, bool payload_unit_start_indicator, size_t adaptation_field_length)
+	{
+		auto offset = _segment_data->GetLength();
+		auto length = offset + MPEGTS_MIN_PACKET_SIZE;
+
+		// ov::Data::SetLength() reserves the exact length, so grow the buffer geometrically to avoid copying the segment for every packet
+		if ((length > _segment_data->GetCapacity()) && (_segment_data->Reserve(std::max(_segment_data->GetCapacity() * 2, length)) == false))
+		{
+			logte("Could not allocate a TS packet (segment length: %zu)", offset);
+			return nullptr;
+		}
+
+		if (_segment_data->SetLength(length) == false)
+		{
+			logte("Could not allocate a TS packet (segment length: %zu)", offset);
+			return nullptr;
+		}
+
+		auto packet = _segment_data->GetWritableDataAs<uint8_t>() + offset;
+		uint8_t adaptation_field_control = (adaptation_field_length > 0) ? 0b11 : 0b01;
+
+		// sync_byte(8)
+		packet[0] = MPEGTS_SYNC_BYTE;
+		// transport_error_indicator(1) payload_unit_start_indicator(1) transport_priority(1) PID(13)
+		packet[1] = static_cast<uint8_t>((payload_unit_start_indicator ? 0x40 : 0x00) | ((pid >> 8) & 0x1F));
+		packet[2] = static_cast<uint8_t>(pid & 0xFF);
+		// transport_scrambling_control(2) adaptation_field_control(2) continuity_counter(4)
+		packet[3] = static_cast<uint8_t>((adaptation_field_control << 4) | (continuity_counter & 0x0F));
+
+		continuity_counter = (continuity_counter + 1) & 0x0F;
+
+		return packet + MPEGTS_PACKET_HEADER_SIZE;
+	}
+
+	bool MpegTsPacketizer::WriteSection(uint16_t pid, uint8_t &continuity_counter, const uint8_t *section, size_t section_length)
+	{
+		// PAT/PMT of OME always fit in a TS packet
+		if ((section_length + 1) > MPEGTS_PACKET_PAYLOAD_SIZE)
+		{
+			logte("Section is too long: %zu", section_length);
+			return false;
+		}
+
+		auto payload = AllocatePacket(pid, continuity_counter, true, 0);
+
+		if (payload == nullptr)
+		{
+			return false;
+		}
+
+		// pointer_field
+		payload[0] = 0x00;
+		::memcpy(payload + 1, section, section_length);
+		// Fill the rest with stuffing bytes
+		::memset(payload + 1 + section_length, 0xFF, MPEGTS_PACKET_PAYLOAD_SIZE - 1 - section_length);
+
+		return true;
+	}
+
+	bool MpegTsPacketizer::WritePat()
+	{
+		uint8_t section[MPEGTS_PACKET_PAYLOAD_SIZE];
+		auto current = section;
+
+		// 5 bytes (transport_stream_id ~ last_section_number) + 4 bytes (program) + 4 bytes (CRC)
+		uint16_t section_length = 5 + 4 + 4;
+
+		*current++ = static_cast<uint8_t>(WellKnownTableId::PROGRAM_ASSOCIATION_SECTION);
+		// section_syntax_indicator(1) '0'(1) reserved(2) section_length(12)
+		*current++ = static_cast<uint8_t>(0xB0 | ((section_length >> 8) & 0x0F));
+		*current++ = static_cast<uint8_t>(section_length & 0xFF);
+		// transport_stream_id(16)
+		*current++ = static_cast<uint8_t>(MPEGTS_TRANSPORT_STREAM_ID >> 8);
+		*current++ = static_cast<uint8_t>(MPEGTS_TRANSPORT_STREAM_ID & 0xFF);
+		// reserved(2) version_number(5) current_next_indicator(1)
+		*current++ = 0xC1;
+		// section_number(8), last_section_number(8)
+		*current++ = 0x00;
+		*current++ = 0x00;
+		// program_number(16) reserved(3) program_map_PID(13)
+		*current++ = static_cast<uint8_t>(MPEGTS_PROGRAM_NUMBER >> 8);
+		*current++ = static_cast<uint8_t>(MPEGTS_PROGRAM_NUMBER & 0xFF);
+		*current++ = static_cast<uint8_t>(0xE0 | ((MPEGTS_PMT_PID >> 8) & 0x1F));
+		*current++ = static_cast<uint8_t>(MPEGTS_PMT_PID & 0xFF);
+
+		current = WriteCrc32(current, section);
+
+		return WriteSection(static_cast<uint16_t>(WellKnownPacketId::PAT), _pat_continuity_counter, section, current - section);
+	}
+
+	bool MpegTsPacketizer::WritePmt()
+	{
+		uint8_t section[MPEGTS_PACKET_PAYLOAD_SIZE];
+		auto current = section;
+
+		auto lock_guard = std::lock_guard(_track_mutex);
+
+		// 9 bytes (program_number ~ program_info_length) + 5 bytes per ES + 4 bytes (CRC)
+		uint16_t section_length = 9 + (5 * _track_list.size()) + 4;
+
+		*current++ = static_cast<uint8_t>(WellKnownTableId::PROGRAM_MAP_SECTION);
+		// section_syntax_indicator(1) '0'(1) reserved(2) section_length(12)
+		*current++ = static_cast<uint8_t>(0xB0 | ((section_length >> 8) & 0x0F));
+		*current++ = static_cast<uint8_t>(section_length & 0xFF);
+		// program_number(16)
+		*current++ = static_cast<uint8_t>(MPEGTS_PROGRAM_NUMBER >> 8);
+		*current++ = static_cast<uint8_t>(MPEGTS_PROGRAM_NUMBER & 0xFF);
+		// reserved(2) version_number(5) current_next_indicator(1)
+		*current++ = 0xC1;
+		// section_number(8), last_section_number(8)
+		*current++ = 0x00;
+		*current++ = 0x00;
+		// reserved(3) PCR_PID(13)
+		*current++ = static_cast<uint8_t>(0xE0 | ((_pcr_pid >> 8) & 0x1F));
+		*current++ = static_cast<uint8_t>(_pcr_pid & 0xFF);
+		// reserved(4) program_info_length(12)
+		*current++ = 0xF0;
+		*current++ = 0x00;
+
+		for (auto &track : _track_list)
+		{
+			// stream_type(8) reserved(3) elementary_PID(13) reserved(4) ES_info_length(12)
+			*current++ = static_cast<uint8_t>(track->stream_type);
+			*current++ = static_cast<uint8_t>(0xE0 | ((track->pid >> 8) & 0x1F));
+			*current++ = static_cast<uint8_t>(track->pid & 0xFF);
+			*current++ = 0xF0;
+			*current++ = 0x00;
+		}
+
+		current = WriteCrc32(current, section);
+
+		return WriteSection(MPEGTS_PMT_PID, _pmt_continuity_counter, section, current - section);
+	}
+
+	bool MpegTsPacketizer::WritePes(const std::shared_ptr<Track> &track, const PesChunk *chunks, size_t chunk_count, bool is_key_frame, int64_t pcr)
+	{
+		size_t remained = 0;
+
+		for (size_t index = 0; index < chunk_count; index++)
+		{
+			remained += chunks[index].length;
+		}
+
+		size_t chunk_index = 0;
+		size_t chunk_offset = 0;
+		bool is_first_packet = true;
+
+		while (remained > 0)
+		{
+			// Adaptation field: adaptation_field_length(8) + flags(8) + PCR(48)
+			size_t adaptation_field_length = 0;
+			bool write_pcr = is_first_packet && (pcr >= 0);
+			bool random_access = is_first_packet && is_key_frame;
+
+			if (write_pcr)
+			{
+				adaptation_field_length = 2 + 6;
+			}
+			else if (random_access)
+			{
+				adaptation_field_length = 2;
+			}
+
+			size_t payload_length = std::min(remained, MPEGTS_PACKET_PAYLOAD_SIZE - adaptation_field_length);
+
+			// If the remaining data doesn't fill the packet, pad the adaptation field with stuffing bytes
+			size_t stuffing_length = (MPEGTS_PACKET_PAYLOAD_SIZE - adaptation_field_length) - payload_length;
+			size_t total_adaptation_field_length = adaptation_field_length + stuffing_length;
+
+			auto buffer = AllocatePacket(track->pid, track->continuity_counter, is_first_packet, total_adaptation_field_length);
+
+			if (buffer == nullptr)
+			{
+				return false;
+			}
+
+			if (total_adaptation_field_length > 0)
+			{
+				auto adaptation_field_end = buffer + total_adaptation_field_length;
+
+				// adaptation_field_length doesn't include itself
+				*buffer++ = static_cast<uint8_t>(total_adaptation_field_length - 1);
+
+				if (total_adaptation_field_length > 1)
+				{
+					// discontinuity_indicator(1) random_access_indicator(1) elementary_stream_priority_indicator(1) PCR_flag(1) ...
+					*buffer++ = static_cast<uint8_t>((random_access ? 0x40 : 0x00) | (write_pcr ? 0x10 : 0x00));
+
+					if (write_pcr)
+					{
+						buffer = WritePcr(buffer, pcr);
+					}
+
+					::memset(buffer, 0xFF, adaptation_field_end - buffer);
+					buffer = adaptation_field_end;
+				}
+			}
+
+			// Copy the payload from the chunks
+			remained -= payload_length;
+
+			while (payload_length > 0)
+			{
+				auto &chunk = chunks[chunk_index];
+				auto copy_length = std::min(payload_length, chunk.length - chunk_offset);
+
+				::memcpy(buffer, chunk.data + chunk_offset, copy_length);
+
+				buffer += copy_length;
+				chunk_offset += copy_length;
+				payload_length -= copy_length;
+
+				if (chunk_offset == chunk.length)
+				{
+					chunk_index++;
+					chunk_offset = 0;
+				}
+			}
+
+			is_first_packet = false;
+		}
+
+		return true;
+	}
+
+	bool MpegTsPacketizer::WritePacket(const std::shared_ptr<const MediaPacket> &packet)
+	{
+		if (_segment_data == nullptr)
+		{
+			logte("Packetizer is not prepared");
+			return false;
+		}
+
+		std::shared_ptr<Track> track;
+
+		{
+			auto lock_guard = std::lock_guard(_track_mutex);
+			auto track_item = _track_map.find(packet->GetTrackId());
+
+			if (track_item == _track_map.end())
+			{
+				logte("Could not find the track: %d (%zu)", packet->GetTrackId(), _track_map.size());
+				return false;
+			}
+
+			track = track_item->second;
+		}
+
+		auto data = packet->GetData();
+
+		if ((data == nullptr) || data->IsEmpty())
+		{
+			return true;
+		}
+
+		auto es = data->GetDataAs<uint8_t>();
+		auto es_length = data->GetLength();
+		bool is_video = (track->media_track->GetMediaType() == cmn::MediaType::Video);
+
+		// Access unit delimiter, which is required by some players
+		static const uint8_t H264_AUD[] = {0x00, 0x00, 0x00, 0x01, 0x09, 0xF0};
+		static const uint8_t H265_AUD[] = {0x00, 0x00, 0x00, 0x01, 0x46, 0x01, 0x50};
+		const uint8_t *aud = nullptr;
+		size_t aud_length = 0;
+
+		switch (packet->GetBitstreamFormat())
+		{
+			case cmn::BitstreamFormat::H264_ANNEXB: {
+				auto start_code_size = GetStartCodeSize(es, es_length);
+
+				if ((start_code_size > 0) && (es_length > start_code_size) && ((es[start_code_size] & 0x1F) != 9))
+				{
+					aud = H264_AUD;
+					aud_length = sizeof(H264_AUD);
+				}
+				break;
+			}
+
+			case cmn::BitstreamFormat::H265_ANNEXB: {
+				auto start_code_size = GetStartCodeSize(es, es_length);
+
+				if ((start_code_size > 0) && (es_length > start_code_size) && (((es[start_code_size] >> 1) & 0x3F) != 35))
+				{
+					aud = H265_AUD;
+					aud_length = sizeof(H265_AUD);
+				}
+				break;
+			}
+
+			case cmn::BitstreamFormat::AAC_ADTS:
+				break;
+
+			default:
+				if (track->stream_type != WellKnownStreamTypes::MP3)
+				{
+					logte("Not supported bitstream format: %d", static_cast<int>(packet->GetBitstreamFormat()));
+					return false;
+				}
+				break;
+		}
+
+		auto pts = ConvertTimestamp(track->media_track, packet->GetPts());
+		auto dts = ConvertTimestamp(track->media_track, packet->GetDts());
+		bool has_dts = (pts != dts);
+
+		// PES header
+		uint8_t pes_header[MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + 10];
+		uint8_t header_data_length = has_dts ? 10 : 5;
+		size_t pes_header_length = MPEGTS_PES_HEADER_SIZE + MPEGTS_MIN_PES_OPTIONAL_HEADER_SIZE + header_data_length;
+		size_t pes_packet_length = (pes_header_length - MPEGTS_PES_HEADER_SIZE) + aud_length + es_length;
+
+		// PES_packet_length may be 0 only for video
+		if (is_video || (pes_packet_length > 0xFFFF))
+		{
+			pes_packet_length = 0;
+		}
+
+		auto current = pes_header;
+
+		// packet_start_code_prefix(24) stream_id(8) PES_packet_length(16)
+		*current++ = 0x00;
+		*current++ = 0x00;
+		*current++ = 0x01;
+		*current++ = track->stream_id;
+		*current++ = static_cast<uint8_t>(pes_packet_length >> 8);
+		*current++ = static_cast<uint8_t>(pes_packet_length & 0xFF);
+		// '10' PES_scrambling_control(2) PES_priority(1) data_alignment_indicator(1) copyright(1) original_or_copy(1)
+		*current++ = 0x84;
+		// PTS_DTS_flags(2) ESCR_flag(1) ES_rate_flag(1) DSM_trick_mode_flag(1) additional_copy_info_flag(1) PES_CRC_flag(1) PES_extension_flag(1)
+		*current++ = has_dts ? 0xC0 : 0x80;
+		*current++ = header_data_length;
+
+		if (has_dts)
+		{
+			current = WriteTimestamp(current, 0b0011, pts);
+			current = WriteTimestamp(current, 0b0001, dts);
+		}
+		else
+		{
+			current = WriteTimestamp(current, 0b0010, pts);
+		}
+
+		PesChunk chunks[3];
+		size_t chunk_count = 0;
+
+		chunks[chunk_count++] = {pes_header, pes_header_length};
+
+		if (aud != nullptr)
+		{
+			chunks[chunk_count++] = {aud, aud_length};
+		}
+
+		chunks[chunk_count++] = {es, es_length};
+
+		// PCR is written at the beginning of every PES of the PCR PID (satisfies the 100ms interval of ISO/IEC 13818-1)
+		int64_t pcr = -1LL;
+
+		if (track->pid == _pcr_pid)
+		{
+			pcr = std::max<int64_t>(dts - MPEGTS_PCR_DELAY, 0);
+		}
+
+		if (WritePes(track, chunks, chunk_count, packet->GetFlag() == MediaPacketFlag::Key, pcr) == false)
+		{
+			return false;
+		}
+
+		{
+			auto lock_guard = std::lock_guard(_track_mutex);
+
+			if (track->first_packet_received == false)
+			{
+				track->first_pts = packet->GetPts();
+				track->first_packet_received = true;
+			}
+
+			track->duration += packet->GetDuration();
+		}
+
+		return true;
+	}
+}  // namespace mpegts
@@ -0,0 +1,138 @@
+//==============================================================================
+//
+//  MPEGTS Packetizer
+//
+//  Created by Getroot
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/info/media_track.h>
+#include <base/mediarouter/media_buffer.h>
+#include <base/mediarouter/media_type.h>
+#include <base/ovlibrary/ovlibrary.h>
+
+#include "mpegts_packet.h"
+#include "mpegts_pes.h"
+#include "mpegts_section.h"
+
+#define MPEGTS_PACKET_HEADER_SIZE 4
+#define MPEGTS_PACKET_PAYLOAD_SIZE (MPEGTS_MIN_PACKET_SIZE - MPEGTS_PACKET_HEADER_SIZE)
+
+#define MPEGTS_PROGRAM_NUMBER 0x0001
+#define MPEGTS_TRANSPORT_STREAM_ID 0x0001
+#define MPEGTS_PMT_PID 0x1000
+// PID of the first elementary stream (the others are assigned sequentially)
+#define MPEGTS_FIRST_ES_PID 0x0100
+
+#define MPEGTS_TIMESCALE 90000
+// PCR precedes DTS by this value to give the decoder time to fill the buffer (Unit: 90kHz)
+#define MPEGTS_PCR_DELAY 63000
+
+// Capacity of the first segment buffer. Next buffers are allocated based on the size of the previous segment.
+#define MPEGTS_DEFAULT_SEGMENT_CAPACITY (1024 * 1024)
+
+/*  PES Packetization Process
+
+	(ES 1) -> [PES Header |                       ES                          ]
+
+	Packet 1: [TS Header][Adaptation field (PCR)][PES Header |    Payload     ] : payload_unit_start_indicator = 1
+	Packet 2: [TS Header][                    Payload                         ]
+	Packet 3: [TS Header][Adaptation field : stuffing][        Payload        ]
+
+	PAT/PMT are written at the beginning of every segment, so that each segment can be decoded independently.
+*/
+
+namespace mpegts
+{
+	// Muxes the media packets into MPEG-TS segments without FFmpeg.
+	// TS packets are written directly into the segment buffer, so the ES data is copied only once.
+	class MpegTsPacketizer
+	{
+	public:
+		MpegTsPacketizer() = default;
+		~MpegTsPacketizer() = default;
+
+		// Supported codecs: H.264, H.265 (Annex-B), AAC (ADTS), MP3
+		bool AddTrack(const std::shared_ptr<const MediaTrack> &media_track);
+
+		// Starts a new segment
+		bool Prepare();
+		bool PrepareIfNeeded();
+
+		bool WritePacket(const std::shared_ptr<const MediaPacket> &packet);
+
+		// Returns the segment, Prepare() must be called to write the next segment
+		std::shared_ptr<const ov::Data> Finalize();
+
+		// Get the packet pts of the track
+		// Unit: the timebase of the MediaTrack
+		int64_t GetFirstPts(uint32_t track_id) const;
+		// Get the packet pts by MediaType
+		// Unit: the timebase of the MediaTrack
+		int64_t GetFirstPts(cmn::MediaType type) const;
+
+		// Get the duration of the track
+		// Unit: the timebase of the MediaTrack
+		int64_t GetDuration(uint32_t track_id) const;
+
+	protected:
+		struct Track
+		{
+			void Reset()
+			{
+				duration = 0L;
+				first_pts = -1L;
+				first_packet_received = false;
+			}
+
+			std::shared_ptr<const MediaTrack> media_track;
+
+			uint16_t pid = 0;
+			uint8_t stream_id = 0;
+			WellKnownStreamTypes stream_type = WellKnownStreamTypes::H264;
+			// Continuity counter of the next packet (continues across segments)
+			uint8_t continuity_counter = 0;
+
+			// Unit: Timebase
+			int64_t duration = 0L;
+			int64_t first_pts = -1L;
+			bool first_packet_received = false;
+		};
+
+		// A part of PES packet (PES header, AUD, ES, ...)
+		struct PesChunk
+		{
+			const uint8_t *data;
+			size_t length;
+		};
+
+		// Allocates a TS packet at the end of the segment and fills the TS header
+		//
+		// @return The pointer next to the TS header (adaptation field or payload)
+		uint8_t *AllocatePacket(uint16_t pid, uint8_t &continuity_counter, bool payload_unit_start_indicator, size_t adaptation_field_length);
+
+		bool WritePat();
+		bool WritePmt();
+		bool WriteSection(uint16_t pid, uint8_t &continuity_counter, const uint8_t *section, size_t section_length);
+		bool WritePes(const std::shared_ptr<Track> &track, const PesChunk *chunks, size_t chunk_count, bool is_key_frame, int64_t pcr);
+
+		// Converts the timestamp from the timebase of the track to 90kHz
+		static int64_t ConvertTimestamp(const std::shared_ptr<const MediaTrack> &media_track, int64_t timestamp);
+
+		mutable std::mutex _track_mutex;
+		// Key: MediaPacket.GetTrackId()
+		std::map<int32_t, std::shared_ptr<Track>> _track_map;
+		std::vector<std::shared_ptr<Track>> _track_list;
+
+		// PID of the track that carries PCR (video if available)
+		uint16_t _pcr_pid = static_cast<uint16_t>(WellKnownPacketId::NULL_PACKET);
+
+		uint8_t _pat_continuity_counter = 0;
+		uint8_t _pmt_continuity_counter = 0;
+
+		std::shared_ptr<ov::Data> _segment_data;
+		size_t _last_segment_length = 0;
+	};
+}  // namespace mpegts
@@ -0,0 +1,55 @@
+#include "remb.h"
+#include "rtcp_private.h"
+#include <base/ovlibrary/byte_io.h>
+
+#define REMB_IDENTIFIER_OFFSET	8
+
+bool Remb::IsRemb(const RtcpPacket &packet)
+{
+	if(packet.GetPayloadSize() < REMB_IDENTIFIER_OFFSET + 4)
+	{
+		return false;
+	}
+
+	return ::memcmp(packet.GetPayload() + REMB_IDENTIFIER_OFFSET, "REMB", 4) == 0;
+}
+
+bool Remb::Parse(const RtcpPacket &packet)
+{
+	const uint8_t *payload = packet.GetPayload();
+	size_t payload_size = packet.GetPayloadSize();
+
+	if((payload_size < static_cast<size_t>(8/*SSRC * 2*/ + 4/*REMB*/ + 4/*Num SSRC, BR*/)) || (IsRemb(packet) == false))
+	{
+		logtd("Invalid REMB packet");
+		return false;
+	}
+
+	_src_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[0]);
+
+	uint8_t ssrc_count = payload[12];
+	uint8_t exponent = payload[13] >> 2;
+	uint32_t mantissa = (static_cast<uint32_t>(payload[13] & 0x03) << 16) | ByteReader<uint16_t>::ReadBigEndian(&payload[14]);
+
+	_bitrate = static_cast<uint64_t>(mantissa) << exponent;
+
+	size_t offset = 16;
+	for(uint8_t i = 0; (i < ssrc_count) && (offset + 4 <= payload_size); i++)
+	{
+		_ssrcs.push_back(ByteReader<uint32_t>::ReadBigEndian(&payload[offset]));
+		offset += 4;
+	}
+
+	return true;
+}
+
+// RtcpInfo must provide raw data
+std::shared_ptr<ov::Data> Remb::GetData() const
+{
+	return nullptr;
+}
+
+void Remb::DebugPrint()
+{
+	logtd("REMB >> bitrate(%" PRIu64 ") ssrcs(%zu)", _bitrate, _ssrcs.size());
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "base/ovlibrary/ovlibrary.h"
+#include "rtcp_info.h"
+#include "../rtcp_packet.h"
+
+// Receiver Estimated Maximum Bitrate (draft-alvestrand-rmcat-remb-03)
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |V=2|P| FMT=15  |   PT=206      |             length            |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 0 |                  SSRC of packet sender                        |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 4 |                  SSRC of media source (0)                     |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 8 |  Unique identifier 'R' 'E' 'M' 'B'                            |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 12|  Num SSRC     | BR Exp    |  BR Mantissa                      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 16|   SSRC feedback                                               |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |  ...                                                          |
+
+class Remb : public RtcpInfo
+{
+public:
+	// Whether the application layer feedback (PSFB, FMT=15) is REMB
+	static bool IsRemb(const RtcpPacket &packet);
+
+	///////////////////////////////////////////
+	// Implement RtcpInfo virtual functions
+	///////////////////////////////////////////
+	bool Parse(const RtcpPacket &packet) override;
+	// RtcpInfo must provide raw data
+	std::shared_ptr<ov::Data> GetData() const override;
+	void DebugPrint() override;
+
+	// RtcpInfo must provide packet type
+	RtcpPacketType GetPacketType() const override
+	{
+		return RtcpPacketType::PSFB;
+	}
+
+	// If the packet type is one of the feedback messages (205, 206) child must provide fmt(format)
+	uint8_t GetCountOrFmt() const override
+	{
+		return static_cast<uint8_t>(PSFBFMT::AFB);
+	}
+
+	uint32_t GetSrcSsrc() const {return _src_ssrc;}
+	// Unit: bits per second
+	uint64_t GetBitrate() const {return _bitrate;}
+	const std::vector<uint32_t> &GetSsrcs() const {return _ssrcs;}
+
+private:
+	uint32_t	_src_ssrc = 0;
+	uint64_t	_bitrate = 0;
+	std::vector<uint32_t> _ssrcs;
+};
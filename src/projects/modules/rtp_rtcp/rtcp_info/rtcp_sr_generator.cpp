@@ -8,6 +8,11 @@ RtcpSRGenerator::RtcpSRGenerator(uint32_t ssrc)
     _last_generated_time = std::chrono::system_clock::now();
 }
 
+uint32_t RtcpSRGenerator::GetSsrc() const
+{
+	return _ssrc;
+}
+
 void RtcpSRGenerator::AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet)
 {
     _packet_count ++;
@@ -9,6 +9,8 @@ class RtcpSRGenerator
 public:
     RtcpSRGenerator(uint32_t ssrc);
 
+	uint32_t GetSsrc() const;
+
 	void AddRTPPacketAndGenerateRtcpSR(const RtpPacket &rtp_packet);
 	bool IsAvailableRtcpSRPacket() const;
 	std::shared_ptr<RtcpPacket>   PopRtcpSRPacket();
@@ -0,0 +1,154 @@
+#include "transport_cc.h"
+#include "rtcp_private.h"
+#include <base/ovlibrary/byte_io.h>
+
+enum class TransportCcStatus : uint8_t
+{
+	NotReceived = 0,
+	SmallDelta = 1,
+	LargeDelta = 2,
+	Reserved = 3
+};
+
+bool TransportCc::Parse(const RtcpPacket &packet)
+{
+	const uint8_t *payload = packet.GetPayload();
+	size_t payload_size = packet.GetPayloadSize();
+
+	if(payload_size < static_cast<size_t>(8/*SSRC * 2*/ + 8/*base seq, status count, reference time, fb pkt count*/))
+	{
+		logtd("Payload is too small to parse transport-cc feedback");
+		return false;
+	}
+
+	_src_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[0]);
+	_media_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[4]);
+
+	auto base_sequence_number = ByteReader<uint16_t>::ReadBigEndian(&payload[8]);
+	auto packet_status_count = ByteReader<uint16_t>::ReadBigEndian(&payload[10]);
+
+	// 24 bits signed
+	int32_t reference_time = static_cast<int32_t>(ByteReader<uint32_t>::ReadBigEndian(&payload[12]) >> 8);
+	if(reference_time & 0x800000)
+	{
+		reference_time -= 0x1000000;
+	}
+	_feedback_packet_count = payload[15];
+
+	size_t offset = 16;
+
+	// Packet status chunks
+	std::vector<TransportCcStatus> statuses;
+	statuses.reserve(packet_status_count);
+
+	while(statuses.size() < packet_status_count)
+	{
+		if(offset + 2 > payload_size)
+		{
+			logtd("Invalid transport-cc feedback : packet chunks are truncated");
+			return false;
+		}
+
+		auto chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[offset]);
+		offset += 2;
+
+		size_t remaining = packet_status_count - statuses.size();
+
+		if((chunk & 0x8000) == 0)
+		{
+			// Run length chunk
+			auto status = static_cast<TransportCcStatus>((chunk >> 13) & 0x03);
+			size_t run_length = std::min<size_t>(chunk & 0x1FFF, remaining);
+
+			statuses.insert(statuses.end(), run_length, status);
+		}
+		else if((chunk & 0x4000) == 0)
+		{
+			// Status vector chunk with 14 1-bit symbols
+			for(int index = 13; (index >= 0) && (remaining > 0); index--, remaining--)
+			{
+				statuses.push_back(static_cast<TransportCcStatus>((chunk >> index) & 0x01));
+			}
+		}
+		else
+		{
+			// Status vector chunk with 7 2-bit symbols
+			for(int index = 6; (index >= 0) && (remaining > 0); index--, remaining--)
+			{
+				statuses.push_back(static_cast<TransportCcStatus>((chunk >> (index * 2)) & 0x03));
+			}
+		}
+	}
+
+	// Receive deltas
+	int64_t arrival_time_us = static_cast<int64_t>(reference_time) * TRANSPORT_CC_REFERENCE_TIME_UNIT_US;
+	uint16_t sequence_number = base_sequence_number;
+
+	_packet_feedbacks.clear();
+	_packet_feedbacks.reserve(statuses.size());
+
+	for(auto status : statuses)
+	{
+		PacketFeedback feedback;
+
+		feedback.sequence_number = sequence_number++;
+
+		switch(status)
+		{
+			case TransportCcStatus::SmallDelta:
+				if(offset + 1 > payload_size)
+				{
+					logtd("Invalid transport-cc feedback : receive deltas are truncated");
+					return false;
+				}
+
+				arrival_time_us += static_cast<int64_t>(payload[offset]) * TRANSPORT_CC_DELTA_UNIT_US;
+				offset += 1;
+				break;
+
+			case TransportCcStatus::LargeDelta:
+				if(offset + 2 > payload_size)
+				{
+					logtd("Invalid transport-cc feedback : receive deltas are truncated");
+					return false;
+				}
+
+				arrival_time_us += static_cast<int64_t>(static_cast<int16_t>(ByteReader<uint16_t>::ReadBigEndian(&payload[offset]))) * TRANSPORT_CC_DELTA_UNIT_US;
+				offset += 2;
+				break;
+
+			case TransportCcStatus::NotReceived:
+			case TransportCcStatus::Reserved:
+				_packet_feedbacks.push_back(feedback);
+				continue;
+		}
+
+		feedback.received = true;
+		feedback.arrival_time_us = arrival_time_us;
+
+		_packet_feedbacks.push_back(feedback);
+	}
+
+	return true;
+}
+
+// RtcpInfo must provide raw data
+std::shared_ptr<ov::Data> TransportCc::GetData() const
+{
+	return nullptr;
+}
+
+void TransportCc::DebugPrint()
+{
+	size_t received_count = 0;
+
+	for(const auto &feedback : _packet_feedbacks)
+	{
+		if(feedback.received)
+		{
+			received_count++;
+		}
+	}
+
+	logtd("TransportCc >> fb pkt count(%u) packets(%zu) received(%zu)", _feedback_packet_count, _packet_feedbacks.size(), received_count);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "base/ovlibrary/ovlibrary.h"
+#include "rtcp_info.h"
+#include "../rtcp_packet.h"
+
+// Transport-wide Congestion Control feedback (draft-holmer-rmcat-transport-wide-cc-extensions-01)
+//
+//    0                   1                   2                   3
+//    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |V=2|P|  FMT=15 |    PT=205     |           length              |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 0 |                     SSRC of packet sender                     |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 4 |                      SSRC of media source                     |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 8 |      base sequence number     |      packet status count      |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 12|                 reference time                | fb pkt. count |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// 16|          packet chunk         |         packet chunk          |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   .                                                               .
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   |         packet chunk          |  recv delta   |  recv delta   |
+//   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//   .                                                               .
+//
+// - Reference time: 24 bits signed, unit: 64ms
+// - Packet chunk: Run length chunk (0|S(2)|Run length(13)) or Status vector chunk (1|S|symbols(14))
+// - Recv delta: 8 bits unsigned (small delta) or 16 bits signed (large delta), unit: 250us
+
+#define TRANSPORT_CC_REFERENCE_TIME_UNIT_US	64000
+#define TRANSPORT_CC_DELTA_UNIT_US			250
+
+class TransportCc : public RtcpInfo
+{
+public:
+	struct PacketFeedback
+	{
+		uint16_t sequence_number = 0;
+		bool received = false;
+		// Arrival time at the receiver, only the differences between the packets are meaningful (Unit: microseconds)
+		int64_t arrival_time_us = 0;
+	};
+
+	///////////////////////////////////////////
+	// Implement RtcpInfo virtual functions
+	///////////////////////////////////////////
+	bool Parse(const RtcpPacket &packet) override;
+	// RtcpInfo must provide raw data
+	std::shared_ptr<ov::Data> GetData() const override;
+	void DebugPrint() override;
+
+	// RtcpInfo must provide packet type
+	RtcpPacketType GetPacketType() const override
+	{
+		return RtcpPacketType::RTPFB;
+	}
+
+	// If the packet type is one of the feedback messages (205, 206) child must provide fmt(format)
+	uint8_t GetCountOrFmt() const override
+	{
+		return static_cast<uint8_t>(RTPFBFMT::TRANSPORT_CC);
+	}
+
+	uint32_t GetSrcSsrc() const {return _src_ssrc;}
+	uint32_t GetMediaSsrc() const {return _media_ssrc;}
+	uint8_t GetFeedbackPacketCount() const {return _feedback_packet_count;}
+
+	// In the order of the sequence number
+	const std::vector<PacketFeedback> &GetPacketFeedbacks() const {return _packet_feedbacks;}
+
+private:
+	uint32_t	_src_ssrc = 0;
+	uint32_t	_media_ssrc = 0;
+	uint8_t		_feedback_packet_count = 0;
+
+	std::vector<PacketFeedback> _packet_feedbacks;
+};
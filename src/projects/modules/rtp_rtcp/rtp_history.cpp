@@ -1,65 +1,52 @@
 #include "rtp_history.h"
 
-RtpHistory::RtpHistory(uint8_t origin_payload_type, uint8_t rtx_payload_type, uint32_t rtx_ssrc, uint32_t max_history_size)
+RtpHistory::RtpHistory(uint8_t origin_payload_type, uint8_t rtx_payload_type, uint32_t rtx_ssrc)
+	: _history(RTP_HISTORY_CAPACITY)
 {
 	_origin_paylod_type = origin_payload_type;
 	_rtx_paylod_type = rtx_payload_type;
 	_rtx_ssrc = rtx_ssrc;
-	_max_history_size = max_history_size;
-
-	_history.reserve(_max_history_size);
 }
 
-// Converting to RtxRtpPacket
 bool RtpHistory::StoreRtpPacket(const std::shared_ptr<RtpPacket> &packet)
 {
-	std::lock_guard<std::shared_mutex> guard(_history_lock);
+	auto &slot = _history[GetIndex(packet->SequenceNumber())];
+	auto old_packet = packet;
+
+	while (slot.lock.test_and_set(std::memory_order_acquire))
+	{
+	}
+
+	slot.packet.swap(old_packet);
 
-	_history[GetIndex(packet->SequenceNumber())] = packet;
+	slot.lock.clear(std::memory_order_release);
 
+	// The overwritten packet is released outside of the lock
 	return true;
 }
 
-std::shared_ptr<RtxRtpPacket> RtpHistory::GetRtxRtpPacket(uint16_t seq_no)
+std::shared_ptr<RtpPacket> RtpHistory::GetRtpPacket(uint16_t seq_no)
 {
-	auto index = GetIndex(seq_no);
-	// First, look in the cache
-	std::shared_lock<std::shared_mutex> cache_guard(_history_cache_lock);
-	auto cache_item = _history_cache.find(index);
-	if(cache_item != _history_cache.end())
+	auto &slot = _history[GetIndex(seq_no)];
+	std::shared_ptr<RtpPacket> rtp_packet;
+
+	while (slot.lock.test_and_set(std::memory_order_acquire))
 	{
-		// Found!
-		auto rtx_packet = cache_item->second;
-		
-		if(rtx_packet->GetOriginalSequenceNumber() == seq_no)// && ov::Clock::GetElapsedMiliSecondsFromNow(rtx_packet->GetCreatedTime()) < VALID_TIME_MS_STORED_RTP_PACKET)
-		{
-			return rtx_packet;
-		}
 	}
-	cache_guard.unlock();
 
-	// find in rtp history
-	std::shared_lock<std::shared_mutex> history_guard(_history_lock);
-	auto rtp_item = _history.find(index);
-	if(rtp_item != _history.end())
-	{
-		auto rtp_packet = rtp_item->second;
-		history_guard.unlock();
+	rtp_packet = slot.packet;
+
+	slot.lock.clear(std::memory_order_release);
 
-		// now, I consider all requests are valid because webrtc player doesn't ask for too old packet anyway 
-		//auto elapsed_ms = ov::Clock::GetElapsedMiliSecondsFromNow(rtp_packet->GetCreatedTime());
-		//if(elapsed_ms < VALID_TIME_MS_STORED_RTP_PACKET)
-		if(rtp_packet->SequenceNumber() == seq_no)
-		{
-			// Create Rtx Packet and store it
-			auto rtx_packet = std::make_shared<RtxRtpPacket>(GetRtxSsrc(), GetRtxPayloadType(), *rtp_packet);
-			cache_guard.lock();
-			_history_cache[index] = rtx_packet;
-			return rtx_packet;
-		}
+	// now, I consider all requests are valid because webrtc player doesn't ask for too old packet anyway
+	//auto elapsed_ms = ov::Clock::GetElapsedMiliSecondsFromNow(rtp_packet->GetCreatedTime());
+	//if(elapsed_ms < VALID_TIME_MS_STORED_RTP_PACKET)
+	if ((rtp_packet == nullptr) || (rtp_packet->SequenceNumber() != seq_no))
+	{
+		return nullptr;
 	}
 
-	return nullptr;
+	return rtp_packet;
 }
 
 uint8_t	RtpHistory::GetOriginPayloadType()
@@ -76,8 +63,3 @@ uint8_t RtpHistory::GetRtxPayloadType()
 {
 	return _rtx_paylod_type;
 }
-
-uint16_t RtpHistory::GetIndex(uint16_t seq_no)
-{
-	return seq_no % _max_history_size;
-}
\ No newline at end of file
@@ -3,50 +3,52 @@
 #include <base/ovlibrary/ovlibrary.h>
 #include "rtx_rtp_packet.h"
 
-// WebRTC-Native-Code uses 9600 value
-#define DEFAULT_MAX_HISTORY_CAPACITY	1500
+// The number of packets kept in the history. It must be a power of two that divides 65536,
+// so that the slot of a sequence number doesn't change when the sequence number wraps around.
+// (WebRTC-Native-Code keeps 9600 packets)
+#define RTP_HISTORY_CAPACITY			2048
 // Stored RTP packet is only valid for 3 second after being created
 #define VALID_TIME_MS_STORED_RTP_PACKET	3000
 
+static_assert((RTP_HISTORY_CAPACITY & (RTP_HISTORY_CAPACITY - 1)) == 0, "RTP_HISTORY_CAPACITY must be a power of two");
+
+// Keeps the last RTP packets of a payload type for retransmission.
+//
+// The packets are stored in a fixed-size ring indexed by the sequence number.
+// Only the stream stores the packets, and the sessions look up the packets without taking a lock of the history.
+// Each slot is guarded by its own spinlock instead, which is held only to copy the shared_ptr,
+// so the sessions contend with the stream only when they request the packet being overwritten.
+// (This is not lock-free, but std::atomic_load() of shared_ptr is not lock-free either:
+// libstdc++ guards it with a global pool of mutexes shared by all streams)
 class RtpHistory
 {
 public:
-	RtpHistory(uint8_t origin_payload_type, uint8_t rtx_payload_type, uint32_t rtx_ssrc, uint32_t max_history_size = DEFAULT_MAX_HISTORY_CAPACITY);
+	RtpHistory(uint8_t origin_payload_type, uint8_t rtx_payload_type, uint32_t rtx_ssrc);
 
-	// Converting to RtxRtpPacket
 	bool StoreRtpPacket(const std::shared_ptr<RtpPacket> &packet);
-	std::shared_ptr<RtxRtpPacket> GetRtxRtpPacket(uint16_t seq_no);
+	// @return The original packet, nullptr if it has been overwritten by a newer packet.
+	// The session converts the packet into RtxRtpPacket, since only a few of the packets are requested with NACK.
+	std::shared_ptr<RtpPacket> GetRtpPacket(uint16_t seq_no);
 
 	uint8_t	GetOriginPayloadType();
 	uint32_t GetRtxSsrc();
 	uint8_t GetRtxPayloadType();
 
 private:
-	uint16_t GetIndex(uint16_t seq_no);
-	
-	// This map maps a hash(made with "origin sequence number" % max_history_size) and an RtpPacket.
-	// And this map never erases items for performance reason. 
-
-	// Yes, this map will have a collision once per max_history_size. 
-	// However, the default value of 9600 is a very large value, and collision packets 
-	// with 9600 sequence number differences are very old packets. 
-	// Since RTP packets have a creation time, old packets may not be used. 
-	// This can avoid collision. Therefore, set max_history_size to a large value as possible.
-	std::shared_mutex	_history_lock;
-	std::unordered_map<uint16_t, std::shared_ptr<RtpPacket>> _history;
-
-	// Creating RtxRtpPacket requires computing resources, but not all of them are used
-	// (only for packets requested by the session with NACK). 
-	// Therefore, it is unnecessary to create all packets with RtxRtpPacket in advance. 
-	// It is also wasteful to create another RtxRtpPacket once created. 
-	// When GetRtxRtpPacket() is called, it first looks for a packet in the cache and 
-	// checks if it is valid (by creation time). 
-	// If it is not valid, a new RtxRtpPacket is created, cached, and returned.
-	std::shared_mutex	_history_cache_lock;
-	std::unordered_map<uint16_t, std::shared_ptr<RtxRtpPacket>> _history_cache;
+	static uint16_t GetIndex(uint16_t seq_no)
+	{
+		return seq_no & (RTP_HISTORY_CAPACITY - 1);
+	}
+
+	struct Slot
+	{
+		std::atomic_flag lock = ATOMIC_FLAG_INIT;
+		std::shared_ptr<RtpPacket> packet;
+	};
+
+	std::vector<Slot> _history;
 
 	uint8_t		_origin_paylod_type;
 	uint32_t	_rtx_ssrc;
 	uint8_t		_rtx_paylod_type;
-	uint32_t	_max_history_size;
-};
\ No newline at end of file
+};
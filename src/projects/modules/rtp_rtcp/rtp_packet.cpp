@@ -37,6 +37,7 @@ RtpPacket::RtpPacket(RtpPacket &src)
 	_marker = src._marker;
 	_payload_type = src._payload_type;
 	_origin_payload_type = src._origin_payload_type;
+	_key_frame_start = src._key_frame_start;
 	_ssrc = src._ssrc;
 	_payload_offset = src._payload_offset;
 	_payload_size = src._payload_size;
@@ -202,6 +203,11 @@ uint8_t RtpPacket::OriginPayloadType() const
 	return _origin_payload_type;
 }
 
+bool RtpPacket::IsKeyFrameStart() const
+{
+	return _key_frame_start;
+}
+
 uint16_t RtpPacket::SequenceNumber() const
 {
 	return _sequence_number;
@@ -261,6 +267,11 @@ void RtpPacket::SetUlpfec(bool is_fec, uint8_t origin_payload_type)
 	_origin_payload_type = origin_payload_type;
 }
 
+void RtpPacket::SetKeyFrameStart(bool key_frame_start)
+{
+	_key_frame_start = key_frame_start;
+}
+
 void RtpPacket::SetSequenceNumber(uint16_t seq_no)
 {
 	_sequence_number = seq_no;
@@ -135,6 +135,8 @@ bool RtpPacketizer::PacketizeVideo(cmn::MediaCodecId video_type,
 			return false;
 		}
 
+		packet->SetKeyFrameStart((i == 0) && (frame_type == FrameType::VideoFrameKey));
+
 		_rtp_packet_count ++;
 		_stream->OnRtpPacketized(packet);
 
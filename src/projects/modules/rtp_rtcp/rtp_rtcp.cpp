@@ -26,6 +26,17 @@ bool RtpRtcp::AddRtcpSRGenerator(uint8_t payload_type, uint32_t ssrc)
 		return false;
 	}
 
+	// The payload types that share an SSRC (e.g. the renditions that a session switches between) share the SR state,
+	// so the packet/octet counts in the SR describe the SSRC as the receiver sees it
+	for(auto &item : _rtcp_sr_generators)
+	{
+		if(item.second->GetSsrc() == ssrc)
+		{
+			_rtcp_sr_generators[payload_type] = item.second;
+			return true;
+		}
+	}
+
 	_rtcp_sr_generators[payload_type] = std::make_shared<RtcpSRGenerator>(ssrc);
 	return true;
 }
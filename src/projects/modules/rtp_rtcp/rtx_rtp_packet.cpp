@@ -8,29 +8,44 @@ RtxRtpPacket::RtxRtpPacket(uint32_t rtx_ssrc, uint8_t rtx_payload_type, const Rt
 
 bool RtxRtpPacket::PackageAsRtx(uint32_t rtx_ssrc, uint8_t rtx_payload_type, const RtpPacket &src)
 {
+	auto headers_size = src.HeadersSize();
+
+	if ((headers_size + RTX_HEADER_SIZE + src.PayloadSize()) > _data->GetCapacity())
+	{
+		_data->Reserve(headers_size + RTX_HEADER_SIZE + src.PayloadSize());
+	}
+
+	// Copy the headers of the original packet (including CSRCs and extensions)
+	_data->SetLength(headers_size + RTX_HEADER_SIZE);
+	_buffer = _data->GetWritableDataAs<uint8_t>();
+	::memcpy(_buffer, src.Header(), headers_size);
+
+	// The padding of the original packet is not retransmitted
+	_buffer[0] = _buffer[0] & 0xDF;
+	_padding_size = 0;
+	_extension_size = src.ExtensionSize();
+
 	SetMarker(src.Marker());
 	// replace with rtx payload type
-	_origin_payload_type = PayloadType();
+	_origin_payload_type = src.PayloadType();
 	SetPayloadType(rtx_payload_type);
+	SetSequenceNumber(src.SequenceNumber());
 	SetSsrc(rtx_ssrc);
 	SetTimestamp(src.Timestamp());
 
-	_payload_offset = src.HeadersSize();
-	_payload_size = src.PayloadSize();
-	_padding_size = src.PaddingSize();
-	_extension_size = src.ExtensionSize();
-
 	// Put OSN
 	_origin_seq_no = src.SequenceNumber();
-	_payload_offset = _payload_offset + RTX_HEADER_SIZE;
-	_data->SetLength(_payload_offset);
-	_buffer = _data->GetWritableDataAs<uint8_t>();
+	_payload_offset = headers_size + RTX_HEADER_SIZE;
 
-	// Write payload type at the end of the rtp header
+	// Write original sequence number at the end of the rtp header
 	ByteWriter<uint16_t>::WriteBigEndian(&_buffer[_payload_offset - RTX_HEADER_SIZE], _origin_seq_no);
 
 	// Copy payload
-	SetPayload(src.Payload(), src.PayloadSize());
+	return SetPayload(src.Payload(), src.PayloadSize());
+}
 
-	return true;
+void RtxRtpPacket::SetOriginalSequenceNumber(uint16_t seq_no)
+{
+	_origin_seq_no = seq_no;
+	ByteWriter<uint16_t>::WriteBigEndian(&_buffer[_payload_offset - RTX_HEADER_SIZE], _origin_seq_no);
 }
\ No newline at end of file
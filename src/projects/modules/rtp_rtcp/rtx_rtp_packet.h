@@ -21,8 +21,16 @@
 class RtxRtpPacket : public RtpPacket
 {
 public:
+	// Creates an empty packet, which is filled by PackageAsRtx() later
+	RtxRtpPacket() = default;
 	RtxRtpPacket(uint32_t rtx_ssrc, uint8_t rtx_payload_type, const RtpPacket &src);
 
+	// Fills the packet with src. The buffer of the packet is reused, so a packet can be used for many retransmissions.
+	bool PackageAsRtx(uint32_t rtx_ssrc, uint8_t rtx_payload_type, const RtpPacket &src);
+
+	// Overwrites OSN, used when the sequence number of the original packet was rewritten for the session
+	void SetOriginalSequenceNumber(uint16_t seq_no);
+
 	uint8_t GetOriginalPayloadType()
 	{
 		return _origin_payload_type;
@@ -32,8 +40,6 @@ public:
 		return _origin_seq_no;
 	}
 private:
-	bool PackageAsRtx(uint32_t rtx_ssrc, uint8_t rtx_payload_type, const RtpPacket &src);
-
-	uint8_t		_origin_payload_type; // related(original) payload type
-	uint16_t	_origin_seq_no; // original sequence number
+	uint8_t		_origin_payload_type = 0; // related(original) payload type
+	uint16_t	_origin_seq_no = 0; // original sequence number
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "transport_cc_rtp_packet.h"
+#include <base/ovlibrary/byte_io.h>
+
+#define RTP_EXTENSION_HEADER_SIZE	4
+// ID/L (1 byte) + sequence number (2 bytes)
+#define TRANSPORT_CC_ELEMENT_SIZE	3
+
+bool TransportCcRtpPacket::Package(const RtpPacket &src, uint8_t extension_id, uint16_t transport_sequence_number)
+{
+	const uint8_t *src_header = src.Header();
+	uint8_t cc = src_header[0] & 0x0F;
+	bool src_has_extension = (src_header[0] & 0x10) != 0;
+	size_t csrcs_end = FIXED_HEADER_SIZE + (cc * 4);
+
+	// One-byte header extension elements of src
+	const uint8_t *src_elements = nullptr;
+	size_t src_elements_size = 0;
+
+	if(src_has_extension)
+	{
+		if(ByteReader<uint16_t>::ReadBigEndian(&src_header[csrcs_end]) != ONE_BYTE_EXTENSION_ID)
+		{
+			return false;
+		}
+
+		src_elements = &src_header[csrcs_end + RTP_EXTENSION_HEADER_SIZE];
+		src_elements_size = src.ExtensionSize();
+	}
+
+	size_t elements_size = src_elements_size + ((extension_id != 0) ? TRANSPORT_CC_ELEMENT_SIZE : 0);
+	// Padded to 32 bits
+	size_t extension_size = (elements_size + 3) & ~static_cast<size_t>(3);
+	bool has_extension = extension_size > 0;
+	size_t headers_size = csrcs_end + (has_extension ? (RTP_EXTENSION_HEADER_SIZE + extension_size) : 0);
+
+	if(headers_size + src.PayloadSize() > _data->GetCapacity())
+	{
+		_data->Reserve(headers_size + src.PayloadSize());
+	}
+
+	_data->SetLength(headers_size);
+	_buffer = _data->GetWritableDataAs<uint8_t>();
+
+	// Fixed header and CSRCs
+	::memcpy(_buffer, src_header, csrcs_end);
+
+	// The padding of src is not copied
+	_buffer[0] = _buffer[0] & 0xDF;
+
+	if(has_extension)
+	{
+		_buffer[0] = _buffer[0] | 0x10;
+
+		uint8_t *extension = &_buffer[csrcs_end];
+
+		ByteWriter<uint16_t>::WriteBigEndian(&extension[0], ONE_BYTE_EXTENSION_ID);
+		ByteWriter<uint16_t>::WriteBigEndian(&extension[2], static_cast<uint16_t>(extension_size / 4));
+
+		uint8_t *element = &extension[RTP_EXTENSION_HEADER_SIZE];
+
+		if(src_elements_size > 0)
+		{
+			::memcpy(element, src_elements, src_elements_size);
+			element += src_elements_size;
+		}
+
+		if(extension_id != 0)
+		{
+			// L is the length minus one
+			element[0] = static_cast<uint8_t>((extension_id << 4) | (2 - 1));
+			ByteWriter<uint16_t>::WriteBigEndian(&element[1], transport_sequence_number);
+			element += TRANSPORT_CC_ELEMENT_SIZE;
+		}
+
+		::memset(element, 0, extension_size - elements_size);
+	}
+	else
+	{
+		_buffer[0] = _buffer[0] & 0xEF;
+	}
+
+	_has_padding = false;
+	_padding_size = 0;
+	_has_extension = has_extension;
+	_extension_size = extension_size;
+	_cc = cc;
+	_marker = src.Marker();
+	_payload_type = src.PayloadType();
+	_sequence_number = src.SequenceNumber();
+	_timestamp = src.Timestamp();
+	_ssrc = src.Ssrc();
+	SetUlpfec(src.IsUlpfec(), src.OriginPayloadType());
+	SetKeyFrameStart(src.IsKeyFrameStart());
+
+	_payload_offset = headers_size;
+
+	return SetPayload(src.Payload(), src.PayloadSize());
+}
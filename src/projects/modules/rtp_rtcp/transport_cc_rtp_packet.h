@@ -0,0 +1,29 @@
+#pragma once
+
+#include "rtp_packet.h"
+
+// Transport-wide sequence number header extension (draft-holmer-rmcat-transport-wide-cc-extensions-01)
+//
+//     0                   1                   2                   3
+//     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |       0xBE    |    0xDE       |           length=1            |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//    |  ID   | L=1   |transport-wide sequence number | zero padding  |
+//    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+#define TRANSPORT_CC_EXTENSION_URI		"http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01"
+#define TRANSPORT_CC_EXTENSION_ID		3
+
+// The RTP packets of a stream are shared by all sessions.
+// A session copies a packet into this packet to put its own transport-wide sequence number (or to rewrite the sequence number),
+// and the buffer is reused for the next packet.
+class TransportCcRtpPacket : public RtpPacket
+{
+public:
+	TransportCcRtpPacket() = default;
+
+	// @param extension_id 0 if the packet is copied without the transport-wide sequence number
+	// @return false if the extension can't be added (src has a two-byte header extension)
+	bool Package(const RtpPacket &src, uint8_t extension_id, uint16_t transport_sequence_number);
+};
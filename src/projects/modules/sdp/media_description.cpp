@@ -77,6 +77,11 @@ bool MediaDescription::UpdateData(ov::String &sdp)
 		sdp.AppendFormat("a=rtcp-mux\r\n");
 	}
 
+	for(auto &extmap : _extmap)
+	{
+		sdp.AppendFormat("a=extmap:%d %s\r\n", extmap.first, extmap.second.CStr());
+	}
+
 	if(_msid_appdata.IsEmpty() == false)
 	{
 		sdp.AppendFormat("a=msid:%s %s\r\n", _msid.CStr(), _msid_appdata.CStr());
@@ -110,7 +115,7 @@ bool MediaDescription::UpdateData(ov::String &sdp)
 
 		if(payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::GoogRemb))
 		{
-			sdp.AppendFormat("a=rtcp-fb:%d goog_remb\r\n", payload_id);
+			sdp.AppendFormat("a=rtcp-fb:%d goog-remb\r\n", payload_id);
 		}
 		if(payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::TransportCc))
 		{
@@ -355,6 +360,20 @@ bool MediaDescription::ParsingMediaLine(char type, std::string content)
 					EnableRtcpFb(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str(), true);
 				}
 			}
+			else if(content.compare(0, OV_COUNTOF("ext") - 1, "ext") == 0)
+			{
+				// a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+				if(std::regex_search(content, matches, std::regex("^extmap:(\\d+)(?:\\/\\S+)? (\\S+)")))
+				{
+					if(matches.size() != 2 + 1)
+					{
+						parsing_error = true;
+						break;
+					}
+
+					AddExtmap(static_cast<uint8_t>(std::stoul(matches[1])), std::string(matches[2]).c_str());
+				}
+			}
 			else if(content.compare(0, OV_COUNTOF("mid") - 1, "mid") == 0)
 			{
 				// a=mid:video,
@@ -578,6 +597,11 @@ std::shared_ptr<const PayloadAttr> MediaDescription::GetFirstPayload() const
 	return nullptr;
 }
 
+const std::vector<std::shared_ptr<PayloadAttr>> &MediaDescription::GetPayloadList() const
+{
+	return _payload_list;
+}
+
 // a=rtcp-mux
 void MediaDescription::UseRtcpMux(bool flag)
 {
@@ -756,6 +780,25 @@ bool MediaDescription::AddRtpmap(uint8_t payload_type, const ov::String &codec,
 	return true;
 }
 
+// a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+void MediaDescription::AddExtmap(uint8_t id, const ov::String &uri)
+{
+	_extmap[id] = uri;
+}
+
+uint8_t MediaDescription::GetExtmapId(const ov::String &uri) const
+{
+	for(auto &extmap : _extmap)
+	{
+		if(extmap.second == uri)
+		{
+			return extmap.first;
+		}
+	}
+
+	return 0;
+}
+
 // a=rtcp-fb:96 nack pli
 bool MediaDescription::EnableRtcpFb(uint8_t id, const ov::String &type, bool on)
 {
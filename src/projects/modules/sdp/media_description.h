@@ -63,6 +63,8 @@ public:
 	std::shared_ptr<const PayloadAttr> GetPayload(uint8_t id) const;
 	std::shared_ptr<PayloadAttr> GetPayload(uint8_t id);
 	std::shared_ptr<const PayloadAttr> GetFirstPayload() const;
+	// In the order of the priority
+	const std::vector<std::shared_ptr<PayloadAttr>> &GetPayloadList() const;
 
 	// a=rtcp-mux
 	void UseRtcpMux(bool flag = true);
@@ -101,6 +103,11 @@ public:
 	bool EnableRtcpFb(uint8_t id, const ov::String &type, bool on);
 	void EnableRtcpFb(uint8_t id, const PayloadAttr::RtcpFbType &type, bool on);
 
+	// a=extmap:3 http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01
+	void AddExtmap(uint8_t id, const ov::String &uri);
+	// @return 0 if the extension is not negotiated
+	uint8_t GetExtmapId(const ov::String &uri) const;
+
 	// a=ssrc:2064629418 cname:{b2266c86-259f-4853-8662-ea94cf0835a3}
 	void SetCname(const ov::String &cname);
 	void SetSsrc(uint32_t ssrc);
@@ -144,4 +151,7 @@ private:
 	ov::String _cname;
 
 	std::vector<std::shared_ptr<PayloadAttr>> _payload_list;
+
+	// Key: extension id, Value: URI
+	std::map<uint8_t, ov::String> _extmap;
 };
@@ -51,8 +51,28 @@ namespace mon
             return false;
         }
 
+        auto origin_stream = stream.GetOriginStream();
+        if(origin_stream != nullptr)
+        {
+            auto origin_stream_item = _streams.find(origin_stream->GetId());
+            if(origin_stream_item != _streams.end())
+            {
+                stream_metrics->SetOriginStreamMetrics(origin_stream_item->second);
+            }
+        }
+
         _streams[stream.GetId()] = stream_metrics;
 
+        // The child streams which are created before the origin stream are bound now
+        for(auto &item : _streams)
+        {
+            auto child_origin_stream = item.second->GetOriginStream();
+            if((child_origin_stream != nullptr) && (child_origin_stream->GetId() == stream.GetId()))
+            {
+                item.second->SetOriginStreamMetrics(stream_metrics);
+            }
+        }
+
         logti("Create StreamMetrics(%s) for monitoring", stream.GetName().CStr());
         return true;
     }
@@ -133,14 +153,14 @@ namespace mon
     void ApplicationMetrics::IncreaseBytesIn(uint64_t value)
     {
         // Forward value to HostMetrics to sum
-		GetHostMetrics()->IncreaseBytesIn(value);
+		_host_metrics->IncreaseBytesIn(value);
 		CommonMetrics::IncreaseBytesIn(value);
     }
 
     void ApplicationMetrics::IncreaseBytesOut(PublisherType type, uint64_t value)
     {
         // Forward value to HostMetrics to sum
-		GetHostMetrics()->IncreaseBytesOut(type, value);
+		_host_metrics->IncreaseBytesOut(type, value);
 		CommonMetrics::IncreaseBytesOut(type, value);
     }
 
@@ -8,8 +8,6 @@ namespace mon
 {
     CommonMetrics::CommonMetrics()
     {
-        _total_bytes_in = 0;
-        _total_bytes_out = 0;
         _total_connections = 0;
 		_max_total_connections = 0;
 
@@ -19,7 +17,6 @@ namespace mon
 
         for(int i=0; i<static_cast<int8_t>(PublisherType::NumberOfPublishers); i++)
         {
-            _publisher_metrics[i]._bytes_out = 0;
             _publisher_metrics[i]._connections = 0;
         }
         _created_time = std::chrono::system_clock::now();
@@ -73,11 +70,18 @@ namespace mon
 
     uint64_t CommonMetrics::GetTotalBytesIn() const
 	{
-		return _total_bytes_in;
+		return _total_bytes_in.Get();
 	}
 	uint64_t CommonMetrics::GetTotalBytesOut() const
 	{
-		return _total_bytes_out;
+		uint64_t total_bytes_out = 0;
+
+		for (int i = 0; i < static_cast<int8_t>(PublisherType::NumberOfPublishers); i++)
+		{
+			total_bytes_out += _publisher_metrics[i]._bytes_out.Get();
+		}
+
+		return total_bytes_out;
 	}
 	uint32_t CommonMetrics::GetTotalConnections() const
 	{
@@ -105,7 +109,7 @@ namespace mon
 
 	uint64_t CommonMetrics::GetBytesOut(PublisherType type) const
 	{
-		return _publisher_metrics[static_cast<int8_t>(type)]._bytes_out;
+		return _publisher_metrics[static_cast<int8_t>(type)]._bytes_out.Get();
 	}
 	uint64_t CommonMetrics::GetConnections(PublisherType type) const
 	{
@@ -114,9 +118,8 @@ namespace mon
 
     void CommonMetrics::IncreaseBytesIn(uint64_t value)
 	{
-		_total_bytes_in += value;
-		_last_recv_time = std::chrono::system_clock::now();
-		UpdateDate();
+		_total_bytes_in.Add(value);
+		UpdateDateIfNeeded(_last_recv_time);
 	}
 	void CommonMetrics::IncreaseBytesOut(PublisherType type, uint64_t value)
 	{
@@ -125,10 +128,8 @@ namespace mon
 			return;
 		}
 		
-		_publisher_metrics[static_cast<int8_t>(type)]._bytes_out += value;
-		_total_bytes_out += value;
-		_last_sent_time = std::chrono::system_clock::now();
-		UpdateDate();
+		_publisher_metrics[static_cast<int8_t>(type)]._bytes_out.Add(value);
+		UpdateDateIfNeeded(_last_sent_time);
 	}
 
 	void CommonMetrics::OnSessionConnected(PublisherType type)
@@ -165,4 +166,15 @@ namespace mon
     {
         _last_updated_time = std::chrono::system_clock::now();
     }
+
+	void CommonMetrics::UpdateDateIfNeeded(std::chrono::system_clock::time_point &last_time)
+	{
+		auto now = std::chrono::system_clock::now();
+
+		if ((now - last_time) >= std::chrono::seconds(1))
+		{
+			last_time = now;
+			_last_updated_time = now;
+		}
+	}
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "base/common_types.h"
 #include "base/info/info.h"
 #include "base/info/stream.h"
+#include "sharded_counter.h"
 
 namespace mon
 {
@@ -42,15 +43,14 @@ namespace mon
 
 		// Renew last updated time
 		void UpdateDate();
+		// Renew the time at most once per second, so that the hot path doesn't write to the shared cache line every time
+		void UpdateDateIfNeeded(std::chrono::system_clock::time_point &last_time);
 
 		std::chrono::system_clock::time_point _created_time;
 		std::chrono::system_clock::time_point _last_updated_time;
 
 		// From Provider
-		std::atomic<uint64_t> _total_bytes_in;
-
-		// From Publishers
-		std::atomic<uint64_t> _total_bytes_out;
+		ShardedCounter _total_bytes_in;
 
 		std::atomic<uint32_t> _total_connections;
 		std::atomic<uint32_t> _max_total_connections;
@@ -64,7 +64,7 @@ namespace mon
 		class PublisherMetrics
 		{
 		public:
-			std::atomic<uint64_t> _bytes_out;
+			ShardedCounter _bytes_out;
 			std::atomic<uint32_t> _connections;
 		};
 
@@ -0,0 +1,90 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "sharded_counter.h"
+
+#include <mutex>
+
+namespace mon
+{
+	namespace
+	{
+		// Assigns a shard to each thread. The shard of a finished thread is given to the next thread.
+		class ShardIndexAllocator
+		{
+		public:
+			size_t Allocate()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				for (size_t index = 0; index < (MON_COUNTER_SHARD_COUNT - 1); index++)
+				{
+					if (_is_used[index] == false)
+					{
+						_is_used[index] = true;
+						return index;
+					}
+				}
+
+				// All shards are owned by the other threads
+				return MON_COUNTER_SHARD_COUNT - 1;
+			}
+
+			void Release(size_t index)
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				if (index < (MON_COUNTER_SHARD_COUNT - 1))
+				{
+					_is_used[index] = false;
+				}
+			}
+
+		private:
+			std::mutex _mutex;
+			bool _is_used[MON_COUNTER_SHARD_COUNT - 1] = {};
+		};
+
+		ShardIndexAllocator *GetShardIndexAllocator()
+		{
+			// Not destroyed, the threads may exit after the static objects are destroyed
+			static auto allocator = new ShardIndexAllocator();
+
+			return allocator;
+		}
+
+		class ThreadShardIndex
+		{
+		public:
+			ThreadShardIndex()
+				: _index(GetShardIndexAllocator()->Allocate())
+			{
+			}
+
+			~ThreadShardIndex()
+			{
+				GetShardIndexAllocator()->Release(_index);
+			}
+
+			size_t GetIndex() const
+			{
+				return _index;
+			}
+
+		private:
+			size_t _index;
+		};
+	}  // namespace
+
+	size_t ShardedCounter::GetShardIndex()
+	{
+		static thread_local ThreadShardIndex thread_shard_index;
+
+		return thread_shard_index.GetIndex();
+	}
+}  // namespace mon
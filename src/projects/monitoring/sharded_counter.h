@@ -0,0 +1,69 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// The number of shards of a ShardedCounter.
+// Each thread owns one of the first (MON_COUNTER_SHARD_COUNT - 1) shards, the last one is shared by the rest of the threads.
+#define MON_COUNTER_SHARD_COUNT 16
+// Size of a cache line, the shards are aligned to it to prevent false sharing
+#define MON_COUNTER_CACHE_LINE_SIZE 64
+
+namespace mon
+{
+	// A counter that is increased very often by many threads, and read rarely (e.g. bytes out per packet vs. REST API)
+	//
+	// Each thread accumulates the value to its own cache line, so Add() is a plain add without contention.
+	// The shards are summed when the value is read.
+	class ShardedCounter
+	{
+	public:
+		void Add(uint64_t value)
+		{
+			auto index = GetShardIndex();
+			auto &shard = _shards[index];
+
+			if (index < (MON_COUNTER_SHARD_COUNT - 1))
+			{
+				// Only the current thread writes to this shard
+				shard.value.store(shard.value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			}
+			else
+			{
+				shard.value.fetch_add(value, std::memory_order_relaxed);
+			}
+		}
+
+		uint64_t Get() const
+		{
+			uint64_t sum = 0;
+
+			for (const auto &shard : _shards)
+			{
+				sum += shard.value.load(std::memory_order_relaxed);
+			}
+
+			return sum;
+		}
+
+	private:
+		// @return The index of the shard of the current thread
+		static size_t GetShardIndex();
+
+		struct alignas(MON_COUNTER_CACHE_LINE_SIZE) Shard
+		{
+			std::atomic<uint64_t> value{0};
+		};
+
+		Shard _shards[MON_COUNTER_SHARD_COUNT];
+	};
+}  // namespace mon
@@ -31,6 +31,39 @@ namespace mon
 		logti("%s", GetInfoString().CStr());
 	}
 
+	void StreamMetrics::SetOriginStreamMetrics(const std::shared_ptr<StreamMetrics> &origin_stream_metrics)
+	{
+		std::lock_guard<std::mutex> lock(_origin_stream_metrics_lock);
+
+		if(origin_stream_metrics != nullptr)
+		{
+			// The previous metrics may still be used by the other threads, so it is kept until this metrics is released
+			_origin_stream_metrics_list.push_back(origin_stream_metrics);
+		}
+
+		_origin_stream_metrics = origin_stream_metrics.get();
+	}
+
+	StreamMetrics *StreamMetrics::GetOriginStreamMetrics()
+	{
+		auto origin_stream_metrics = _origin_stream_metrics.load();
+
+		if(origin_stream_metrics == nullptr)
+		{
+			// The origin stream metrics was not created yet when this metrics was created
+			auto origin_stream = GetOriginStream();
+			auto metrics = (origin_stream != nullptr) ? _app_metrics->GetStreamMetrics(*origin_stream) : nullptr;
+
+			if(metrics != nullptr)
+			{
+				SetOriginStreamMetrics(metrics);
+				origin_stream_metrics = metrics.get();
+			}
+		}
+
+		return origin_stream_metrics;
+	}
+
 	// Getter
 	int64_t StreamMetrics::GetOriginRequestTimeMSec() const
 	{
@@ -58,19 +91,18 @@ namespace mon
 		CommonMetrics::IncreaseBytesIn(value);
 
 		// If this stream is child then send event to parent
-		auto origin_stream_info = GetOriginStream();
-		if(origin_stream_info != nullptr)
+		if(_has_origin_stream)
 		{
-			auto origin_stream_metric = _app_metrics->GetStreamMetrics(*origin_stream_info);
-			if(origin_stream_metric != nullptr)
+			auto origin_stream_metrics = GetOriginStreamMetrics();
+			if(origin_stream_metrics != nullptr)
 			{
-				origin_stream_metric->IncreaseBytesIn(value);
+				origin_stream_metrics->IncreaseBytesIn(value);
 			}
 		}
 		else
 		{
 			// Forward value to AppMetrics to sum
-			GetApplicationMetrics()->IncreaseBytesIn(value);
+			_app_metrics->IncreaseBytesIn(value);
 		}
 	}
 
@@ -79,19 +111,18 @@ namespace mon
 		CommonMetrics::IncreaseBytesOut(type, value);
 
 		// If this stream is child then send event to parent
-		auto origin_stream_info = GetOriginStream();
-		if(origin_stream_info != nullptr)
+		if(_has_origin_stream)
 		{
-			auto origin_stream_metric = _app_metrics->GetStreamMetrics(*origin_stream_info);
-			if(origin_stream_metric != nullptr)
+			auto origin_stream_metrics = GetOriginStreamMetrics();
+			if(origin_stream_metrics != nullptr)
 			{
-				origin_stream_metric->IncreaseBytesOut(type, value);
+				origin_stream_metrics->IncreaseBytesOut(type, value);
 			}
 		}
 		else
 		{
 			// Forward value to AppMetrics to sum
-			GetApplicationMetrics()->IncreaseBytesOut(type, value);
+			_app_metrics->IncreaseBytesOut(type, value);
 		}
 	}
 
@@ -100,13 +131,12 @@ namespace mon
 		CommonMetrics::OnSessionConnected(type);
 
 		// If this stream is child then send event to parent
-		auto origin_stream_info = GetOriginStream();
-		if(origin_stream_info != nullptr)
+		if(_has_origin_stream)
 		{
-			auto origin_stream_metric = _app_metrics->GetStreamMetrics(*origin_stream_info);
-			if(origin_stream_metric != nullptr)
+			auto origin_stream_metrics = GetOriginStreamMetrics();
+			if(origin_stream_metrics != nullptr)
 			{
-				origin_stream_metric->OnSessionConnected(type);
+				origin_stream_metrics->OnSessionConnected(type);
 			}
 		}
 		else
@@ -125,13 +155,12 @@ namespace mon
 		CommonMetrics::OnSessionDisconnected(type);
 
 		// If this stream is child then send event to parent
-		auto origin_stream_info = GetOriginStream();
-		if(origin_stream_info != nullptr)
+		if(_has_origin_stream)
 		{
-			auto origin_stream_metric = _app_metrics->GetStreamMetrics(*origin_stream_info);
-			if(origin_stream_metric != nullptr)
+			auto origin_stream_metrics = GetOriginStreamMetrics();
+			if(origin_stream_metrics != nullptr)
 			{
-				origin_stream_metric->OnSessionDisconnected(type);
+				origin_stream_metrics->OnSessionDisconnected(type);
 			}
 		}
 		else
@@ -145,4 +174,39 @@ namespace mon
 		}
 	}
 
+	void StreamMetrics::OnSubscriberAdded()
+	{
+		_subscriber_count++;
+		OnRequested();
+	}
+
+	void StreamMetrics::OnSubscriberRemoved()
+	{
+		auto count = _subscriber_count.load();
+
+		while ((count > 0) && (_subscriber_count.compare_exchange_weak(count, count - 1) == false))
+		{
+		}
+
+		// The idle time is counted from the last subscriber leaves
+		OnRequested();
+	}
+
+	void StreamMetrics::OnRequested()
+	{
+		_last_request_time_msec = static_cast<int64_t>(ov::Clock::NowMSec());
+	}
+
+	bool StreamMetrics::IsDemanded(int64_t idle_time_msec) const
+	{
+		if (_subscriber_count > 0)
+		{
+			return true;
+		}
+
+		auto last_request_time_msec = _last_request_time_msec.load();
+
+		return (last_request_time_msec > 0) && ((static_cast<int64_t>(ov::Clock::NowMSec()) - last_request_time_msec) <= idle_time_msec);
+	}
+
 }  // namespace mon
\ No newline at end of file
@@ -22,6 +22,7 @@ namespace mon
 		{
 			_request_time_to_origin_msec = 0;
 			_response_time_from_origin_msec = 0;
+			_has_origin_stream = (stream.GetOriginStream() != nullptr);
 		}
 
 		~StreamMetrics()
@@ -37,6 +38,9 @@ namespace mon
 		ov::String GetInfoString();
 		void ShowInfo() override;
 
+		// Called by ApplicationMetrics when the metrics of the origin stream is created (or deleted with nullptr)
+		void SetOriginStreamMetrics(const std::shared_ptr<StreamMetrics> &origin_stream_metrics);
+
 		int64_t GetOriginRequestTimeMSec() const;
 		int64_t GetOriginResponseTimeMSec() const;
 		void SetOriginRequestTimeMSec(int64_t value);
@@ -47,11 +51,36 @@ namespace mon
 		void IncreaseBytesOut(PublisherType type, uint64_t value) override;
 		void OnSessionConnected(PublisherType type) override;
 		void OnSessionDisconnected(PublisherType type) override;
+
+		// Demand of the stream (used to transcode the output streams on demand)
+		//
+		// Called when a session of any publisher (including the relay/push/recording) is added/removed
+		void OnSubscriberAdded();
+		void OnSubscriberRemoved();
+		// Called when the stream is requested by a publisher without the session (HLS/DASH/Thumbnail)
+		void OnRequested();
+		// @return true if the stream has a subscriber, or is requested within <idle_time_msec>
+		bool IsDemanded(int64_t idle_time_msec) const;
+
 	private:
+		// If it is not bound yet, looks up the metrics of the origin stream and binds it
+		StreamMetrics *GetOriginStreamMetrics();
+
 		// Related to origin, From Provider
 		std::atomic<int64_t> _request_time_to_origin_msec = 0;
 		std::atomic<int64_t> _response_time_from_origin_msec = 0;
 
+		std::atomic<uint32_t> _subscriber_count = 0;
+		std::atomic<int64_t> _last_request_time_msec = 0;
+
 		std::shared_ptr<ApplicationMetrics>	_app_metrics;
+
+		// The counters of a child stream (e.g. transcoded) are also summed to the origin stream.
+		// It is cached to avoid looking up the stream map of the application on every call, and read without a lock.
+		bool _has_origin_stream = false;
+		std::atomic<StreamMetrics *> _origin_stream_metrics{nullptr};
+		// Keeps the bound metrics alive (the origin stream can be recreated while this stream is alive)
+		std::mutex _origin_stream_metrics_lock;
+		std::vector<std::shared_ptr<StreamMetrics>> _origin_stream_metrics_list;
 	};
 }
\ No newline at end of file
@@ -49,6 +49,12 @@ bool OvtSession::Stop()
 	return Session::Stop();
 }
 
+void OvtSession::OnGopCacheStarted()
+{
+	// The cached GOP starts with the first packet of a key frame
+	_sent_ready = true;
+}
+
 bool OvtSession::SendOutgoingData(const std::any &packet)
 {
 	std::shared_ptr<OvtPacket> session_packet;
@@ -22,6 +22,7 @@ public:
 	bool Stop() override;
 
 	bool SendOutgoingData(const std::any &packet) override;
+	void OnGopCacheStarted() override;
 	void OnPacketReceived(const std::shared_ptr<info::Session> &session_info,
 						const std::shared_ptr<const ov::Data> &data) override;
 
@@ -41,6 +41,7 @@ bool OvtStream::Start()
 	}
 
 	logtd("OvtStream(%d) has been started", GetId());
+	SetGopCacheEnabled(GetApplicationInfo().GetConfig().GetPublishers().GetOvtPublisher().IsGopCacheEnabled());
 	_packetizer = std::make_shared<OvtPacketizer>(OvtPacketizerInterface::GetSharedPtr());
 	_stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(pub::Stream::GetSharedPtr()));
 
@@ -164,6 +165,11 @@ void OvtStream::SendVideoFrame(const std::shared_ptr<MediaPacket> &media_packet)
 		return;
 	}
 
+	if(media_packet->GetFlag() == MediaPacketFlag::Key)
+	{
+		StartGopCache(media_packet->GetTrackId());
+	}
+
 	// Callback OnOvtPacketized()
 	std::shared_lock<std::shared_mutex> mlock(_packetizer_lock);
 	if(_packetizer != nullptr)
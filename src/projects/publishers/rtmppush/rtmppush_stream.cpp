@@ -38,6 +38,7 @@ bool RtmpPushStream::Start()
 	}
 
 	logtd("RtmpPushStream(%ld) has been started", GetId());
+	SetGopCacheEnabled(GetApplicationInfo().GetConfig().GetPublishers().GetRtmpPushPublisher().IsGopCacheEnabled());
 
 	return Stream::Start();
 }
@@ -60,6 +61,11 @@ void RtmpPushStream::SendVideoFrame(const std::shared_ptr<MediaPacket> &media_pa
 		return;
 	}
 
+	if(media_packet->GetFlag() == MediaPacketFlag::Key)
+	{
+		StartGopCache(media_packet->GetTrackId());
+	}
+
 	auto stream_packet = std::make_any<std::shared_ptr<MediaPacket>>(media_packet);
 
 	BroadcastPacket(stream_packet);
@@ -1019,30 +1019,15 @@ bool CmafPacketizer::UpdatePlayList()
 
 	xml
 		// <UTCTiming />
-		<< R"(	<UTCTiming schemeIdUri="urn:mpeg:dash:utc:direct:2014" value="%s" />)" << std::endl;
+		// The value is the current time, which is filled when the playlist is requested
+		<< R"(	<UTCTiming schemeIdUri="urn:mpeg:dash:utc:direct:2014" value=")";
 
-	xml
-		// </MPD>
-		<< R"(</MPD>)";
-
-	ov::String play_list = xml.str().c_str();
-
-	SetPlayList(play_list);
-
-	return true;
-}
-
-bool CmafPacketizer::GetPlayList(ov::String &play_list)
-{
-	if (IsReadyForStreaming() == false)
-	{
-		logad("Manifest was requested before the stream began");
-		return false;
-	}
-
-	ov::String current_time = MakeUtcMillisecond();
+	ov::String head = xml.str().c_str();
+	ov::String tail = "\" />\n"
+					  // </MPD>
+					  "</MPD>";
 
-	play_list = ov::String::FormatString(_play_list.CStr(), current_time.CStr());
+	SetPlayList(head, tail);
 
 	return true;
 }
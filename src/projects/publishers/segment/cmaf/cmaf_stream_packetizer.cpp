@@ -56,7 +56,7 @@ bool CmafStreamPacketizer::AppendAudioFrame(const std::shared_ptr<const Packetiz
 // Get PlayList
 // - MPD
 //====================================================================================================
-bool CmafStreamPacketizer::GetPlayList(ov::String &play_list)
+bool CmafStreamPacketizer::GetPlayList(std::shared_ptr<const PlayList> &play_list)
 {
 	return _packetizer->GetPlayList(play_list);
 }
@@ -14,6 +14,151 @@
 #include "cmaf_packetizer.h"
 #include "cmaf_private.h"
 
+std::shared_ptr<CmafStreamServer::CmafStreamChunks> CmafStreamServer::GetStreamChunks(const StreamKey &key)
+{
+	std::shared_lock<std::shared_mutex> lock(_stream_chunk_map_mutex);
+
+	auto item = _stream_chunk_map.find(key);
+
+	return (item != _stream_chunk_map.end()) ? item->second : nullptr;
+}
+
+std::shared_ptr<CmafStreamServer::CmafStreamChunks> CmafStreamServer::GetOrCreateStreamChunks(const StreamKey &key)
+{
+	auto stream_chunks = GetStreamChunks(key);
+
+	if (stream_chunks != nullptr)
+	{
+		return stream_chunks;
+	}
+
+	std::unique_lock<std::shared_mutex> lock(_stream_chunk_map_mutex);
+
+	auto &item = _stream_chunk_map[key];
+
+	if (item == nullptr)
+	{
+		item = std::make_shared<CmafStreamChunks>();
+	}
+
+	return item;
+}
+
+void CmafStreamServer::RemoveStreamChunksIfEmpty(const StreamKey &key, const std::shared_ptr<CmafStreamChunks> &stream_chunks)
+{
+	std::unique_lock<std::shared_mutex> lock(_stream_chunk_map_mutex);
+	std::lock_guard<std::mutex> stream_lock(stream_chunks->mutex);
+
+	if (stream_chunks->broadcast_map.empty() == false)
+	{
+		return;
+	}
+
+	auto item = _stream_chunk_map.find(key);
+
+	if ((item != _stream_chunk_map.end()) && (item->second == stream_chunks))
+	{
+		_stream_chunk_map.erase(item);
+	}
+
+	stream_chunks->is_removed = true;
+}
+
+std::shared_ptr<pub::Stream> CmafStreamServer::FindStream(const info::VHostAppName &vhost_app_name, const ov::String &stream_name)
+{
+	for (auto observer : _observers)
+	{
+		auto segment_publisher = std::dynamic_pointer_cast<pub::Publisher>(observer);
+
+		if (segment_publisher != nullptr)
+		{
+			auto stream_info = segment_publisher->GetStreamAs<pub::Stream>(vhost_app_name, stream_name);
+
+			if (stream_info != nullptr)
+			{
+				return stream_info;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void CmafStreamServer::ScheduleFlush(const std::shared_ptr<CmafChunkBroadcast> &broadcast, const std::shared_ptr<CmafChunkClient> &client)
+{
+	if ((client->is_finished) || client->is_flush_scheduled.exchange(true))
+	{
+		// The posted flush sends the new chunks too
+		return;
+	}
+
+	auto remote = client->connection->GetResponse()->GetRemote();
+
+	if ((remote == nullptr) ||
+		(remote->PostWritableCallback([this, broadcast, client]() {
+			FlushPendingChunks(broadcast, client);
+		}) == false))
+	{
+		// The connection is closing
+		client->is_finished = true;
+	}
+}
+
+void CmafStreamServer::FlushPendingChunks(const std::shared_ptr<CmafChunkBroadcast> &broadcast, const std::shared_ptr<CmafChunkClient> &client)
+{
+	// The chunks appended from now on are sent by the next flush
+	client->is_flush_scheduled = false;
+
+	if (client->is_finished)
+	{
+		return;
+	}
+
+	auto response = client->connection->GetResponse();
+	auto remote = response->GetRemote();
+
+	std::vector<std::shared_ptr<const ov::Data>> chunk_list;
+	bool is_completed;
+
+	{
+		std::lock_guard<std::mutex> lock(broadcast->mutex);
+
+		is_completed = broadcast->is_completed;
+		chunk_list.assign(broadcast->chunk_list.begin() + client->cursor, broadcast->chunk_list.end());
+	}
+
+	for (const auto &chunk_data : chunk_list)
+	{
+		if (response->SendChunkedData(chunk_data) == false)
+		{
+			logtw("Failed to send the chunked data to %s (%zu bytes)", (remote != nullptr) ? remote->ToString().CStr() : "(unknown)", chunk_data->GetLength());
+
+			client->is_finished = true;
+			response->Close();
+			return;
+		}
+
+		IncreaseBytesOut(client->connection, chunk_data->GetLength());
+		client->cursor++;
+	}
+
+	if (is_completed)
+	{
+		// All chunks are sent
+		client->is_finished = true;
+
+		if (response->SendChunkedData(nullptr) == false)
+		{
+			logtw("[%s] Could not response the CMAF chunk", (remote != nullptr) ? remote->ToString().CStr() : "(unknown)");
+
+			response->Close();
+			return;
+		}
+
+		client->connection->CompleteResponse();
+	}
+}
+
 HttpConnectionPolicy CmafStreamServer::ProcessSegmentRequest(const std::shared_ptr<HttpConnection> &client,
 													   const SegmentStreamRequestInfo &request_info,
 													   SegmentType segment_type)
@@ -23,64 +168,87 @@ HttpConnectionPolicy CmafStreamServer::ProcessSegmentRequest(const std::shared_p
 	auto type = CmafPacketizer::GetFileType(request_info.file_name);
 
 	bool is_video = ((type == DashFileType::VideoSegment) || (type == DashFileType::VideoInit));
-	std::shared_ptr<SegmentItem> segment = nullptr;
 
 	// Check if the requested file is being created
-	{
-		auto key = ov::String::FormatString("%s/%s/%s", request_info.vhost_app_name.CStr(), request_info.stream_name.CStr(), request_info.file_name.CStr());
+	StreamKey key(request_info.vhost_app_name.ToString(), request_info.stream_name);
+	auto stream_chunks = GetStreamChunks(key);
 
-		std::unique_lock<std::mutex> lock(_http_chunk_guard);
+	if (stream_chunks != nullptr)
+	{
+		std::shared_ptr<CmafChunkBroadcast> broadcast;
 
-		auto chunk_item = _http_chunk_list.find(key);
-		if (chunk_item != _http_chunk_list.end())
 		{
-			// Find stream info
-			std::shared_ptr<pub::Stream> stream_info;
-			for (auto observer : _observers)
-			{
-				auto segment_publisher = std::dynamic_pointer_cast<pub::Publisher>(observer);
+			std::lock_guard<std::mutex> lock(stream_chunks->mutex);
 
-				if (segment_publisher != nullptr)
-				{
-					stream_info = segment_publisher->GetStreamAs<pub::Stream>(request_info.vhost_app_name, request_info.stream_name);
+			auto broadcast_item = stream_chunks->broadcast_map.find(request_info.file_name);
 
-					if (stream_info != nullptr)
-					{
-						break;
-					}
-				}
+			if (broadcast_item != stream_chunks->broadcast_map.end())
+			{
+				broadcast = broadcast_item->second;
 			}
+		}
+
+		if (broadcast != nullptr)
+		{
+			// Find stream info
+			auto stream_info = FindStream(request_info.vhost_app_name, request_info.stream_name);
 
 			if (stream_info == nullptr)
 			{
 				// The stream has been deleted, but if it remains in the Worker queue, this code will run.
 				response->SetStatusCode(HttpStatusCode::NotFound);
-				_http_chunk_list.clear();
-				
+
+				{
+					std::lock_guard<std::mutex> lock(stream_chunks->mutex);
+					stream_chunks->broadcast_map.clear();
+				}
+
+				RemoveStreamChunksIfEmpty(key, stream_chunks);
+
 				return HttpConnectionPolicy::Closed;
 			}
 
-			client->GetRequest()->SetExtra(stream_info);
+			auto chunk_client = std::make_shared<CmafChunkClient>(client);
+			// Prevent the packetizer from posting a flush before the HTTP header is sent
+			chunk_client->is_flush_scheduled = true;
+
+			bool is_added = false;
+
+			{
+				std::lock_guard<std::mutex> lock(broadcast->mutex);
+
+				if (broadcast->is_completed == false)
+				{
+					broadcast->client_list.push_back(chunk_client);
+					is_added = true;
+				}
+			}
+
+			if (is_added)
+			{
+				client->GetRequest()->SetExtra(stream_info);
+
+				// The file is being created
+				logtd("Requested file is being created");
 
-			// The file is being created
-			logtd("Requested file is being created");
+				// Set HTTP header
+				response->SetHeader("Content-Type", is_video ? "video/mp4" : "audio/mp4");
 
-			// Set HTTP header
-			response->SetHeader("Content-Type", is_video ? "video/mp4" : "audio/mp4");
+				// Enable chunked transfer
+				response->SetChunkedTransfer();
 
-			// Enable chunked transfer
-			response->SetKeepAlive();
-			response->SetChunkedTransfer();
+				auto sent_bytes = response->Response();
 
-			// Append data to HTTP response
-			response->AppendData(chunk_item->second->chunked_data);
-			auto sent_bytes = response->Response();
+				IncreaseBytesOut(client, sent_bytes);
 
-			IncreaseBytesOut(client, sent_bytes);
+				// Send the chunks created so far
+				chunk_client->is_flush_scheduled = false;
+				ScheduleFlush(broadcast, chunk_client);
 
-			chunk_item->second->client_list.push_back(client);
+				return HttpConnectionPolicy::Pending;
+			}
 
-			return HttpConnectionPolicy::KeepAlive;
+			// The segment is completed in the meantime, so it can be served as a file
 		}
 	}
 
@@ -92,42 +260,56 @@ void CmafStreamServer::OnCmafChunkDataPush(const ov::String &app_name, const ov:
 										   bool is_video,
 										   std::shared_ptr<ov::Data> &chunk_data)
 {
-	auto key = ov::String::FormatString("%s/%s/%s", app_name.CStr(), stream_name.CStr(), file_name.CStr());
+	StreamKey key(app_name, stream_name);
+	std::shared_ptr<CmafChunkBroadcast> broadcast;
 
-	std::unique_lock<std::mutex> lock(_http_chunk_guard);
-
-	auto chunk_item = _http_chunk_list.find(key);
-	if (chunk_item == _http_chunk_list.end())
+	while (true)
 	{
-		// New chunk data is arrived
-		logtd("Create a new chunk for [%s/%s, %s], size: %zu bytes", app_name.CStr(), stream_name.CStr(), file_name.CStr(), chunk_data->GetLength());
-		_http_chunk_list.emplace(key, std::make_shared<CmafHttpChunkedData>(chunk_data));
-		return;
-	}
+		auto stream_chunks = GetOrCreateStreamChunks(key);
+
+		std::lock_guard<std::mutex> lock(stream_chunks->mutex);
+
+		if (stream_chunks->is_removed)
+		{
+			// Removed by RemoveStreamChunksIfEmpty() in the meantime
+			continue;
+		}
 
-	chunk_item->second->AddChunkData(chunk_data);
+		auto &item = stream_chunks->broadcast_map[file_name];
 
-	auto client_item = chunk_item->second->client_list.begin();
+		if (item == nullptr)
+		{
+			// New chunk data is arrived
+			logtd("Create a new chunk for [%s/%s, %s], size: %zu bytes", app_name.CStr(), stream_name.CStr(), file_name.CStr(), chunk_data->GetLength());
+			item = std::make_shared<CmafChunkBroadcast>();
+		}
+
+		broadcast = item;
+		break;
+	}
+
+	std::vector<std::shared_ptr<CmafChunkClient>> client_list;
 
-	while (client_item != chunk_item->second->client_list.end())
 	{
-		auto &client = *client_item;
+		std::lock_guard<std::mutex> lock(broadcast->mutex);
 
-		auto response = client->GetResponse();
+		// The packetizer may reuse chunk_data, so keep a copy-on-write instance
+		broadcast->chunk_list.push_back(chunk_data->Clone());
 
-		if (response->SendChunkedData(chunk_data))
-		{
-			IncreaseBytesOut(client, chunk_data->GetLength());
+		// Clean up the clients that have finished
+		auto &list = broadcast->client_list;
+		list.erase(std::remove_if(list.begin(), list.end(), [](const std::shared_ptr<CmafChunkClient> &client) {
+					   return client->is_finished.load();
+				   }),
+				   list.end());
 
-			++client_item;
-		}
-		else
-		{
-			logtw("Failed to send the chunked data for [%s/%s, %s] to %s (%zu bytes)", app_name.CStr(), stream_name.CStr(), file_name.CStr(), response->GetRemote()->ToString().CStr(), chunk_data->GetLength());
+		client_list = list;
+	}
 
-			client_item = chunk_item->second->client_list.erase(client_item);
-			response->Close();
-		}
+	// The chunk is sent by the socket thread of each client, so the packetizer only posts the flushes
+	for (const auto &client : client_list)
+	{
+		ScheduleFlush(broadcast, client);
 	}
 }
 
@@ -135,39 +317,47 @@ void CmafStreamServer::OnCmafChunkedComplete(const ov::String &app_name, const o
 											 const ov::String &file_name,
 											 bool is_video)
 {
-	std::shared_ptr<CmafHttpChunkedData> chunked_data;
+	StreamKey key(app_name, stream_name);
+	auto stream_chunks = GetStreamChunks(key);
+	std::shared_ptr<CmafChunkBroadcast> broadcast;
 
+	if (stream_chunks != nullptr)
 	{
-		auto key = ov::String::FormatString("%s/%s/%s", app_name.CStr(), stream_name.CStr(), file_name.CStr());
-
-		std::unique_lock<std::mutex> lock(_http_chunk_guard);
+		std::lock_guard<std::mutex> lock(stream_chunks->mutex);
 
-		auto chunk_item = _http_chunk_list.find(key);
+		auto broadcast_item = stream_chunks->broadcast_map.find(file_name);
 
-		if (chunk_item == _http_chunk_list.end())
+		if (broadcast_item != stream_chunks->broadcast_map.end())
 		{
-			logtw("Could not find a CMAF chunk [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
-			OV_ASSERT2(false);
-			return;
+			broadcast = broadcast_item->second;
+			stream_chunks->broadcast_map.erase(broadcast_item);
 		}
+	}
 
-		chunked_data = chunk_item->second;
-
-		_http_chunk_list.erase(chunk_item);
+	if (broadcast == nullptr)
+	{
+		logtw("Could not find a CMAF chunk [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
+		OV_ASSERT2(false);
+		return;
 	}
 
+	RemoveStreamChunksIfEmpty(key, stream_chunks);
+
 	logtd("The chunk is completed [%s/%s, %s]", app_name.CStr(), stream_name.CStr(), file_name.CStr());
 
-	for (auto client : chunked_data->client_list)
+	std::vector<std::shared_ptr<CmafChunkClient>> client_list;
+
 	{
-		auto response = client->GetResponse();
+		std::lock_guard<std::mutex> lock(broadcast->mutex);
 
-		if (response->SendChunkedData(nullptr) == false)
-		{
-			logtw("[%s] Could not response the CMAF chunk: [%s/%s, %s]",
-				  response->GetRemote()->ToString().CStr(), app_name.CStr(), stream_name.CStr(), file_name.CStr());
-		}
+		broadcast->is_completed = true;
+		client_list = std::move(broadcast->client_list);
+		broadcast->client_list.clear();
+	}
 
-		response->Close();
+	// Send the remaining chunks and the last chunk
+	for (const auto &client : client_list)
+	{
+		ScheduleFlush(broadcast, client);
 	}
-}
\ No newline at end of file
+}
@@ -8,6 +8,9 @@
 //==============================================================================
 #pragma once
 
+#include <atomic>
+#include <shared_mutex>
+
 #include "../dash/dash_stream_server.h"
 #include "cmaf_interceptor.h"
 #include "cmaf_packetizer.h"
@@ -31,24 +34,72 @@ public:
 	}
 
 protected:
-	struct CmafHttpChunkedData
+	// A client waiting for the CMAF segment which is being created
+	struct CmafChunkClient
 	{
 	public:
-		CmafHttpChunkedData(const std::shared_ptr<const ov::Data> &data)
+		CmafChunkClient(const std::shared_ptr<HttpConnection> &connection)
+			: connection(connection)
 		{
-			chunked_data = std::make_shared<ov::Data>(104 * 1024);
-			chunked_data->Append(data);
 		}
 
-		void AddChunkData(const std::shared_ptr<ov::Data> &data)
+		std::shared_ptr<HttpConnection> connection;
+
+		// Index of the next chunk to send (Accessed only in the socket thread of the connection)
+		size_t cursor = 0;
+
+		// A flush is posted to the socket, so the chunks appended in the meantime are sent by it
+		std::atomic<bool> is_flush_scheduled{false};
+		// The last chunk was sent, or an error occurred
+		std::atomic<bool> is_finished{false};
+	};
+
+	// Chunks of the CMAF segment which is being created
+	//
+	// The packetizer appends a chunk once, and the chunks from the cursor of each client are its send queue.
+	// They are written by the socket thread of the client when the socket is writable,
+	// so neither the sends (including TLS) nor a slow client delay the packetizer or the other clients.
+	struct CmafChunkBroadcast
+	{
+	public:
+		CmafChunkBroadcast()
 		{
-			chunked_data->Append(data);
+			chunk_list.reserve(64);
 		}
 
-		std::shared_ptr<ov::Data> chunked_data;
-		std::vector<std::shared_ptr<HttpConnection>> client_list;
+		std::mutex mutex;
+		std::vector<std::shared_ptr<const ov::Data>> chunk_list;
+		std::vector<std::shared_ptr<CmafChunkClient>> client_list;
+		bool is_completed = false;
 	};
 
+	// The CMAF segments which are being created in a stream.
+	// Each stream has its own lock, so the streams don't contend with each other.
+	struct CmafStreamChunks
+	{
+	public:
+		std::mutex mutex;
+		// Key: file name
+		std::map<ov::String, std::shared_ptr<CmafChunkBroadcast>> broadcast_map;
+		// Set when this instance is removed from _stream_chunk_map
+		bool is_removed = false;
+	};
+
+	// Key: [app name], [stream name]
+	using StreamKey = std::pair<ov::String, ov::String>;
+
+	std::shared_ptr<CmafStreamChunks> GetStreamChunks(const StreamKey &key);
+	std::shared_ptr<CmafStreamChunks> GetOrCreateStreamChunks(const StreamKey &key);
+	void RemoveStreamChunksIfEmpty(const StreamKey &key, const std::shared_ptr<CmafStreamChunks> &stream_chunks);
+
+	std::shared_ptr<pub::Stream> FindStream(const info::VHostAppName &vhost_app_name, const ov::String &stream_name);
+
+	// Posts a flush to the socket of the client, if it is not posted yet.
+	// The socket thread calls FlushPendingChunks() once the data queued in the socket is sent.
+	void ScheduleFlush(const std::shared_ptr<CmafChunkBroadcast> &broadcast, const std::shared_ptr<CmafChunkClient> &client);
+	// Sends the chunks that have not yet been sent to the client (Called in the socket thread)
+	void FlushPendingChunks(const std::shared_ptr<CmafChunkBroadcast> &broadcast, const std::shared_ptr<CmafChunkClient> &client);
+
 	//--------------------------------------------------------------------
 	// Overriding functions of DashStreamServer
 	//--------------------------------------------------------------------
@@ -67,8 +118,7 @@ protected:
 							   const ov::String &file_name,
 							   bool is_video) override;
 
-	// A temporary queue for the intermediate chunks
-	// Key: [app name]/[stream name]/[file name]
-	std::map<ov::String, std::shared_ptr<CmafHttpChunkedData>> _http_chunk_list;
-	std::mutex _http_chunk_guard;
+	// The intermediate chunks of each stream
+	std::map<StreamKey, std::shared_ptr<CmafStreamChunks>> _stream_chunk_map;
+	std::shared_mutex _stream_chunk_map_mutex;
 };
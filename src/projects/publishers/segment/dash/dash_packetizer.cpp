@@ -667,15 +667,15 @@ bool DashPacketizer::UpdatePlayList()
 
 	xml
 		// <UTCTiming />
-		<< R"(	<UTCTiming schemeIdUri="urn:mpeg:dash:utc:direct:2014" value="%s" />)" << std::endl;
+		// The value is the current time, which is filled when the playlist is requested
+		<< R"(	<UTCTiming schemeIdUri="urn:mpeg:dash:utc:direct:2014" value=")";
 
-	xml
-		// </MPD>
-		<< R"(</MPD>)";
-
-	ov::String play_list = xml.str().c_str();
+	ov::String head = xml.str().c_str();
+	ov::String tail = "\" />\n"
+					  // </MPD>
+					  "</MPD>";
 
-	SetPlayList(play_list);
+	SetPlayList(head, tail);
 
 	if (_stat_stop_watch.IsElapsed(5000) && _stat_stop_watch.Update())
 	{
@@ -892,18 +892,3 @@ void DashPacketizer::SetReadyForStreaming() noexcept
 
 	Packetizer::SetReadyForStreaming();
 }
-
-bool DashPacketizer::GetPlayList(ov::String &play_list)
-{
-	if (IsReadyForStreaming() == false)
-	{
-		logad("Manifest was requested before the stream began");
-		return false;
-	}
-
-	ov::String current_time = MakeUtcMillisecond();
-
-	play_list = ov::String::FormatString(_play_list.CStr(), current_time.CStr());
-
-	return true;
-}
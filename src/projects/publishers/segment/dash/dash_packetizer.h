@@ -61,8 +61,6 @@ public:
 	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const override;
 	bool SetSegmentData(Writer &writer, int64_t timestamp);
 
-	bool GetPlayList(ov::String &play_list) override;
-
 protected:
 	using DataCallback = std::function<void(const std::shared_ptr<const SampleData> &data, bool new_segment_written)>;
 
@@ -33,7 +33,7 @@ HttpConnectionPolicy DashStreamServer::ProcessStreamRequest(const std::shared_pt
 	response->SetStatusCode(HttpStatusCode::NotFound);
 	response->Response();
 
-	return HttpConnectionPolicy::Closed;
+	return HttpConnectionPolicy::KeepAlive;
 }
 
 HttpConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::shared_ptr<HttpConnection> &client,
@@ -42,7 +42,7 @@ HttpConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::shared_
 {
 	auto response = client->GetResponse();
 
-	ov::String play_list;
+	std::shared_ptr<const PlayList> play_list;
 
 	auto item = std::find_if(_observers.begin(), _observers.end(),
 							 [client, request_info, &play_list](std::shared_ptr<SegmentStreamObserver> &observer) -> bool {
@@ -55,13 +55,13 @@ HttpConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::shared_
 		response->SetStatusCode(HttpStatusCode::NotFound);
 		response->Response();
 
-		return HttpConnectionPolicy::Closed;
+		return HttpConnectionPolicy::KeepAlive;
 	}
 
-	if (response->GetStatusCode() != HttpStatusCode::OK || play_list.IsEmpty())
+	if (response->GetStatusCode() != HttpStatusCode::OK || play_list == nullptr)
 	{
 		response->Response();
-		return HttpConnectionPolicy::Closed;
+		return HttpConnectionPolicy::KeepAlive;
 	}
 
 	// Set HTTP header
@@ -70,12 +70,8 @@ HttpConnectionPolicy DashStreamServer::ProcessPlayListRequest(const std::shared_
 	response->SetHeader("Pragma", "no-cache");
 	response->SetHeader("Expires", "0");
 
-	response->AppendString(play_list);
-	auto sent_bytes = response->Response();
-
-	IncreaseBytesOut(client, sent_bytes);
-
-	return HttpConnectionPolicy::Closed;
+	// UTCTiming of MPD is the current time
+	return ResponsePlayList(client, play_list, Packetizer::MakeUtcMillisecond());
 }
 
 HttpConnectionPolicy DashStreamServer::ProcessSegmentRequest(const std::shared_ptr<HttpConnection> &client,
@@ -97,15 +93,8 @@ HttpConnectionPolicy DashStreamServer::ProcessSegmentRequest(const std::shared_p
 		response->SetStatusCode(HttpStatusCode::NotFound);
 		response->Response();
 
-		return HttpConnectionPolicy::Closed;
+		return HttpConnectionPolicy::KeepAlive;
 	}
 
-	// Set HTTP header
-	response->SetHeader("Content-Type", (segment->type == SegmentDataType::Video) ? "video/mp4" : "audio/mp4");
-	response->AppendData(segment->data);
-	auto sent_bytes = response->Response();
-
-	IncreaseBytesOut(client, sent_bytes);
-
-	return HttpConnectionPolicy::Closed;
+	return ResponseSegment(client, segment);
 }
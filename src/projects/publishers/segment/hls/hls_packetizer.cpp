@@ -9,13 +9,11 @@
 #include "hls_packetizer.h"
 
 #include <base/ovlibrary/ovlibrary.h>
-#include <modules/segment_writer/writer.h>
 #include <publishers/segment/segment_stream/packetizer/packetizer_define.h>
 
 #include <algorithm>
 #include <array>
-#include <iomanip>
-#include <sstream>
+#include <cinttypes>
 
 #include "hls_private.h"
 
@@ -41,9 +39,7 @@ HlsPacketizer::HlsPacketizer(const ov::String &app_name, const ov::String &strea
 	: Packetizer(app_name, stream_name,
 				 segment_count, segment_count * 5, segment_duration,
 				 video_track, audio_track,
-				 chunked_transfer),
-
-	  _ts_writer(Writer::Type::MpegTs, Writer::MediaType::Both)
+				 chunked_transfer)
 {
 	_video_enable = false;
 	_audio_enable = false;
@@ -306,33 +302,59 @@ bool HlsPacketizer::WriteSegment(int64_t timestamp, int64_t timestamp_in_ms, int
 
 bool HlsPacketizer::UpdatePlayList()
 {
-	std::ostringstream play_list_stream;
-	std::ostringstream m3u8_play_list;
-	double max_duration_in_ms = 0;
-
 	std::vector<std::shared_ptr<SegmentItem>> segment_datas;
 	Packetizer::GetVideoPlaySegments(segment_datas);
 
-	for (const auto &segment_data : segment_datas)
+	if (segment_datas.empty())
 	{
-		m3u8_play_list << "#EXTINF:" << std::fixed << std::setprecision(0)
-					   << (segment_data->duration_in_ms / 1000) << "\r\n"
-					   << segment_data->file_name.CStr() << "\r\n";
+		return false;
+	}
+
+	// Only the entries of the new segments are made, and the entries that are out of the window are removed
+	auto first_sequence_number = segment_datas.front()->sequence_number;
+
+	while ((_play_list_entries.empty() == false) && (_play_list_entries.front().sequence_number < first_sequence_number))
+	{
+		_play_list_entries.pop_front();
+	}
+
+	auto next_sequence_number = _play_list_entries.empty() ? first_sequence_number : (_play_list_entries.back().sequence_number + 1);
 
-		if (segment_data->duration_in_ms > max_duration_in_ms)
+	for (const auto &segment_data : segment_datas)
+	{
+		if (segment_data->sequence_number >= next_sequence_number)
 		{
-			max_duration_in_ms = segment_data->duration_in_ms;
+			PlayListEntry entry;
+
+			entry.sequence_number = segment_data->sequence_number;
+			entry.duration_in_ms = segment_data->duration_in_ms;
+			entry.line.Format("#EXTINF:%" PRId64 "\r\n"
+							  "%s\r\n",
+							  segment_data->duration_in_ms / 1000, segment_data->file_name.CStr());
+
+			_play_list_entries.push_back(std::move(entry));
 		}
 	}
 
-	play_list_stream << "#EXTM3U\r\n"
-					 << "#EXT-X-VERSION:3\r\n"
-					 << "#EXT-X-MEDIA-SEQUENCE:" << (_sequence_number - 1) << "\r\n"
-					 << "#EXT-X-ALLOW-CACHE:NO\r\n"
-					 << "#EXT-X-TARGETDURATION:" << std::fixed << std::setprecision(0) << (max_duration_in_ms / 1000) << "\r\n"
-					 << m3u8_play_list.str();
+	double max_duration_in_ms = 0;
 
-	ov::String play_list = play_list_stream.str().c_str();
+	for (const auto &entry : _play_list_entries)
+	{
+		max_duration_in_ms = std::max(max_duration_in_ms, static_cast<double>(entry.duration_in_ms));
+	}
+
+	auto play_list = ov::String::FormatString(
+		"#EXTM3U\r\n"
+		"#EXT-X-VERSION:3\r\n"
+		"#EXT-X-MEDIA-SEQUENCE:%u\r\n"
+		"#EXT-X-ALLOW-CACHE:NO\r\n"
+		"#EXT-X-TARGETDURATION:%.0f\r\n",
+		(_sequence_number - 1), (max_duration_in_ms / 1000));
+
+	for (const auto &entry : _play_list_entries)
+	{
+		play_list.Append(entry.line.CStr(), entry.line.GetLength());
+	}
 
 	// logad("%p %d %s", this, IsReadyForStreaming(), play_list.CStr());
 
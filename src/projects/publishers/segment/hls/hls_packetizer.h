@@ -8,7 +8,7 @@
 //==============================================================================
 #pragma once
 
-#include <modules/segment_writer/writer.h>
+#include <modules/mpegts/mpegts_packetizer.h>
 
 #include "../segment_stream/packetizer/packetizer.h"
 
@@ -74,6 +74,17 @@ protected:
 	int64_t _ideal_duration_for_video_in_ms = 0.0;
 	int64_t _ideal_duration_for_audio_in_ms = 0.0;
 
+	// An entry of the segment in the playlist (#EXTINF + URI)
+	struct PlayListEntry
+	{
+		int sequence_number = 0;
+		int64_t duration_in_ms = 0L;
+		ov::String line;
+	};
+
+	// Entries of the segments in the playlist, they are made once per segment
+	std::deque<PlayListEntry> _play_list_entries;
+
 	// Key: filename
 	std::map<ov::String, std::shared_ptr<SegmentItem>> _segment_map;
 	std::deque<std::shared_ptr<SegmentItem>> _segment_queue;
@@ -103,7 +114,7 @@ protected:
 	bool _video_ready = false;
 	bool _audio_ready = false;
 
-	Writer _ts_writer;
+	mpegts::MpegTsPacketizer _ts_writer;
 
 	ov::StopWatch _stat_stop_watch;
 };
@@ -35,7 +35,7 @@ bool HlsStreamPacketizer::AppendAudioData(const std::shared_ptr<MediaPacket> &me
 	return _packetizer->AppendAudioFrame(media_packet);
 }
 
-bool HlsStreamPacketizer::GetPlayList(ov::String &play_list)
+bool HlsStreamPacketizer::GetPlayList(std::shared_ptr<const PlayList> &play_list)
 {
 	return _packetizer->GetPlayList(play_list);
 }
@@ -28,7 +28,7 @@ HttpConnectionPolicy HlsStreamServer::ProcessStreamRequest(const std::shared_ptr
 
 	response->SetStatusCode(HttpStatusCode::NotFound);
 	response->Response();
-	return HttpConnectionPolicy::Closed;
+	return HttpConnectionPolicy::KeepAlive;
 }
 
 HttpConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::shared_ptr<HttpConnection> &client,
@@ -37,7 +37,7 @@ HttpConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::shared_p
 {
 	auto response = client->GetResponse();
 
-	ov::String play_list;
+	std::shared_ptr<const PlayList> play_list;
 
 	auto item = std::find_if(_observers.begin(), _observers.end(),
 							 [client, request_info, &play_list](std::shared_ptr<SegmentStreamObserver> &observer) -> bool {
@@ -50,14 +50,14 @@ HttpConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::shared_p
 		response->SetStatusCode(HttpStatusCode::NotFound);
 		response->Response();
 
-		return HttpConnectionPolicy::Closed;
+		return HttpConnectionPolicy::KeepAlive;
 	}
 
-	if (response->GetStatusCode() != HttpStatusCode::OK || play_list.IsEmpty())
+	if (response->GetStatusCode() != HttpStatusCode::OK || play_list == nullptr)
 	{
 		logte("Could not find a %s playlist for [%s/%s], %s : %d", GetPublisherName(), request_info.vhost_app_name.CStr(), request_info.stream_name.CStr(), request_info.file_name.CStr(), response->GetStatusCode());
 		response->Response();
-		return HttpConnectionPolicy::Closed;
+		return HttpConnectionPolicy::KeepAlive;
 	}
 
 	// Set HTTP header
@@ -66,12 +66,7 @@ HttpConnectionPolicy HlsStreamServer::ProcessPlayListRequest(const std::shared_p
 	response->SetHeader("Pragma", "no-cache");
 	response->SetHeader("Expires", "0");
 
-	response->AppendString(play_list);
-	auto sent_bytes = response->Response();
-
-	IncreaseBytesOut(client, sent_bytes);
-
-	return HttpConnectionPolicy::Closed;
+	return ResponsePlayList(client, play_list, "");
 }
 
 HttpConnectionPolicy HlsStreamServer::ProcessSegmentRequest(const std::shared_ptr<HttpConnection> &client,
@@ -93,15 +88,8 @@ HttpConnectionPolicy HlsStreamServer::ProcessSegmentRequest(const std::shared_pt
 		response->SetStatusCode(HttpStatusCode::NotFound);
 		response->Response();
 
-		return HttpConnectionPolicy::Closed;
+		return HttpConnectionPolicy::KeepAlive;
 	}
 
-	// Set HTTP header
-	response->SetHeader("Content-Type", "video/MP2T");
-	response->AppendData(segment->data);
-	auto sent_bytes = response->Response();
-
-	IncreaseBytesOut(client, sent_bytes);
-
-	return HttpConnectionPolicy::Closed;
+	return ResponseSegment(client, segment);
 }
@@ -79,7 +79,7 @@ bool SegmentPublisher::Stop()
 
 bool SegmentPublisher::OnPlayListRequest(const std::shared_ptr<HttpConnection> &client,
 										 const SegmentStreamRequestInfo &request_info,
-										 ov::String &play_list)
+										 std::shared_ptr<const PlayList> &play_list)
 {
 	auto request = client->GetRequest();
 	auto uri = request->GetUri();
@@ -138,6 +138,13 @@ bool SegmentPublisher::OnPlayListRequest(const std::shared_ptr<HttpConnection> &
 
 	request->SetExtra(std::static_pointer_cast<pub::Stream>(stream));
 
+	// Let the transcoder know that the stream is played, even if there is no playlist yet
+	auto stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(stream));
+	if (stream_metrics != nullptr)
+	{
+		stream_metrics->OnRequested();
+	}
+
 	if (stream->GetPlayList(play_list) == false)
 	{
 		logtw("Could not get a playlist for %s [%p, %s/%s, %s]", GetPublisherName(), stream.get(), vhost_app_name.CStr(), stream_name.CStr(), request_info.file_name.CStr());
@@ -162,6 +169,12 @@ bool SegmentPublisher::OnSegmentRequest(const std::shared_ptr<HttpConnection> &c
 
 	if (stream != nullptr)
 	{
+		auto stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(stream));
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->OnRequested();
+		}
+
 		segment = stream->GetSegmentData(file_name);
 
 		if (segment == nullptr)
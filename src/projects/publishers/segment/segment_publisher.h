@@ -214,7 +214,7 @@ protected:
 	//--------------------------------------------------------------------
 	bool OnPlayListRequest(const std::shared_ptr<HttpConnection> &client,
 						   const SegmentStreamRequestInfo &request_info,
-						   ov::String &play_list) override;
+						   std::shared_ptr<const PlayList> &play_list) override;
 
 	bool OnSegmentRequest(const std::shared_ptr<HttpConnection> &client,
 						  const SegmentStreamRequestInfo &request_info,
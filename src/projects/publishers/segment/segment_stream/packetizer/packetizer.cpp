@@ -118,9 +118,17 @@ uint64_t Packetizer::ConvertTimeScale(uint64_t time, const cmn::Timebase &from_t
 
 void Packetizer::SetPlayList(const ov::String &play_list)
 {
-	std::unique_lock<std::mutex> lock(_play_list_mutex);
+	// The playlist is compressed here (not per request)
+	std::shared_ptr<const PlayList> new_play_list = std::make_shared<PlayList>(++_play_list_version, play_list);
 
-	_play_list = play_list;
+	std::atomic_store(&_play_list, new_play_list);
+}
+
+void Packetizer::SetPlayList(const ov::String &head, const ov::String &tail)
+{
+	std::shared_ptr<const PlayList> new_play_list = std::make_shared<PlayList>(++_play_list_version, head, tail);
+
+	std::atomic_store(&_play_list, new_play_list);
 }
 
 bool Packetizer::IsReadyForStreaming() const noexcept
@@ -240,18 +248,16 @@ ov::String Packetizer::GetCodecString(const std::shared_ptr<const MediaTrack> &t
 	return codec_string;
 }
 
-bool Packetizer::GetPlayList(ov::String &play_list)
+bool Packetizer::GetPlayList(std::shared_ptr<const PlayList> &play_list)
 {
 	if (IsReadyForStreaming() == false)
 	{
 		return false;
 	}
 
-	std::unique_lock<std::mutex> lock(_play_list_mutex);
-
-	play_list = _play_list;
+	play_list = std::atomic_load(&_play_list);
 
-	return true;
+	return (play_list != nullptr);
 }
 
 bool Packetizer::GetVideoPlaySegments(std::vector<std::shared_ptr<SegmentItem>> &segment_datas)
@@ -15,6 +15,7 @@
 
 #include "packetizer_define.h"
 #include "chunked_transfer_interface.h"
+#include "play_list.h"
 
 class Packetizer
 {
@@ -50,10 +51,14 @@ public:
 	//   +--------+---------+--------+-----------+
 	static uint64_t ConvertTimeScale(uint64_t time, const cmn::Timebase &from_timebase, const cmn::Timebase &to_timebase);
 
+	// Publishes a new version of the playlist
 	void SetPlayList(const ov::String &play_list);
+	// Publishes a new version of the playlist which has a placeholder: [head][value][tail]
+	void SetPlayList(const ov::String &head, const ov::String &tail);
 
 	virtual bool IsReadyForStreaming() const noexcept;
-	virtual bool GetPlayList(ov::String &play_list);
+	// Doesn't take any lock, so it can be called for every request
+	virtual bool GetPlayList(std::shared_ptr<const PlayList> &play_list);
 
 	bool GetVideoPlaySegments(std::vector<std::shared_ptr<SegmentItem>> &segment_datas);
 	bool GetAudioPlaySegments(std::vector<std::shared_ptr<SegmentItem>> &segment_datas);
@@ -91,12 +96,13 @@ protected:
 	uint32_t _current_video_index = 0U;
 	uint32_t _current_audio_index = 0U;
 
-	ov::String _play_list;
+	// Replaced atomically (std::atomic_load()/std::atomic_store()) whenever the playlist is updated
+	std::shared_ptr<const PlayList> _play_list;
+	uint64_t _play_list_version = 0;
 	std::vector<std::shared_ptr<SegmentItem>> _video_segments;
 	// HLS packetizer doesn't use _audio_segments
 	std::vector<std::shared_ptr<SegmentItem>> _audio_segments;
 
-	mutable std::mutex _play_list_mutex;
 	mutable std::mutex _video_segment_mutex;
 	mutable std::mutex _audio_segment_mutex;
 };
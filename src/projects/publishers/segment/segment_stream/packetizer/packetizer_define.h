@@ -12,6 +12,8 @@
 #include <base/ovlibrary/ovlibrary.h>
 #include <string.h>
 
+#include <algorithm>
+#include <cinttypes>
 #include <deque>
 #include <map>
 #include <mutex>
@@ -20,6 +22,8 @@
 #define PACKTYZER_DEFAULT_TIMESCALE (90000)	 // 90MHz
 #define AVC_NAL_START_PATTERN_SIZE (4)		 // 0x00000001
 #define ADTS_HEADER_SIZE (7)
+// max-age of the segment = duration of the segment * SEGMENT_HTTP_MAX_AGE_RATIO
+#define SEGMENT_HTTP_MAX_AGE_RATIO (3)
 
 #pragma pack(push, 1)
 
@@ -65,6 +69,44 @@ public:
 		  duration_in_ms(duration_in_ms),
 		  data(data)
 	{
+		PrepareHttpHeaderFields();
+	}
+
+	static const char *GetContentType(SegmentDataType type, const ov::String &file_name)
+	{
+		if (file_name.HasSuffix(".ts"))
+		{
+			return "video/MP2T";
+		}
+
+		return (type == SegmentDataType::Audio) ? "audio/mp4" : "video/mp4";
+	}
+
+protected:
+	// Serializes the header fields of the HTTP response in advance, because the segment will not be changed
+	void PrepareHttpHeaderFields()
+	{
+		size_t length = (data != nullptr) ? data->GetLength() : 0;
+
+		content_type = GetContentType(type, file_name);
+
+		// The segment is identified by the creation time, sequence number and length
+		// (The file names are reused when the stream is restarted)
+		etag.Format("\"%lx-%x-%zx\"", static_cast<long>(creation_time), sequence_number, length);
+
+		// Let the caches revalidate the segment using ETag soon, since the file name will be reused
+		auto max_age = std::max<int64_t>(1, (duration_in_ms * SEGMENT_HTTP_MAX_AGE_RATIO) / 1000);
+		cache_control.Format("max-age=%" PRId64, max_age);
+
+		auto fields = ov::String::FormatString(
+			"Content-Type: %s\r\n"
+			"Content-Length: %zu\r\n"
+			"ETag: %s\r\n"
+			"Cache-Control: %s\r\n"
+			"Accept-Ranges: bytes\r\n",
+			content_type.CStr(), length, etag.CStr(), cache_control.CStr());
+
+		http_header_fields = fields.ToData(false);
 	}
 
 public:
@@ -78,6 +120,13 @@ public:
 	int64_t duration = 0L;
 	int64_t duration_in_ms = 0L;
 	std::shared_ptr<const ov::Data> data;
+
+	// Headers of the HTTP response
+	ov::String content_type;
+	ov::String etag;
+	ov::String cache_control;
+	// Pre-serialized header fields ("<Name>: <Value>\r\n" list) for the response that contains the whole segment
+	std::shared_ptr<const ov::Data> http_header_fields;
 };
 
 enum class PacketizerFrameType
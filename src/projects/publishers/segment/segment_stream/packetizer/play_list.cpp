@@ -0,0 +1,63 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "play_list.h"
+
+PlayList::PlayList(uint64_t version, const ov::String &play_list)
+	: _version(version),
+	  _has_placeholder(false),
+	  _data(play_list.ToData(false))
+{
+	auto gzip_data = ov::Compression::Gzip(_data);
+
+	if ((gzip_data != nullptr) && (gzip_data->GetLength() < _data->GetLength()))
+	{
+		_gzip_data = gzip_data;
+	}
+}
+
+PlayList::PlayList(uint64_t version, const ov::String &head, const ov::String &tail)
+	: _version(version),
+	  _has_placeholder(true),
+	  _data(head.ToData(false)),
+	  _tail(tail)
+{
+	auto gzip_data = ov::Compression::GzipHead(_data->GetData(), _data->GetLength(), &_gzip_head_crc);
+
+	if ((gzip_data != nullptr) && (gzip_data->GetLength() < _data->GetLength()))
+	{
+		_gzip_data = gzip_data;
+	}
+}
+
+bool PlayList::GetBody(bool use_gzip, const ov::String &value, std::vector<std::shared_ptr<const ov::Data>> &data_list) const
+{
+	use_gzip = use_gzip && (_gzip_data != nullptr);
+
+	if (_has_placeholder == false)
+	{
+		data_list.push_back(use_gzip ? _gzip_data : _data);
+		return use_gzip;
+	}
+
+	ov::String tail = value;
+	tail += _tail.CStr();
+
+	if (use_gzip)
+	{
+		data_list.push_back(_gzip_data);
+		data_list.push_back(ov::Compression::GzipTail(_gzip_head_crc, _data->GetLength(), tail.CStr(), tail.GetLength()));
+	}
+	else
+	{
+		data_list.push_back(_data);
+		data_list.push_back(tail.ToData(false));
+	}
+
+	return use_gzip;
+}
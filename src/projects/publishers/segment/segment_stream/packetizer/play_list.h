@@ -0,0 +1,54 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+// An immutable playlist (.m3u8, .mpd) with its pre-compressed (gzip) variant.
+//
+// The packetizer creates a new instance whenever the playlist is updated, and all requests share it.
+// A playlist can have a placeholder at the end (such as the current time of UTCTiming in MPD),
+// which is filled per request: [head][value][tail]
+class PlayList
+{
+public:
+	PlayList(uint64_t version, const ov::String &play_list);
+	PlayList(uint64_t version, const ov::String &head, const ov::String &tail);
+
+	uint64_t GetVersion() const
+	{
+		return _version;
+	}
+
+	bool HasPlaceholder() const
+	{
+		return _has_placeholder;
+	}
+
+	// Appends the body of the response to data_list. The data shares the memory of the playlist.
+	//
+	// @param use_gzip true if the client accepts gzip
+	// @param value A value of the placeholder (ignored if the playlist doesn't have a placeholder)
+	//
+	// @return true if the body is compressed using gzip
+	bool GetBody(bool use_gzip, const ov::String &value, std::vector<std::shared_ptr<const ov::Data>> &data_list) const;
+
+protected:
+	uint64_t _version = 0;
+	bool _has_placeholder = false;
+
+	// The whole playlist, or the head if it has a placeholder
+	std::shared_ptr<const ov::Data> _data;
+	ov::String _tail;
+
+	// The gzip member, or the compressed head if it has a placeholder
+	// (nullptr if the compressed data is not smaller than the original)
+	std::shared_ptr<const ov::Data> _gzip_data;
+	uint32_t _gzip_head_crc = 0;
+};
@@ -114,7 +114,7 @@ void SegmentStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_pac
 	}
 }
 
-bool SegmentStream::GetPlayList(ov::String &play_list)
+bool SegmentStream::GetPlayList(std::shared_ptr<const PlayList> &play_list)
 {
 	if (_stream_packetizer != nullptr)
 	{
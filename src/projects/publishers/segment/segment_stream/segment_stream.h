@@ -75,7 +75,7 @@ public:
 	bool Start() override;
 	bool Stop() override;
 
-	bool GetPlayList(ov::String &play_list);
+	bool GetPlayList(std::shared_ptr<const PlayList> &play_list);
 
 	std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const;
 
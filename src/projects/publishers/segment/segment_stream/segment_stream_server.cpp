@@ -220,6 +220,9 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<HttpConnection> &
 		response->SetHeader("Server", "OvenMediaEngine");
 		response->SetHeader("Content-Type", "text/html");
 
+		// Playlists and segments are requested repeatedly, so keep the connection if the client wants
+		client->PrepareKeepAlive();
+
 		// Check crossdomains
 		if (request_target.IndexOf("crossdomain.xml") >= 0)
 		{
@@ -257,6 +260,9 @@ bool SegmentStreamServer::ProcessRequest(const std::shared_ptr<HttpConnection> &
 			return response->Close();
 
 		case HttpConnectionPolicy::KeepAlive:
+			return client->CompleteResponse();
+
+		case HttpConnectionPolicy::Pending:
 			return true;
 
 		default:
@@ -391,6 +397,251 @@ bool SegmentStreamServer::UrlExistCheck(const std::vector<ov::String> &url_list,
 	return (item != url_list.end());
 }
 
+// Returns true if one of the entity tags in If-None-Match matches the etag (weak comparison)
+static bool IsETagMatched(const ov::String &if_none_match, const ov::String &etag)
+{
+	for (auto tag : if_none_match.Split(","))
+	{
+		tag = tag.Trim();
+
+		if (tag == "*")
+		{
+			return true;
+		}
+
+		if (tag.HasPrefix("W/"))
+		{
+			tag = tag.Substring(2);
+		}
+
+		if (tag == etag)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+enum class ByteRangeResult
+{
+	// Range header is invalid or not supported (multiple ranges), so it should be ignored
+	Ignore,
+	NotSatisfiable,
+	Satisfiable,
+};
+
+// Parses "bytes=<first>-<last>", "bytes=<first>-" and "bytes=-<suffix length>" (RFC7233 - 2.1. Byte Ranges)
+//
+// @param first The offset of the first byte
+// @param last The offset of the last byte (inclusive)
+static ByteRangeResult ParseByteRange(const ov::String &range, size_t length, size_t *first, size_t *last)
+{
+	if ((range.HasPrefix("bytes=") == false) || (range.IndexOf(',') >= 0))
+	{
+		return ByteRangeResult::Ignore;
+	}
+
+	auto tokens = range.Substring(6).Trim().Split("-");
+
+	if (tokens.size() != 2)
+	{
+		return ByteRangeResult::Ignore;
+	}
+
+	auto first_token = tokens[0].Trim();
+	auto last_token = tokens[1].Trim();
+
+	auto is_number = [](const ov::String &token) -> bool {
+		if (token.IsEmpty())
+		{
+			return false;
+		}
+
+		for (size_t index = 0; index < token.GetLength(); index++)
+		{
+			if (::isdigit(static_cast<unsigned char>(token.Get(index))) == 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	if (first_token.IsEmpty())
+	{
+		// bytes=-<suffix length>
+		if (is_number(last_token) == false)
+		{
+			return ByteRangeResult::Ignore;
+		}
+
+		auto suffix_length = std::strtoull(last_token.CStr(), nullptr, 10);
+
+		if ((suffix_length == 0) || (length == 0))
+		{
+			return ByteRangeResult::NotSatisfiable;
+		}
+
+		*first = (suffix_length >= length) ? 0 : (length - suffix_length);
+		*last = length - 1;
+
+		return ByteRangeResult::Satisfiable;
+	}
+
+	if ((is_number(first_token) == false) || ((last_token.IsEmpty() == false) && (is_number(last_token) == false)))
+	{
+		return ByteRangeResult::Ignore;
+	}
+
+	auto first_byte = std::strtoull(first_token.CStr(), nullptr, 10);
+	auto last_byte = last_token.IsEmpty() ? (length - 1) : std::strtoull(last_token.CStr(), nullptr, 10);
+
+	if (last_byte < first_byte)
+	{
+		return ByteRangeResult::Ignore;
+	}
+
+	if (first_byte >= length)
+	{
+		return ByteRangeResult::NotSatisfiable;
+	}
+
+	*first = first_byte;
+	*last = std::min<size_t>(last_byte, length - 1);
+
+	return ByteRangeResult::Satisfiable;
+}
+
+// Returns true if Accept-Encoding contains gzip (and it is not "gzip;q=0")
+static bool IsGzipAccepted(const ov::String &accept_encoding)
+{
+	for (auto &coding : accept_encoding.Split(","))
+	{
+		auto tokens = coding.Split(";");
+		auto name = tokens[0].Trim().LowerCaseString();
+
+		if ((name != "gzip") && (name != "x-gzip"))
+		{
+			continue;
+		}
+
+		for (size_t index = 1; index < tokens.size(); index++)
+		{
+			auto param = tokens[index].Trim();
+
+			if (param.HasPrefix("q=") && (std::strtod(param.CStr() + 2, nullptr) <= 0.0))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+HttpConnectionPolicy SegmentStreamServer::ResponsePlayList(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const PlayList> &play_list, const ov::String &value)
+{
+	auto request = client->GetRequest();
+	auto response = client->GetResponse();
+
+	std::vector<std::shared_ptr<const ov::Data>> data_list;
+
+	if (play_list->GetBody(IsGzipAccepted(request->GetHeader("ACCEPT-ENCODING")), value, data_list))
+	{
+		response->SetHeader("Content-Encoding", "gzip");
+	}
+
+	response->SetHeader("Vary", "Accept-Encoding");
+
+	for (const auto &data : data_list)
+	{
+		response->AppendData(data);
+	}
+
+	IncreaseBytesOut(client, response->Response());
+
+	return HttpConnectionPolicy::KeepAlive;
+}
+
+HttpConnectionPolicy SegmentStreamServer::ResponseSegment(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const SegmentItem> &segment)
+{
+	auto request = client->GetRequest();
+	auto response = client->GetResponse();
+
+	auto &data = segment->data;
+	size_t length = (data != nullptr) ? data->GetLength() : 0;
+
+	auto if_none_match = request->GetHeader("IF-NONE-MATCH");
+
+	if ((if_none_match.IsEmpty() == false) && IsETagMatched(if_none_match, segment->etag))
+	{
+		// RFC7232 - 4.1. 304 Not Modified
+		response->SetStatusCode(HttpStatusCode::NotModified);
+		response->SetHeader("ETag", segment->etag);
+		response->SetHeader("Cache-Control", segment->cache_control);
+		response->SetHeader("Content-Length", ov::Converter::ToString(length));
+		response->RemoveHeader("Content-Type");
+
+		IncreaseBytesOut(client, response->Response());
+
+		return HttpConnectionPolicy::KeepAlive;
+	}
+
+	auto range = request->GetHeader("RANGE");
+
+	// If the representation is changed, If-Range makes the server send the whole segment
+	if ((range.IsEmpty() == false) && (request->IsHeaderExists("IF-RANGE") == false || (request->GetHeader("IF-RANGE") == segment->etag)))
+	{
+		size_t first = 0;
+		size_t last = 0;
+
+		switch (ParseByteRange(range, length, &first, &last))
+		{
+			case ByteRangeResult::Ignore:
+				break;
+
+			case ByteRangeResult::NotSatisfiable:
+				response->SetStatusCode(HttpStatusCode::RangeNotSatisfiable);
+				response->SetHeader("Content-Range", ov::String::FormatString("bytes */%zu", length));
+				response->RemoveHeader("Content-Type");
+
+				IncreaseBytesOut(client, response->Response());
+
+				return HttpConnectionPolicy::KeepAlive;
+
+			case ByteRangeResult::Satisfiable:
+				response->SetStatusCode(HttpStatusCode::PartialContent);
+				response->SetHeader("Content-Type", segment->content_type);
+				response->SetHeader("Content-Range", ov::String::FormatString("bytes %zu-%zu/%zu", first, last, length));
+				response->SetHeader("ETag", segment->etag);
+				response->SetHeader("Cache-Control", segment->cache_control);
+				// The range shares the memory of the segment
+				response->AppendData(data->Subdata(first, last - first + 1));
+
+				IncreaseBytesOut(client, response->Response());
+
+				return HttpConnectionPolicy::KeepAlive;
+		}
+	}
+
+	// The header fields of the segment are serialized in advance, and the data of the segment is shared
+	response->RemoveHeader("Content-Type");
+	response->SetPreparedHeaderFields(segment->http_header_fields);
+
+	if (data != nullptr)
+	{
+		response->AppendData(data);
+	}
+
+	IncreaseBytesOut(client, response->Response());
+
+	return HttpConnectionPolicy::KeepAlive;
+}
+
 bool SegmentStreamServer::IncreaseBytesOut(const std::shared_ptr<HttpConnection> &client, size_t sent_bytes)
 {
 	auto request = client->GetRequest();
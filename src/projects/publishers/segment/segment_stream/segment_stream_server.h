@@ -73,6 +73,15 @@ protected:
 												 const SegmentStreamRequestInfo &request_info,
 												 SegmentType segment_type) = 0;
 
+	// Responds the playlist (gzip compressed if the client accepts it)
+	//
+	// @param value A value of the placeholder of the playlist
+	HttpConnectionPolicy ResponsePlayList(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const PlayList> &play_list, const ov::String &value);
+
+	// Responds the segment using the pre-serialized header fields
+	// (Handles If-None-Match and Range/If-Range)
+	HttpConnectionPolicy ResponseSegment(const std::shared_ptr<HttpConnection> &client, const std::shared_ptr<const SegmentItem> &segment);
+
 	bool UrlExistCheck(const std::vector<ov::String> &url_list, const ov::String &check_url);
 
 	bool IncreaseBytesOut(const std::shared_ptr<HttpConnection> &client, size_t sent_bytes);
@@ -49,7 +49,7 @@ public:
 	virtual bool AppendVideoFrame(const std::shared_ptr<const PacketizerFrameData> &dEncodedFrameata) = 0;
 	virtual bool AppendAudioFrame(const std::shared_ptr<const PacketizerFrameData> &data) = 0;
 
-	virtual bool GetPlayList(ov::String &play_list) = 0;
+	virtual bool GetPlayList(std::shared_ptr<const PlayList> &play_list) = 0;
 	virtual std::shared_ptr<const SegmentItem> GetSegmentData(const ov::String &file_name) const = 0;
 
 protected:
@@ -4,5 +4,8 @@ include $(DEFAULT_VARIABLES)
 LOCAL_TARGET := thumbnail_publisher
 
 $(call add_pkg_config,srt)
+$(call add_pkg_config,libavcodec)
+$(call add_pkg_config,libswscale)
+$(call add_pkg_config,libavutil)
 
 include $(BUILD_STATIC_LIBRARY)
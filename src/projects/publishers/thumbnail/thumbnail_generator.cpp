@@ -0,0 +1,260 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "thumbnail_generator.h"
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+
+#include "thumbnail_private.h"
+
+static AVCodecID ToAVCodecId(cmn::MediaCodecId codec_id)
+{
+	switch (codec_id)
+	{
+		case cmn::MediaCodecId::H264:
+			return AV_CODEC_ID_H264;
+		case cmn::MediaCodecId::H265:
+			return AV_CODEC_ID_HEVC;
+		case cmn::MediaCodecId::Vp8:
+			return AV_CODEC_ID_VP8;
+		case cmn::MediaCodecId::Jpeg:
+			return AV_CODEC_ID_MJPEG;
+		case cmn::MediaCodecId::Png:
+			return AV_CODEC_ID_PNG;
+		default:
+			return AV_CODEC_ID_NONE;
+	}
+}
+
+static AVFrame *DecodeKeyFrame(const std::shared_ptr<const MediaTrack> &track, const std::shared_ptr<const MediaPacket> &key_frame)
+{
+	auto codec_id = ToAVCodecId(track->GetCodecId());
+
+	AVCodec *codec = ::avcodec_find_decoder(codec_id);
+	if (codec == nullptr)
+	{
+		logte("Could not find decoder: %s (%d)", ::avcodec_get_name(codec_id), codec_id);
+		return nullptr;
+	}
+
+	AVCodecContext *context = ::avcodec_alloc_context3(codec);
+	if (context == nullptr)
+	{
+		logte("Could not allocate codec context for %s (%d)", ::avcodec_get_name(codec_id), codec_id);
+		return nullptr;
+	}
+
+	// Like the decoders of the transcoder, no extradata is set. The key frame is Annex-B and the mediarouter inserts the parameter sets
+	// in front of it, but the extradata of the track is an avcC/hvcC record, which makes the decoder parse the packet as length-prefixed NAL units.
+
+	AVFrame *frame = nullptr;
+	AVPacket *packet = ::av_packet_alloc();
+	auto data = key_frame->GetData();
+
+	if ((packet != nullptr) && (::avcodec_open2(context, codec, nullptr) == 0))
+	{
+		// av_new_packet() allocates the padding that the decoder requires
+		if (::av_new_packet(packet, static_cast<int>(data->GetLength())) == 0)
+		{
+			::memcpy(packet->data, data->GetData(), data->GetLength());
+			packet->pts = key_frame->GetPts();
+			packet->dts = key_frame->GetDts();
+			packet->flags = AV_PKT_FLAG_KEY;
+
+			frame = ::av_frame_alloc();
+
+			// Drain the decoder to get the frame of the packet right away
+			if ((frame != nullptr) &&
+				((::avcodec_send_packet(context, packet) < 0) ||
+				 (::avcodec_send_packet(context, nullptr) < 0) ||
+				 (::avcodec_receive_frame(context, frame) < 0)))
+			{
+				logtw("Could not decode the key frame: %s, size: %zu", ::avcodec_get_name(codec_id), data->GetLength());
+				::av_frame_free(&frame);
+			}
+		}
+	}
+	else
+	{
+		logte("Could not open codec: %s (%d)", ::avcodec_get_name(codec_id), codec_id);
+	}
+
+	::av_packet_free(&packet);
+	::avcodec_free_context(&context);
+
+	return frame;
+}
+
+static AVFrame *ScaleFrame(const AVFrame *frame, AVPixelFormat pixel_format, int width, int height)
+{
+	if ((width <= 0) && (height <= 0))
+	{
+		width = frame->width;
+		height = frame->height;
+	}
+	else if (width <= 0)
+	{
+		width = frame->width * height / frame->height;
+	}
+	else if (height <= 0)
+	{
+		height = frame->height * width / frame->width;
+	}
+
+	// The chroma planes of YUV 4:2:0 need an even size
+	width = std::max(width & ~1, 2);
+	height = std::max(height & ~1, 2);
+
+	auto sws_context = ::sws_getContext(frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+										width, height, pixel_format,
+										SWS_BILINEAR, nullptr, nullptr, nullptr);
+	if (sws_context == nullptr)
+	{
+		logte("Could not create the scaler: %dx%d -> %dx%d", frame->width, frame->height, width, height);
+		return nullptr;
+	}
+
+	AVFrame *scaled_frame = ::av_frame_alloc();
+
+	if (scaled_frame != nullptr)
+	{
+		scaled_frame->format = pixel_format;
+		scaled_frame->width = width;
+		scaled_frame->height = height;
+
+		if ((::av_frame_get_buffer(scaled_frame, 32) < 0) ||
+			(::sws_scale(sws_context, frame->data, frame->linesize, 0, frame->height, scaled_frame->data, scaled_frame->linesize) <= 0))
+		{
+			logte("Could not scale the frame: %dx%d -> %dx%d", frame->width, frame->height, width, height);
+			::av_frame_free(&scaled_frame);
+		}
+	}
+
+	::sws_freeContext(sws_context);
+
+	return scaled_frame;
+}
+
+static std::shared_ptr<ov::Data> EncodeImage(const AVFrame *frame, AVCodecID codec_id)
+{
+	AVCodec *codec = ::avcodec_find_encoder(codec_id);
+	if (codec == nullptr)
+	{
+		logte("Could not find encoder: %s (%d)", ::avcodec_get_name(codec_id), codec_id);
+		return nullptr;
+	}
+
+	AVCodecContext *context = ::avcodec_alloc_context3(codec);
+	if (context == nullptr)
+	{
+		logte("Could not allocate codec context for %s (%d)", ::avcodec_get_name(codec_id), codec_id);
+		return nullptr;
+	}
+
+	context->time_base = (AVRational){1, 1};
+	context->pix_fmt = static_cast<AVPixelFormat>(frame->format);
+	context->width = frame->width;
+	context->height = frame->height;
+
+	if (codec_id == AV_CODEC_ID_MJPEG)
+	{
+		// Same quality as the JPEG encoder of the transcoder
+		context->flags = AV_CODEC_FLAG_QSCALE;
+		context->global_quality = context->qmin * FF_QP2LAMBDA;
+	}
+
+	std::shared_ptr<ov::Data> image;
+	AVPacket *packet = ::av_packet_alloc();
+
+	if ((packet != nullptr) && (::avcodec_open2(context, codec, nullptr) == 0))
+	{
+		if ((::avcodec_send_frame(context, frame) == 0) &&
+			(::avcodec_send_frame(context, nullptr) == 0) &&
+			(::avcodec_receive_packet(context, packet) == 0))
+		{
+			image = std::make_shared<ov::Data>(packet->data, packet->size);
+		}
+		else
+		{
+			logte("Could not encode the image: %s, %dx%d", ::avcodec_get_name(codec_id), frame->width, frame->height);
+		}
+	}
+	else
+	{
+		logte("Could not open codec: %s (%d)", ::avcodec_get_name(codec_id), codec_id);
+	}
+
+	::av_packet_free(&packet);
+	::avcodec_free_context(&context);
+
+	return image;
+}
+
+bool ThumbnailGenerator::IsSupportedCodec(cmn::MediaCodecId codec_id)
+{
+	switch (codec_id)
+	{
+		case cmn::MediaCodecId::H264:
+		case cmn::MediaCodecId::H265:
+		case cmn::MediaCodecId::Vp8:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+std::shared_ptr<ov::Data> ThumbnailGenerator::Generate(const std::shared_ptr<const MediaTrack> &track,
+													   const std::shared_ptr<const MediaPacket> &key_frame,
+													   cmn::MediaCodecId image_codec_id,
+													   int width, int height)
+{
+	if ((track == nullptr) || (key_frame == nullptr) || (IsSupportedCodec(track->GetCodecId()) == false))
+	{
+		return nullptr;
+	}
+
+	AVPixelFormat pixel_format;
+
+	switch (image_codec_id)
+	{
+		case cmn::MediaCodecId::Jpeg:
+			pixel_format = AV_PIX_FMT_YUVJ420P;
+			break;
+
+		case cmn::MediaCodecId::Png:
+			pixel_format = AV_PIX_FMT_RGB24;
+			break;
+
+		default:
+			return nullptr;
+	}
+
+	AVFrame *decoded_frame = DecodeKeyFrame(track, key_frame);
+	if (decoded_frame == nullptr)
+	{
+		return nullptr;
+	}
+
+	AVFrame *scaled_frame = ScaleFrame(decoded_frame, pixel_format, width, height);
+	::av_frame_free(&decoded_frame);
+
+	if (scaled_frame == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto image = EncodeImage(scaled_frame, ToAVCodecId(image_codec_id));
+	::av_frame_free(&scaled_frame);
+
+	return image;
+}
@@ -0,0 +1,33 @@
+//==============================================================================
+//
+//  OvenMediaEngine
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/common_types.h>
+#include <base/info/media_track.h>
+#include <base/mediarouter/media_buffer.h>
+
+// Makes a JPEG/PNG image from a compressed video key frame.
+// It is used to make the thumbnail only when it's requested, instead of encoding the images of every stream continuously.
+class ThumbnailGenerator
+{
+public:
+	// @return true if the key frame of the codec can be decoded (H.264, H.265, VP8)
+	static bool IsSupportedCodec(cmn::MediaCodecId codec_id);
+
+	// @param track The track of the key frame
+	// @param key_frame A key frame that can be decoded by itself
+	// @param image_codec_id Jpeg or Png
+	// @param width, height Size of the image. If one of them is 0, it is calculated by the aspect ratio. If both are 0, the size of the video is used.
+	//
+	// @return The encoded image, or nullptr if an error occurred
+	static std::shared_ptr<ov::Data> Generate(const std::shared_ptr<const MediaTrack> &track,
+											  const std::shared_ptr<const MediaPacket> &key_frame,
+											  cmn::MediaCodecId image_codec_id,
+											  int width, int height);
+};
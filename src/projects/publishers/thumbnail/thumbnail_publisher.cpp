@@ -1,6 +1,7 @@
 #include "thumbnail_publisher.h"
 
 #include <base/ovlibrary/url.h>
+#include <monitoring/monitoring.h>
 
 #include "thumbnail_private.h"
 
@@ -179,6 +180,13 @@ std::shared_ptr<HttpRequestInterceptor> ThumbnailPublisher::CreateInterceptor()
 			return HttpNextHandler::DoNotCall;
 		}
 
+		// Let the transcoder know that the thumbnail is requested
+		auto stream_metrics = StreamMetrics(*std::static_pointer_cast<info::Stream>(stream));
+		if (stream_metrics != nullptr)
+		{
+			stream_metrics->OnRequested();
+		}
+
 		/*
 		// Check Filename
 		if (file_name.IndexOf("thumb") != 0)
@@ -4,6 +4,7 @@
 
 #include "base/publisher/application.h"
 #include "base/publisher/stream.h"
+#include "thumbnail_generator.h"
 #include "thumbnail_private.h"
 
 std::shared_ptr<ThumbnailStream> ThumbnailStream::Create(const std::shared_ptr<pub::Application> application,
@@ -39,6 +40,13 @@ bool ThumbnailStream::Start()
 {
 	logtd("ThumbnailStream(%ld) has been started", GetId());
 
+	auto &on_demand_config = GetApplication()->GetConfig().GetPublishers().GetThumbnailPublisher().GetOnDemand();
+
+	_is_on_demand = on_demand_config.IsParsed();
+	_on_demand_width = on_demand_config.GetWidth();
+	_on_demand_height = on_demand_config.GetHeight();
+	_cache_ttl = on_demand_config.GetCacheTtl();
+
 	return Stream::Start();
 }
 
@@ -60,6 +68,19 @@ void ThumbnailStream::SendVideoFrame(const std::shared_ptr<MediaPacket> &media_p
 
 	if (!(track->GetCodecId() == cmn::MediaCodecId::Png || track->GetCodecId() == cmn::MediaCodecId::Jpeg))
 	{
+		if (_is_on_demand && (media_packet->GetFlag() == MediaPacketFlag::Key) && ThumbnailGenerator::IsSupportedCodec(track->GetCodecId()))
+		{
+			std::lock_guard<std::shared_mutex> lock(_key_frame_mutex);
+
+			// Keep the key frame of the largest video track only
+			if ((_key_frame_track == nullptr) || (_key_frame_track == track) ||
+				((track->GetWidth() * track->GetHeight()) > (_key_frame_track->GetWidth() * _key_frame_track->GetHeight())))
+			{
+				_key_frame_track = track;
+				_key_frame = media_packet->ClonePacket();
+			}
+		}
+
 		// Could not support codec for image
 		return;
 	}
@@ -76,6 +97,17 @@ void ThumbnailStream::SendAudioFrame(const std::shared_ptr<MediaPacket> &media_p
 
 std::shared_ptr<ov::Data> ThumbnailStream::GetVideoFrameByCodecId(cmn::MediaCodecId codec_id)
 {
+	if (_is_on_demand)
+	{
+		auto video_frame = GetOnDemandVideoFrame(codec_id);
+		if (video_frame != nullptr)
+		{
+			return video_frame;
+		}
+
+		// Use the image of the transcoder if there is no key frame yet
+	}
+
 	std::shared_lock<std::shared_mutex> lock(_encoded_frame_mutex);
 
 	auto it = _encoded_frames.find(codec_id);
@@ -85,4 +117,50 @@ std::shared_ptr<ov::Data> ThumbnailStream::GetVideoFrameByCodecId(cmn::MediaCode
 	}
 
 	return it->second;
-}
\ No newline at end of file
+}
+std::shared_ptr<ov::Data> ThumbnailStream::GetOnDemandVideoFrame(cmn::MediaCodecId codec_id)
+{
+	std::shared_ptr<const MediaTrack> track;
+	std::shared_ptr<const MediaPacket> key_frame;
+
+	{
+		std::shared_lock<std::shared_mutex> lock(_key_frame_mutex);
+
+		track = _key_frame_track;
+		key_frame = _key_frame;
+	}
+
+	if (key_frame == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(_cached_image_mutex);
+
+	auto now = static_cast<int64_t>(ov::Clock::NowMSec());
+	auto &cached_image = _cached_images[codec_id];
+
+	// Reuse the image until it expires, or while there is no new key frame
+	if ((cached_image.image != nullptr) &&
+		((cached_image.key_frame == key_frame) || ((now - cached_image.created_time) < _cache_ttl)))
+	{
+		return cached_image.image;
+	}
+
+	auto image = ThumbnailGenerator::Generate(track, key_frame, codec_id, _on_demand_width, _on_demand_height);
+	if (image == nullptr)
+	{
+		logtw("Could not make the thumbnail of %s/%s", GetApplicationName(), GetName().CStr());
+
+		// Keep the previous image
+		return cached_image.image;
+	}
+
+	logtd("Thumbnail of %s/%s has been made (%s, %zu bytes)", GetApplicationName(), GetName().CStr(), (codec_id == cmn::MediaCodecId::Jpeg) ? "jpg" : "png", image->GetLength());
+
+	cached_image.image = image;
+	cached_image.key_frame = key_frame;
+	cached_image.created_time = now;
+
+	return image;
+}
@@ -19,12 +19,38 @@ public:
 	void SendVideoFrame(const std::shared_ptr<MediaPacket> &media_packet) override;
 	void SendAudioFrame(const std::shared_ptr<MediaPacket> &media_packet) override;
 
+	// If <OnDemand> is configured, the image is made from the last key frame of the video
 	std::shared_ptr<ov::Data> GetVideoFrameByCodecId(cmn::MediaCodecId codec_id);
 private:
 	bool Start() override;
 	bool Stop() override;
 
+	std::shared_ptr<ov::Data> GetOnDemandVideoFrame(cmn::MediaCodecId codec_id);
+
 	std::shared_mutex _encoded_frame_mutex;
 	std::map<cmn::MediaCodecId, std::shared_ptr<ov::Data>> _encoded_frames;
+
+	// On-demand thumbnail
+	bool _is_on_demand = false;
+	int _on_demand_width = 0;
+	int _on_demand_height = 0;
+	int64_t _cache_ttl = 0;
+
+	std::shared_mutex _key_frame_mutex;
+	// The last key frame of the largest video track
+	std::shared_ptr<const MediaTrack> _key_frame_track;
+	std::shared_ptr<const MediaPacket> _key_frame;
+
+	struct CachedImage
+	{
+		std::shared_ptr<ov::Data> image;
+		// The key frame that the image is made from
+		std::shared_ptr<const MediaPacket> key_frame;
+		// Unit: milliseconds
+		int64_t created_time = 0;
+	};
+	// Held while making the image, so that the concurrent requests don't decode the same key frame
+	std::mutex _cached_image_mutex;
+	std::map<cmn::MediaCodecId, CachedImage> _cached_images;
 	std::shared_ptr<mon::StreamMetrics> _stream_metrics;
 };
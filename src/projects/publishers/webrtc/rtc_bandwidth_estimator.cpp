@@ -0,0 +1,342 @@
+#include "rtc_bandwidth_estimator.h"
+#include "rtc_private.h"
+
+#include <cmath>
+
+// The estimate is decreased at most once in this time (Unit: microseconds)
+#define RTC_BWE_DECREASE_INTERVAL_US		(200 * 1000)
+#define RTC_BWE_DECREASE_FACTOR				0.85
+// Increase rate per second in the normal state
+#define RTC_BWE_INCREASE_FACTOR				1.08
+// Smoothing factor of the accumulated delay
+#define RTC_BWE_SMOOTHING_COEFFICIENT		0.9
+#define RTC_BWE_TRENDLINE_GAIN				4.0
+// Parameters of the adaptive threshold (Unit: milliseconds)
+#define RTC_BWE_THRESHOLD_MIN				6.0
+#define RTC_BWE_THRESHOLD_MAX				600.0
+#define RTC_BWE_THRESHOLD_K_UP				0.0087
+#define RTC_BWE_THRESHOLD_K_DOWN			0.039
+// Loss ratio over which the estimate is decreased
+#define RTC_BWE_HIGH_LOSS_RATIO				0.1
+
+RtcBandwidthEstimator::RtcBandwidthEstimator(uint64_t start_bitrate)
+{
+	_estimated_bitrate = ClampBitrate(start_bitrate);
+}
+
+int64_t RtcBandwidthEstimator::GetNowUs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RtcBandwidthEstimator::OnPacketSent(uint16_t transport_sequence_number, size_t size, int64_t send_time_us)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto &sent_packet = _send_history[transport_sequence_number & (RTC_BWE_SEND_HISTORY_SIZE - 1)];
+
+	sent_packet.sequence_number = transport_sequence_number;
+	sent_packet.size = size;
+	sent_packet.send_time_us = (send_time_us != 0) ? send_time_us : GetNowUs();
+}
+
+void RtcBandwidthEstimator::OnTransportFeedback(const TransportCc &feedback)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_has_feedback = true;
+
+	for(const auto &packet_feedback : feedback.GetPacketFeedbacks())
+	{
+		if(packet_feedback.received == false)
+		{
+			continue;
+		}
+
+		const auto &sent_packet = _send_history[packet_feedback.sequence_number & (RTC_BWE_SEND_HISTORY_SIZE - 1)];
+		if(sent_packet.send_time_us == 0 || sent_packet.sequence_number != packet_feedback.sequence_number)
+		{
+			// Too old, or not sent by this session
+			continue;
+		}
+
+		UpdateAckedBitrate(packet_feedback.arrival_time_us, sent_packet.size);
+
+		if(_has_group == false)
+		{
+			_current_group.first_send_time_us = sent_packet.send_time_us;
+			_current_group.last_send_time_us = sent_packet.send_time_us;
+			_current_group.last_arrival_time_us = packet_feedback.arrival_time_us;
+			_has_group = true;
+			continue;
+		}
+
+		if(sent_packet.send_time_us < _current_group.first_send_time_us)
+		{
+			// Reordered packet of the previous group
+			continue;
+		}
+
+		if(sent_packet.send_time_us - _current_group.first_send_time_us <= RTC_BWE_BURST_TIME_US)
+		{
+			_current_group.last_send_time_us = std::max(_current_group.last_send_time_us, sent_packet.send_time_us);
+			_current_group.last_arrival_time_us = std::max(_current_group.last_arrival_time_us, packet_feedback.arrival_time_us);
+			continue;
+		}
+
+		OnPacketGroup(_current_group);
+
+		_current_group.first_send_time_us = sent_packet.send_time_us;
+		_current_group.last_send_time_us = sent_packet.send_time_us;
+		_current_group.last_arrival_time_us = packet_feedback.arrival_time_us;
+	}
+
+	UpdateDelayBasedBitrate(GetNowUs());
+}
+
+void RtcBandwidthEstimator::OnRemb(uint64_t bitrate)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_remb_bitrate = bitrate;
+
+	if(_has_feedback == false)
+	{
+		// The receiver estimates the bandwidth by itself, follow it (increases slowly to avoid a jump of the rendition)
+		auto now = GetNowUs();
+
+		if(static_cast<double>(bitrate) < _estimated_bitrate)
+		{
+			_estimated_bitrate = ClampBitrate(bitrate);
+			_last_decrease_time_us = now;
+		}
+		else if(_last_increase_time_us != 0)
+		{
+			auto elapsed = std::min((now - _last_increase_time_us) / 1000000.0, 1.0);
+			_estimated_bitrate = ClampBitrate(std::min(_estimated_bitrate * std::pow(RTC_BWE_INCREASE_FACTOR, elapsed), static_cast<double>(bitrate)));
+		}
+
+		_last_increase_time_us = now;
+	}
+}
+
+void RtcBandwidthEstimator::OnReceiverReport(uint8_t fraction_lost)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto loss_ratio = fraction_lost / 256.0;
+
+	if(loss_ratio <= RTC_BWE_HIGH_LOSS_RATIO)
+	{
+		return;
+	}
+
+	auto now = GetNowUs();
+
+	if(now - _last_loss_decrease_time_us > RTC_BWE_DECREASE_INTERVAL_US)
+	{
+		_estimated_bitrate = ClampBitrate(_estimated_bitrate * (1.0 - (0.5 * loss_ratio)));
+		_last_loss_decrease_time_us = now;
+
+		logtd("High loss is reported (%.1f%%), estimated bitrate: %.0f", loss_ratio * 100.0, _estimated_bitrate);
+	}
+}
+
+uint64_t RtcBandwidthEstimator::GetEstimatedBitrate()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto bitrate = static_cast<uint64_t>(_estimated_bitrate);
+
+	if(_remb_bitrate != 0)
+	{
+		bitrate = std::min(bitrate, _remb_bitrate);
+	}
+
+	return bitrate;
+}
+
+void RtcBandwidthEstimator::OnPacketGroup(const PacketGroup &group)
+{
+	if(_has_previous_group)
+	{
+		auto send_delta_us = group.last_send_time_us - _previous_group.last_send_time_us;
+		auto arrival_delta_us = group.last_arrival_time_us - _previous_group.last_arrival_time_us;
+
+		UpdateTrend((arrival_delta_us - send_delta_us) / 1000.0, group.last_arrival_time_us);
+	}
+
+	_previous_group = group;
+	_has_previous_group = true;
+}
+
+void RtcBandwidthEstimator::UpdateTrend(double delay_variation_ms, int64_t arrival_time_us)
+{
+	if(_first_arrival_time_us < 0)
+	{
+		_first_arrival_time_us = arrival_time_us;
+	}
+
+	_num_delay_samples++;
+
+	_accumulated_delay_ms += delay_variation_ms;
+	_smoothed_delay_ms = (RTC_BWE_SMOOTHING_COEFFICIENT * _smoothed_delay_ms) + ((1.0 - RTC_BWE_SMOOTHING_COEFFICIENT) * _accumulated_delay_ms);
+
+	_delay_samples.push_back({(arrival_time_us - _first_arrival_time_us) / 1000.0, _smoothed_delay_ms});
+	if(_delay_samples.size() > RTC_BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		_delay_samples.pop_front();
+	}
+
+	if(_delay_samples.size() < RTC_BWE_TRENDLINE_WINDOW_SIZE)
+	{
+		return;
+	}
+
+	// Slope of the linear regression of the delay
+	double mean_x = 0.0;
+	double mean_y = 0.0;
+
+	for(const auto &sample : _delay_samples)
+	{
+		mean_x += sample.arrival_time_ms;
+		mean_y += sample.smoothed_delay_ms;
+	}
+
+	mean_x /= _delay_samples.size();
+	mean_y /= _delay_samples.size();
+
+	double numerator = 0.0;
+	double denominator = 0.0;
+
+	for(const auto &sample : _delay_samples)
+	{
+		auto x = sample.arrival_time_ms - mean_x;
+
+		numerator += x * (sample.smoothed_delay_ms - mean_y);
+		denominator += x * x;
+	}
+
+	if(denominator == 0.0)
+	{
+		return;
+	}
+
+	auto slope = numerator / denominator;
+	auto trend = std::min<size_t>(_num_delay_samples, 60) * slope * RTC_BWE_TRENDLINE_GAIN;
+
+	if(trend > _threshold)
+	{
+		// Overuse is detected when the delay keeps increasing
+		if(trend >= _previous_trend)
+		{
+			_overuse_count++;
+
+			if(_overuse_count > 1)
+			{
+				_usage = BandwidthUsage::Overusing;
+			}
+		}
+	}
+	else if(trend < -_threshold)
+	{
+		_overuse_count = 0;
+		_usage = BandwidthUsage::Underusing;
+	}
+	else
+	{
+		_overuse_count = 0;
+		_usage = BandwidthUsage::Normal;
+	}
+
+	_previous_trend = trend;
+
+	UpdateThreshold(trend, GetNowUs());
+}
+
+void RtcBandwidthEstimator::UpdateThreshold(double trend, int64_t now_us)
+{
+	if(_last_threshold_update_us == 0)
+	{
+		_last_threshold_update_us = now_us;
+	}
+
+	auto abs_trend = std::fabs(trend);
+
+	// Don't adapt to the spikes
+	if(abs_trend > _threshold + 15.0)
+	{
+		_last_threshold_update_us = now_us;
+		return;
+	}
+
+	auto k = (abs_trend < _threshold) ? RTC_BWE_THRESHOLD_K_DOWN : RTC_BWE_THRESHOLD_K_UP;
+	auto elapsed_ms = std::min((now_us - _last_threshold_update_us) / 1000.0, 100.0);
+
+	_threshold += k * (abs_trend - _threshold) * elapsed_ms;
+	_threshold = std::clamp(_threshold, RTC_BWE_THRESHOLD_MIN, RTC_BWE_THRESHOLD_MAX);
+
+	_last_threshold_update_us = now_us;
+}
+
+void RtcBandwidthEstimator::UpdateAckedBitrate(int64_t arrival_time_us, size_t size)
+{
+	_acked_packets.emplace_back(arrival_time_us, size);
+	_acked_bytes += size;
+
+	while((_acked_packets.empty() == false) && (_acked_packets.front().first < arrival_time_us - RTC_BWE_ACKED_BITRATE_WINDOW_US))
+	{
+		_acked_bytes -= _acked_packets.front().second;
+		_acked_packets.pop_front();
+	}
+}
+
+void RtcBandwidthEstimator::UpdateDelayBasedBitrate(int64_t now_us)
+{
+	switch(_usage)
+	{
+		case BandwidthUsage::Overusing:
+			if(now_us - _last_decrease_time_us > RTC_BWE_DECREASE_INTERVAL_US)
+			{
+				double acked_bitrate = 0.0;
+
+				if(_acked_packets.size() >= 2)
+				{
+					auto duration_us = std::max<int64_t>(_acked_packets.back().first - _acked_packets.front().first, 1);
+					acked_bitrate = (_acked_bytes * 8.0 * 1000000.0) / duration_us;
+				}
+
+				auto base_bitrate = (acked_bitrate > 0.0) ? std::min(acked_bitrate, _estimated_bitrate) : _estimated_bitrate;
+
+				_estimated_bitrate = ClampBitrate(base_bitrate * RTC_BWE_DECREASE_FACTOR);
+				_last_decrease_time_us = now_us;
+
+				logtd("Overuse is detected, estimated bitrate: %.0f (acked: %.0f)", _estimated_bitrate, acked_bitrate);
+			}
+
+			_last_increase_time_us = now_us;
+			break;
+
+		case BandwidthUsage::Underusing:
+			// The queues are draining, hold the estimate
+			_last_increase_time_us = now_us;
+			break;
+
+		case BandwidthUsage::Normal:
+			// There is no probing, so the increase is not limited by the acknowledged bitrate.
+			// Switching to a higher rendition works as the probe, and an overuse brings the estimate back to the acknowledged bitrate.
+			if(_last_increase_time_us != 0)
+			{
+				auto elapsed = std::min((now_us - _last_increase_time_us) / 1000000.0, 1.0);
+				_estimated_bitrate = ClampBitrate(_estimated_bitrate * std::pow(RTC_BWE_INCREASE_FACTOR, elapsed));
+			}
+
+			_last_increase_time_us = now_us;
+			break;
+	}
+}
+
+uint64_t RtcBandwidthEstimator::ClampBitrate(double bitrate) const
+{
+	return static_cast<uint64_t>(std::clamp(bitrate, static_cast<double>(RTC_BWE_MIN_BITRATE), static_cast<double>(RTC_BWE_MAX_BITRATE)));
+}
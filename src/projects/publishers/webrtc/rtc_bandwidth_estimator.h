@@ -0,0 +1,123 @@
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/rtp_rtcp/rtcp_info/transport_cc.h>
+
+#include <deque>
+#include <mutex>
+
+// Range of the estimated bitrate (Unit: bits per second)
+#define RTC_BWE_MIN_BITRATE					(50 * 1000)
+#define RTC_BWE_MAX_BITRATE					(50 * 1000 * 1000)
+
+// The number of the sent packets kept to match with transport-cc feedbacks (must be power of 2)
+#define RTC_BWE_SEND_HISTORY_SIZE			4096
+// The packets sent within this time are a group (Unit: microseconds)
+#define RTC_BWE_BURST_TIME_US				5000
+// The number of the delay samples to calculate the trend
+#define RTC_BWE_TRENDLINE_WINDOW_SIZE		20
+// The acknowledged bitrate is calculated over this time (Unit: microseconds)
+#define RTC_BWE_ACKED_BITRATE_WINDOW_US		(1000 * 1000)
+
+// Send-side bandwidth estimator of a session, a simplified version of Google Congestion Control
+// (draft-ietf-rmcat-gcc-02)
+//
+// - Delay-based: the packets are grouped by the send time, and the trend of the one-way delay variation
+//   between the groups is compared with an adaptive threshold (overuse/normal/underuse)
+// - Rate control: AIMD, decreases to 85% of the acknowledged bitrate on overuse, otherwise increases by 8% per second
+// - Loss-based: decreases when the receiver reports more than 10% loss
+// - REMB: caps the estimate. When the receiver doesn't send transport-cc feedbacks, the estimate follows REMB.
+class RtcBandwidthEstimator
+{
+public:
+	RtcBandwidthEstimator(uint64_t start_bitrate);
+
+	// Called when a packet with the transport-wide sequence number is sent
+	// @param send_time_us Departure time of the packet if it is paced (steady clock), 0 if the packet is sent now
+	void OnPacketSent(uint16_t transport_sequence_number, size_t size, int64_t send_time_us = 0);
+
+	void OnTransportFeedback(const TransportCc &feedback);
+	// Unit: bits per second
+	void OnRemb(uint64_t bitrate);
+	// fraction_lost: fraction lost field of the report block (lost / 256)
+	void OnReceiverReport(uint8_t fraction_lost);
+
+	// Unit: bits per second
+	uint64_t GetEstimatedBitrate();
+
+private:
+	enum class BandwidthUsage : uint8_t
+	{
+		Normal,
+		Underusing,
+		Overusing
+	};
+
+	struct SentPacket
+	{
+		uint16_t sequence_number = 0;
+		size_t size = 0;
+		// Unit: microseconds (steady clock), 0 if the slot is empty
+		int64_t send_time_us = 0;
+	};
+
+	struct PacketGroup
+	{
+		int64_t first_send_time_us = 0;
+		int64_t last_send_time_us = 0;
+		int64_t last_arrival_time_us = 0;
+	};
+
+	struct DelaySample
+	{
+		// Unit: milliseconds
+		double arrival_time_ms;
+		double smoothed_delay_ms;
+	};
+
+	static int64_t GetNowUs();
+
+	// Processes a group which is completed, and updates the bandwidth usage
+	void OnPacketGroup(const PacketGroup &group);
+	void UpdateTrend(double delay_variation_ms, int64_t arrival_time_us);
+	void UpdateThreshold(double trend, int64_t now_us);
+	void UpdateAckedBitrate(int64_t arrival_time_us, size_t size);
+	void UpdateDelayBasedBitrate(int64_t now_us);
+
+	uint64_t ClampBitrate(double bitrate) const;
+
+	std::mutex _mutex;
+
+	SentPacket _send_history[RTC_BWE_SEND_HISTORY_SIZE];
+
+	// Delay-based
+	bool _has_feedback = false;
+	bool _has_group = false;
+	PacketGroup _current_group;
+	PacketGroup _previous_group;
+	bool _has_previous_group = false;
+
+	double _accumulated_delay_ms = 0.0;
+	double _smoothed_delay_ms = 0.0;
+	int64_t _first_arrival_time_us = -1;
+	std::deque<DelaySample> _delay_samples;
+	size_t _num_delay_samples = 0;
+
+	double _threshold = 12.5;
+	int64_t _last_threshold_update_us = 0;
+	double _previous_trend = 0.0;
+	int _overuse_count = 0;
+	BandwidthUsage _usage = BandwidthUsage::Normal;
+
+	// (arrival time, size) of the acknowledged packets
+	std::deque<std::pair<int64_t, size_t>> _acked_packets;
+	size_t _acked_bytes = 0;
+
+	int64_t _last_increase_time_us = 0;
+	int64_t _last_decrease_time_us = 0;
+	int64_t _last_loss_decrease_time_us = 0;
+
+	// Unit: bits per second
+	double _estimated_bitrate = 0.0;
+	uint64_t _remb_bitrate = 0;
+};
@@ -0,0 +1,404 @@
+#include "rtc_pacer.h"
+#include "rtc_private.h"
+
+#include <base/ovsocket/datagram_batch.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if !IS_MACOS
+#	include <linux/net_tstamp.h>
+#endif	// !IS_MACOS
+
+static void UpdateMax(std::atomic<int64_t> &target, int64_t value)
+{
+	auto current = target.load();
+
+	while ((value > current) && (target.compare_exchange_weak(current, value) == false))
+	{
+	}
+}
+
+RtcPacer::RtcPacer(size_t scheduler_hint, int max_delay_ms, bool use_txtime, SendFunction send_function)
+	: _max_delay_us(std::clamp(max_delay_ms, 1, RTC_PACER_WHEEL_SIZE - 1) * 1000LL),
+	  _use_txtime(use_txtime && IsTxTimeSupported()),
+	  _send_function(std::move(send_function)),
+	  _scheduler(RtcPacerSchedulerPool::GetInstance()->GetScheduler(scheduler_hint))
+{
+	if (use_txtime && (_use_txtime == false))
+	{
+		logtw("SO_TXTIME is not supported by the kernel, the packets are paced by the timer");
+	}
+}
+
+int64_t RtcPacer::GetNowUs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool RtcPacer::IsTxTimeSupported()
+{
+	static bool is_supported = false;
+	static std::once_flag check_flag;
+
+	std::call_once(check_flag, []() {
+#if !IS_MACOS && defined(SO_TXTIME)
+		int sock = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+		if (sock >= 0)
+		{
+			sock_txtime txtime{};
+			txtime.clockid = CLOCK_MONOTONIC;
+			txtime.flags = 0;
+
+			is_supported = (::setsockopt(sock, SOL_SOCKET, SO_TXTIME, &txtime, sizeof(txtime)) == 0);
+
+			::close(sock);
+		}
+#endif	// !IS_MACOS && defined(SO_TXTIME)
+	});
+
+	return is_supported;
+}
+
+int64_t RtcPacer::GetDepartureTime(int64_t now_us, size_t size)
+{
+	// Bitrate of the session
+	if (_window_start_time_us == 0)
+	{
+		_window_start_time_us = now_us;
+	}
+
+	_window_bytes += size;
+
+	if (now_us - _window_start_time_us >= RTC_PACER_BITRATE_WINDOW_US)
+	{
+		_measured_bitrate = (_window_bytes * 8.0 * 1000000.0) / (now_us - _window_start_time_us);
+		_window_start_time_us = now_us;
+		_window_bytes = 0;
+	}
+
+	// Bytes which have not departed yet
+	while ((_pending_packets.empty() == false) && (_pending_packets.front().first <= now_us))
+	{
+		_pending_bytes -= _pending_packets.front().second;
+		_pending_packets.pop_front();
+	}
+
+	// The queued bytes and this packet must depart within the max delay
+	auto pacing_rate = std::max({_measured_bitrate * RTC_PACER_PACING_FACTOR,
+								 static_cast<double>(RTC_PACER_MIN_PACING_RATE),
+								 ((_pending_bytes + size) * 8.0 * 1000000.0) / _max_delay_us});
+
+	auto departure_time_us = std::min(std::max(now_us, _next_departure_time_us), now_us + _max_delay_us);
+
+	_next_departure_time_us = departure_time_us + static_cast<int64_t>((size * 8.0 * 1000000.0) / pacing_rate);
+
+	if (departure_time_us > now_us)
+	{
+		_pending_packets.emplace_back(departure_time_us, size);
+		_pending_bytes += size;
+	}
+
+	return departure_time_us;
+}
+
+bool RtcPacer::Send(const std::shared_ptr<RtpPacket> &packet, int64_t *departure_time_us)
+{
+	auto size = packet->GetData()->GetLength();
+	auto now_us = GetNowUs();
+	int64_t departure = 0;
+	bool need_to_schedule = false;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_is_stopped)
+		{
+			return false;
+		}
+
+		departure = GetDepartureTime(now_us, size);
+
+		if (_use_txtime == false)
+		{
+			_queue.push_back({departure, packet});
+
+			if (_is_scheduled == false)
+			{
+				_is_scheduled = true;
+				need_to_schedule = true;
+			}
+		}
+	}
+
+	auto delay = departure - now_us;
+	_scheduler->RecordDelay(delay, delay >= _max_delay_us);
+
+	if (departure_time_us != nullptr)
+	{
+		*departure_time_us = departure;
+	}
+
+	if (_use_txtime)
+	{
+		// The fq qdisc holds the datagram until the departure time.
+		// If the socket doesn't have SO_TXTIME (e.g. TURN/TCP), the packet is sent immediately.
+		ov::DatagramBatch::SetTxTime(departure * 1000);
+		auto result = _send_function(packet);
+		ov::DatagramBatch::SetTxTime(0);
+
+		return result;
+	}
+
+	if (need_to_schedule)
+	{
+		_scheduler->Schedule(GetSharedPtr(), departure);
+	}
+
+	// The packet is sent later, so the failure of the packets sent by Process() since the last call is returned
+	return (_is_send_failed.exchange(false) == false);
+}
+
+void RtcPacer::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_is_stopped = true;
+		_queue.clear();
+	}
+
+	// Wait until the scheduler finishes sending the packets of this pacer
+	std::lock_guard<std::mutex> process_lock(_process_mutex);
+}
+
+void RtcPacer::Process()
+{
+	std::lock_guard<std::mutex> process_lock(_process_mutex);
+	int64_t next_time_us = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (_is_stopped)
+		{
+			_is_scheduled = false;
+			return;
+		}
+
+		// The packets due within half of the tick are sent in this tick
+		auto now_us = GetNowUs() + 500;
+
+		while ((_queue.empty() == false) && (_queue.front().departure_time_us <= now_us))
+		{
+			_due_packets.push_back(std::move(_queue.front().packet));
+			_queue.pop_front();
+		}
+
+		_is_scheduled = (_queue.empty() == false);
+
+		if (_is_scheduled)
+		{
+			next_time_us = _queue.front().departure_time_us;
+		}
+	}
+
+	for (const auto &packet : _due_packets)
+	{
+		if (_send_function(packet) == false)
+		{
+			_is_send_failed = true;
+		}
+	}
+
+	_due_packets.clear();
+
+	if (next_time_us != 0)
+	{
+		_scheduler->Schedule(GetSharedPtr(), next_time_us);
+	}
+}
+
+RtcPacerScheduler::RtcPacerScheduler(size_t index)
+	: _index(index)
+{
+}
+
+RtcPacerScheduler::~RtcPacerScheduler()
+{
+	_stop = true;
+	_condition.notify_all();
+
+	if (_thread.joinable())
+	{
+		_thread.join();
+	}
+}
+
+void RtcPacerScheduler::Start()
+{
+	_stats_timer.Start();
+
+	_thread = std::thread(&RtcPacerScheduler::ThreadProc, this);
+	pthread_setname_np(_thread.native_handle(), ov::String::FormatString("RtcPacer%zu", _index).CStr());
+}
+
+void RtcPacerScheduler::Schedule(const std::shared_ptr<RtcPacer> &pacer, int64_t time_us)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto now_ms = RtcPacer::GetNowUs() / 1000;
+
+	if (_scheduled_count == 0)
+	{
+		// The cursor stopped while the wheel was empty
+		_cursor_ms = std::max(_cursor_ms, now_ms);
+	}
+
+	auto time_ms = std::clamp<int64_t>(time_us / 1000, _cursor_ms, _cursor_ms + RTC_PACER_WHEEL_SIZE - 1);
+
+	_slots[time_ms % RTC_PACER_WHEEL_SIZE].push_back(pacer);
+	_scheduled_count++;
+
+	if (_scheduled_count == 1)
+	{
+		_condition.notify_one();
+	}
+}
+
+void RtcPacerScheduler::RecordDelay(int64_t delay_us, bool is_limited)
+{
+	_packet_count++;
+
+	if (delay_us > 0)
+	{
+		_delayed_count++;
+		_total_delay += delay_us;
+		UpdateMax(_max_delay, delay_us);
+	}
+
+	if (is_limited)
+	{
+		_limited_count++;
+	}
+}
+
+void RtcPacerScheduler::ThreadProc()
+{
+	std::vector<std::weak_ptr<RtcPacer>> due_pacers;
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (_stop == false)
+	{
+		if (_scheduled_count == 0)
+		{
+			_condition.wait_for(lock, std::chrono::milliseconds(RTC_PACER_STATS_INTERVAL));
+
+			lock.unlock();
+			LogStatsIfNeeded();
+			lock.lock();
+
+			continue;
+		}
+
+		auto now_ms = RtcPacer::GetNowUs() / 1000;
+
+		if (_cursor_ms > now_ms)
+		{
+			// Wait for the next tick
+			auto wait_time_us = (_cursor_ms * 1000) - RtcPacer::GetNowUs();
+
+			lock.unlock();
+			std::this_thread::sleep_for(std::chrono::microseconds(wait_time_us));
+			lock.lock();
+
+			continue;
+		}
+
+		while (_cursor_ms <= now_ms)
+		{
+			auto &slot = _slots[_cursor_ms % RTC_PACER_WHEEL_SIZE];
+
+			_scheduled_count -= slot.size();
+			due_pacers.insert(due_pacers.end(), std::make_move_iterator(slot.begin()), std::make_move_iterator(slot.end()));
+			slot.clear();
+
+			_cursor_ms++;
+		}
+
+		lock.unlock();
+
+		// The packets of a tick are sent with as few system calls as possible
+		ov::DatagramBatch::Begin();
+
+		for (auto &weak_pacer : due_pacers)
+		{
+			auto pacer = weak_pacer.lock();
+
+			if (pacer != nullptr)
+			{
+				pacer->Process();
+			}
+		}
+
+		ov::DatagramBatch::Flush();
+
+		due_pacers.clear();
+
+		LogStatsIfNeeded();
+
+		lock.lock();
+	}
+}
+
+void RtcPacerScheduler::LogStatsIfNeeded()
+{
+	if (_stats_timer.IsElapsed(RTC_PACER_STATS_INTERVAL) == false)
+	{
+		return;
+	}
+
+	_stats_timer.Update();
+
+	uint64_t packet_count = _packet_count.exchange(0);
+	uint64_t delayed_count = _delayed_count.exchange(0);
+	uint64_t limited_count = _limited_count.exchange(0);
+	int64_t total_delay = _total_delay.exchange(0);
+	int64_t max_delay = _max_delay.exchange(0);
+
+	if (packet_count == 0)
+	{
+		return;
+	}
+
+	auto message = ov::String::FormatString(
+		"packets: %" PRIu64 ", delayed: %" PRIu64 ", delay: %" PRId64 "us (max: %" PRId64 "us), limited by the max delay: %" PRIu64,
+		packet_count, delayed_count, (delayed_count > 0) ? (total_delay / static_cast<int64_t>(delayed_count)) : 0, max_delay, limited_count);
+
+	logti("Pacer #%zu statistics: %s", _index, message.CStr());
+}
+
+void RtcPacerSchedulerPool::StartIfNeeded()
+{
+	std::call_once(_start_flag, [this]() {
+		size_t scheduler_count = std::max(std::thread::hardware_concurrency(), 1U);
+
+		for (size_t index = 0; index < scheduler_count; index++)
+		{
+			auto scheduler = std::make_shared<RtcPacerScheduler>(index);
+			scheduler->Start();
+
+			_schedulers.push_back(std::move(scheduler));
+		}
+
+		logtd("%zu pacer schedulers are started", scheduler_count);
+	});
+}
+
+std::shared_ptr<RtcPacerScheduler> RtcPacerSchedulerPool::GetScheduler(size_t hint)
+{
+	StartIfNeeded();
+
+	return _schedulers[hint % _schedulers.size()];
+}
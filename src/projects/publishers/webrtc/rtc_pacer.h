@@ -0,0 +1,166 @@
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+#include <modules/rtp_rtcp/rtp_packet.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pacing rate = (bitrate of the session over the last window) * factor
+#define RTC_PACER_PACING_FACTOR				2.5
+// Lower bound of the pacing rate (Unit: bits per second)
+#define RTC_PACER_MIN_PACING_RATE			(500 * 1000)
+// The bitrate of the session is measured over this time (Unit: microseconds)
+#define RTC_PACER_BITRATE_WINDOW_US			(1000 * 1000)
+// The number of the slots of the timer wheel, a slot is 1 millisecond (must be greater than the max delay)
+#define RTC_PACER_WHEEL_SIZE				256
+// Interval of logging the statistics of the pacers (in milliseconds)
+#define RTC_PACER_STATS_INTERVAL			(60 * 1000)
+
+class RtcPacerScheduler;
+
+// Spreads the video packets of a session (e.g. the burst of a key frame) over time.
+//
+// The departure time of each packet is decided when it is sent:
+//   departure = max(now, previous departure + transmission time at the pacing rate), but at most now + max delay
+// The pacing rate is raised when the queued bytes can't be sent within the max delay, so the limit is rarely hit.
+//
+// - TxTime: the packet is handed to the socket immediately with the departure time (SCM_TXTIME),
+//   and the fq qdisc of the kernel holds it until then
+// - Otherwise: the packet is queued to the pacer, and RtcPacerScheduler sends it at the departure time.
+//   The schedulers are sharded per core, so the packets (SRTP + send) of the sessions are sent by multiple threads.
+class RtcPacer : public ov::EnableSharedFromThis<RtcPacer>
+{
+public:
+	using SendFunction = std::function<bool(const std::shared_ptr<RtpPacket> &packet)>;
+
+	// @param scheduler_hint The pacers of the same hint are run by the same scheduler (e.g. the id of the session)
+	// @param max_delay_ms The limit of the delay added by the pacer
+	// @param use_txtime Uses SO_TXTIME if the kernel supports it
+	RtcPacer(size_t scheduler_hint, int max_delay_ms, bool use_txtime, SendFunction send_function);
+	~RtcPacer() override = default;
+
+	// Whether the packets are held by the pacer. If true, the packet passed to Send() must not be reused by the caller.
+	bool IsHoldingPackets() const
+	{
+		return _use_txtime == false;
+	}
+
+	// @param departure_time_us Departure time of the packet (steady clock, microseconds), it can be nullptr
+	//
+	// @return false if the pacer is stopped or the packet couldn't be sent.
+	//         If the packets are held by the pacer, they are sent later, so false means that
+	//         a packet held since the last call couldn't be sent.
+	bool Send(const std::shared_ptr<RtpPacket> &packet, int64_t *departure_time_us);
+
+	// Drops the queued packets, the pacer doesn't send anything after Stop() returns
+	void Stop();
+
+	//--------------------------------------------------------------------
+	// Called by RtcPacerScheduler
+	//--------------------------------------------------------------------
+	// Sends the packets of which the departure time has come
+	void Process();
+
+	static int64_t GetNowUs();
+
+private:
+	struct QueuedPacket
+	{
+		int64_t departure_time_us;
+		std::shared_ptr<RtpPacket> packet;
+	};
+
+	// Checks once whether the kernel supports SO_TXTIME
+	static bool IsTxTimeSupported();
+
+	// _mutex must be held
+	int64_t GetDepartureTime(int64_t now_us, size_t size);
+
+	int64_t _max_delay_us;
+	bool _use_txtime;
+	SendFunction _send_function;
+	std::shared_ptr<RtcPacerScheduler> _scheduler;
+
+	std::mutex _mutex;
+	bool _is_stopped = false;
+
+	// Used only if the packets are held by the pacer
+	std::deque<QueuedPacket> _queue;
+	bool _is_scheduled = false;
+	// Held while the packets are sent by Process()
+	std::mutex _process_mutex;
+	std::vector<std::shared_ptr<RtpPacket>> _due_packets;
+	// A packet sent by Process() failed, it is returned by the next Send()
+	std::atomic<bool> _is_send_failed{false};
+
+	// (departure time, size) of the packets which have not departed yet
+	std::deque<std::pair<int64_t, size_t>> _pending_packets;
+	size_t _pending_bytes = 0;
+	int64_t _next_departure_time_us = 0;
+
+	// Bitrate of the session
+	int64_t _window_start_time_us = 0;
+	size_t _window_bytes = 0;
+	double _measured_bitrate = 0.0;
+};
+
+// A thread which runs the timer wheel of the pacers
+class RtcPacerScheduler
+{
+public:
+	explicit RtcPacerScheduler(size_t index);
+	~RtcPacerScheduler();
+
+	void Start();
+
+	// Calls pacer->Process() at the time (steady clock, microseconds)
+	void Schedule(const std::shared_ptr<RtcPacer> &pacer, int64_t time_us);
+
+	// Records the delay added by a pacer (Unit: microseconds)
+	void RecordDelay(int64_t delay_us, bool is_limited);
+
+protected:
+	void ThreadProc();
+	void LogStatsIfNeeded();
+
+	size_t _index;
+	std::atomic<bool> _stop{false};
+	std::thread _thread;
+
+	std::mutex _mutex;
+	std::condition_variable _condition;
+
+	// A slot holds the pacers to run at (time in milliseconds % RTC_PACER_WHEEL_SIZE)
+	std::vector<std::weak_ptr<RtcPacer>> _slots[RTC_PACER_WHEEL_SIZE];
+	size_t _scheduled_count = 0;
+	// The next time to run (Unit: milliseconds)
+	int64_t _cursor_ms = 0;
+
+	// Statistics
+	std::atomic<uint64_t> _packet_count{0};
+	std::atomic<uint64_t> _delayed_count{0};
+	std::atomic<uint64_t> _limited_count{0};
+	std::atomic<int64_t> _total_delay{0};
+	std::atomic<int64_t> _max_delay{0};
+	ov::StopWatch _stats_timer;
+};
+
+// The schedulers of the pacers, one per core
+class RtcPacerSchedulerPool : public ov::Singleton<RtcPacerSchedulerPool>
+{
+public:
+	// @param hint The same scheduler is returned for the same hint
+	std::shared_ptr<RtcPacerScheduler> GetScheduler(size_t hint);
+
+protected:
+	void StartIfNeeded();
+
+	std::once_flag _start_flag;
+	std::vector<std::shared_ptr<RtcPacerScheduler>> _schedulers;
+};
@@ -6,9 +6,18 @@
 #include "rtc_stream.h"
 
 #include "modules/rtp_rtcp/rtcp_info/nack.h"
+#include "modules/rtp_rtcp/rtcp_info/receiver_report.h"
+#include "modules/rtp_rtcp/rtcp_info/remb.h"
+#include "modules/rtp_rtcp/rtcp_info/transport_cc.h"
+#include "modules/rtp_rtcp/red_rtp_packet.h"
 
+#include <base/ovlibrary/byte_io.h>
+#include <algorithm>
 #include <utility>
 
+// Offset of SN base in the payload of RED/ULPFEC packet (RED header + E/L/P/X/CC/M/PT recovery)
+#define RTC_ULPFEC_SN_BASE_OFFSET		(RED_HEADER_SIZE + 2)
+
 std::shared_ptr<RtcSession> RtcSession::Create(const std::shared_ptr<WebRtcPublisher> &publisher,
 											   const std::shared_ptr<pub::Application> &application,
                                                const std::shared_ptr<pub::Stream> &stream,
@@ -131,6 +140,8 @@ bool RtcSession::Start()
 
 			_video_ssrc = offer_media_desc->GetSsrc();
 			_rtp_rtcp->AddRtcpSRGenerator(_video_payload_type, _video_ssrc);
+
+			InitializeRenditions(peer_media_desc, first_payload->GetId());
 		}
 	}
 
@@ -148,6 +159,16 @@ bool RtcSession::Start()
 	_dtls_ice_transport->RegisterLowerNode(nullptr);
 	_dtls_ice_transport->Start();
 
+	auto &webrtc_config = std::static_pointer_cast<info::Application>(GetApplication())->GetConfig().GetPublishers().GetWebrtcPublisher();
+	if(webrtc_config.IsPacingEnabled())
+	{
+		// The pacer is stopped before the session is released, so it doesn't use the session after that
+		_pacer = std::make_shared<RtcPacer>(GetId(), webrtc_config.GetPacingMaxDelay(), webrtc_config.IsPacingTxTimeEnabled(),
+											[this](const std::shared_ptr<RtpPacket> &packet) -> bool {
+												return _rtp_rtcp->SendOutgoingData(packet);
+											});
+	}
+
 	return Session::Start();
 }
 
@@ -158,6 +179,11 @@ bool RtcSession::Stop()
 
 	logtd("Stop session. Peer sdp session id : %u", GetOfferSDP()->GetSessionId());
 
+	if(_pacer != nullptr)
+	{
+		_pacer->Stop();
+	}
+
 	if(GetState() != SessionState::Started && GetState() != SessionState::Stopping)
 	{
 		return true;
@@ -255,38 +281,167 @@ bool RtcSession::SendOutgoingData(const std::any &packet)
     }
 
 	// Check if this session wants the packet
-	uint32_t rtp_payload_type = session_packet->PayloadType();
-	uint32_t red_block_pt = 0;
-	uint32_t origin_pt_of_fec = 0;
+	uint8_t rtp_payload_type = session_packet->PayloadType();
+
+	if(rtp_payload_type == _audio_payload_type)
+	{
+		// The packet is shared by all sessions of the stream. SRTP doesn't alter it, but encrypts it into the buffer of this session.
+		_sent_media_bytes += session_packet->GetData()->GetLength();
+		return _rtp_rtcp->SendOutgoingData(session_packet);
+	}
+
+	// Payload type of the video track that the packet belongs to
+	uint8_t media_payload_type = rtp_payload_type;
 
 	if(rtp_payload_type == static_cast<uint8_t>(FixedRtcPayloadType::RED_PAYLOAD_TYPE))
 	{
-		red_block_pt = std::dynamic_pointer_cast<RedRtpPacket>(session_packet)->BlockPT();
+		if(_red_block_pt == 0)
+		{
+			return false;
+		}
 
 		// RED includes FEC packet or Media packet.
-		if(session_packet->IsUlpfec())
+		// When the block is ULPFEC_PAYLOAD_TYPE, OriginPayloadType() is origin media payload type.
+		media_payload_type = session_packet->IsUlpfec() ? session_packet->OriginPayloadType() : std::dynamic_pointer_cast<RedRtpPacket>(session_packet)->BlockPT();
+	}
+	else if(_red_block_pt != 0)
+	{
+		return false;
+	}
+
+	return SendVideoPacket(session_packet, media_payload_type);
+}
+
+bool RtcSession::SendVideoPacket(const std::shared_ptr<RtpPacket> &packet, uint8_t media_payload_type)
+{
+	bool is_red = (_red_block_pt != 0);
+	uint8_t current_payload_type = is_red ? _red_block_pt : _video_payload_type;
+	bool is_new_segment = (_video_sent == false);
+
+	// The rendition is switched at the first packet of a key frame, so the player can decode the new rendition from there
+	auto pending_index = _pending_rendition_index.load();
+	if((pending_index >= 0) && (media_payload_type != current_payload_type) &&
+	   (media_payload_type == _renditions[pending_index].payload_type) && packet->IsKeyFrameStart())
+	{
+		// The sequence numbers continue from the last packet of the previous rendition
+		uint16_t first_sequence_number = _video_sent ? static_cast<uint16_t>(_last_video_sequence_number + 1) : packet->SequenceNumber();
+		_video_sequence_number_offset = first_sequence_number - packet->SequenceNumber();
+
+		if(is_red)
+		{
+			_red_block_pt = media_payload_type;
+		}
+		else
 		{
-			origin_pt_of_fec = session_packet->OriginPayloadType();
+			_video_payload_type = media_payload_type;
 		}
+
+		logti("Session(%u) switched the rendition : pt(%d -> %d) bitrate(%" PRIu64 " -> %" PRIu64 ")",
+			  GetId(), current_payload_type, media_payload_type,
+			  _renditions[_rendition_index].bitrate, _renditions[pending_index].bitrate);
+
+		current_payload_type = media_payload_type;
+		_rendition_index = pending_index;
+		_pending_rendition_index.compare_exchange_strong(pending_index, -1);
+
+		is_new_segment = true;
 	}
 
-	if(rtp_payload_type != _video_payload_type && rtp_payload_type != _audio_payload_type)
+	if(media_payload_type != current_payload_type)
 	{
 		return false;
 	}
 
-	if(rtp_payload_type == static_cast<uint8_t>(FixedRtcPayloadType::RED_PAYLOAD_TYPE))
+	if(is_new_segment)
+	{
+		_video_first_original_sequence_number = packet->SequenceNumber();
+
+		RtpSegment segment;
+		segment.payload_type = current_payload_type;
+		segment.first_sequence_number = packet->SequenceNumber() + _video_sequence_number_offset;
+		segment.first_original_sequence_number = packet->SequenceNumber();
+
+		std::lock_guard<std::mutex> lock(_rtp_segments_lock);
+		_rtp_segments.push_back(segment);
+		if(_rtp_segments.size() > RTC_MAX_RTP_SEGMENTS)
+		{
+			_rtp_segments.pop_front();
+		}
+	}
+
+	bool is_fec = is_red && packet->IsUlpfec();
+
+	if(is_fec && (_video_sequence_number_offset != 0))
 	{
-		// When red_block_pt is ULPFEC_PAYLOAD_TYPE, origin_pt_of_fec is origin media payload type.
-		if(red_block_pt != _red_block_pt && origin_pt_of_fec != _red_block_pt)
+		// The FEC packet which protects the packets before the switch is useless (the player didn't receive them)
+		auto sn_base = ByteReader<uint16_t>::ReadBigEndian(packet->Payload() + RTC_ULPFEC_SN_BASE_OFFSET);
+		if(static_cast<uint16_t>(sn_base - _video_first_original_sequence_number) >= 0x8000)
 		{
 			return false;
 		}
 	}
 
-	// RTP Session must be copied and sent because data is altered due to SRTP.
-	auto copy_packet = std::make_shared<RtpPacket>(*session_packet);
-	return _rtp_rtcp->SendOutgoingData(copy_packet);
+	uint16_t sequence_number = packet->SequenceNumber() + _video_sequence_number_offset;
+
+	_video_sent = true;
+	_last_video_sequence_number = sequence_number;
+
+	if((_video_sequence_number_offset == 0) && (_transport_cc_extension_id == 0))
+	{
+		// The packet is shared by all sessions of the stream. SRTP doesn't alter it, but encrypts it into the buffer of this session.
+		return SendPacedPacket(packet, false, nullptr);
+	}
+
+	// The packet is copied to rewrite the sequence number or to add the transport-wide sequence number
+	bool has_transport_sequence_number = (_transport_cc_extension_id != 0) && _send_packet->Package(*packet, _transport_cc_extension_id, _transport_sequence_number);
+	if(has_transport_sequence_number == false)
+	{
+		if(_send_packet->Package(*packet, 0, 0) == false)
+		{
+			return false;
+		}
+	}
+
+	_send_packet->SetSequenceNumber(sequence_number);
+
+	if(is_fec)
+	{
+		ByteWriter<uint16_t>::WriteBigEndian(_send_packet->Payload() + RTC_ULPFEC_SN_BASE_OFFSET,
+											 ByteReader<uint16_t>::ReadBigEndian(packet->Payload() + RTC_ULPFEC_SN_BASE_OFFSET) + _video_sequence_number_offset);
+	}
+
+	int64_t departure_time_us = 0;
+	auto result = SendPacedPacket(_send_packet, true, &departure_time_us);
+
+	if(has_transport_sequence_number)
+	{
+		_bandwidth_estimator->OnPacketSent(_transport_sequence_number++, _send_packet->GetData()->GetLength(), departure_time_us);
+	}
+
+	return result;
+}
+
+bool RtcSession::SendPacedPacket(const std::shared_ptr<RtpPacket> &packet, bool is_reused, int64_t *departure_time_us)
+{
+	_sent_media_bytes += packet->GetData()->GetLength();
+
+	if(_pacer == nullptr)
+	{
+		return _rtp_rtcp->SendOutgoingData(packet);
+	}
+
+	if(is_reused && _pacer->IsHoldingPackets())
+	{
+		return _pacer->Send(std::make_shared<RtpPacket>(*packet), departure_time_us);
+	}
+
+	return _pacer->Send(packet, departure_time_us);
+}
+
+bool RtcSession::IsReadyToSend()
+{
+	// RTP packets are dropped until DTLS handshake is completed and SRTP keys are set
+	return Session::IsReadyToSend() && (_srtp_transport != nullptr) && _srtp_transport->IsSendReady();
 }
 
 void RtcSession::OnRtpFrameReceived(const std::vector<std::shared_ptr<RtpPacket>> &rtp_packets)
@@ -303,7 +458,7 @@ void RtcSession::OnRtcpReceived(const std::shared_ptr<RtcpInfo> &rtcp_info)
 
 	if(rtcp_info->GetPacketType() == RtcpPacketType::RR)
 	{
-		// Process
+		ProcessReceiverReport(rtcp_info);
 	}
 	else if(rtcp_info->GetPacketType() == RtcpPacketType::RTPFB)
 	{
@@ -312,6 +467,25 @@ void RtcSession::OnRtcpReceived(const std::shared_ptr<RtcpInfo> &rtcp_info)
 			// Process
 			ProcessNACK(rtcp_info);
 		}
+		else if(rtcp_info->GetCountOrFmt() == static_cast<uint8_t>(RTPFBFMT::TRANSPORT_CC))
+		{
+			if(_bandwidth_estimator != nullptr)
+			{
+				_bandwidth_estimator->OnTransportFeedback(*std::static_pointer_cast<TransportCc>(rtcp_info));
+				UpdateRendition();
+			}
+		}
+	}
+	else if(rtcp_info->GetPacketType() == RtcpPacketType::PSFB)
+	{
+		if(rtcp_info->GetCountOrFmt() == static_cast<uint8_t>(PSFBFMT::AFB))
+		{
+			if(_bandwidth_estimator != nullptr)
+			{
+				_bandwidth_estimator->OnRemb(std::static_pointer_cast<Remb>(rtcp_info)->GetBitrate());
+				UpdateRendition();
+			}
+		}
 	}
 
 	rtcp_info->DebugPrint();
@@ -337,19 +511,287 @@ bool RtcSession::ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info)
 		return false;
 	}
 
-	// Retransmission
+	std::lock_guard<std::mutex> rtx_lock(_rtx_lock);
+	std::lock_guard<std::mutex> segments_lock(_rtp_segments_lock);
+
+	RefillRtxTokens();
+
+	// Retransmission: all lost packets of the NACK are sent while the token bucket allows
 	for(size_t i=0; i<nack->GetLostIdCount(); i++)
 	{
 		auto seq_no = nack->GetLostId(i);
-		auto packet = stream->GetRtxRtpPacket(_video_payload_type, seq_no);
-		if(packet != nullptr)
+
+		// The sequence numbers of the session are different from the stream after the rendition is switched
+		auto segment = FindRtpSegment(seq_no);
+		if(segment == nullptr)
+		{
+			continue;
+		}
+
+		uint16_t original_seq_no = seq_no - segment->first_sequence_number + segment->first_original_sequence_number;
+		bool is_rewritten = (original_seq_no != seq_no);
+
+		auto history = stream->GetHistory(_red_block_pt != 0 ? static_cast<uint8_t>(FixedRtcPayloadType::RED_PAYLOAD_TYPE) : segment->payload_type);
+		if(history == nullptr)
+		{
+			continue;
+		}
+
+		auto packet = history->GetRtpPacket(original_seq_no);
+		if(packet == nullptr)
+		{
+			continue;
+		}
+
+		if(_red_block_pt != 0)
+		{
+			// The RED packets of all renditions are kept in a history
+			if(packet->IsUlpfec())
+			{
+				// FEC packets are not retransmitted after the switch, the SN base would have to be rewritten
+				if(is_rewritten || (packet->OriginPayloadType() != segment->payload_type))
+				{
+					continue;
+				}
+			}
+			else if(std::static_pointer_cast<RedRtpPacket>(packet)->BlockPT() != segment->payload_type)
+			{
+				continue;
+			}
+		}
+
+		auto rtx_packet_size = static_cast<int64_t>(packet->HeadersSize() + RTX_HEADER_SIZE + packet->PayloadSize());
+		if(rtx_packet_size > _rtx_tokens)
+		{
+			// The player will request the remaining packets again if they are still needed
+			logd("RTCP", "RTX bitrate limit is exceeded, %zu packets are not retransmitted", nack->GetLostIdCount() - i);
+			break;
+		}
+
+		if(_rtx_packet->PackageAsRtx(history->GetRtxSsrc(), history->GetRtxPayloadType(), *packet) == false)
+		{
+			continue;
+		}
+
+		if(is_rewritten)
 		{
-			logd("RTCP", "Send RTX packet : %u/%u", _video_payload_type, seq_no);
-			auto copy_packet = std::make_shared<RtpPacket>(*(std::dynamic_pointer_cast<RtpPacket>(packet)));
-			copy_packet->SetSequenceNumber(_rtx_sequence_number++);
-			return _rtp_rtcp->SendOutgoingData(copy_packet);
+			_rtx_packet->SetOriginalSequenceNumber(seq_no);
+		}
+
+		_rtx_tokens -= rtx_packet_size;
+
+		logd("RTCP", "Send RTX packet : %u/%u", segment->payload_type, seq_no);
+		_rtx_packet->SetSequenceNumber(_rtx_sequence_number++);
+		if(_rtp_rtcp->SendOutgoingData(_rtx_packet) == false)
+		{
+			return false;
 		}
 	}
 
 	return true;
+}
+
+const RtcSession::RtpSegment *RtcSession::FindRtpSegment(uint16_t sequence_number) const
+{
+	// The latest segment which starts at or before the sequence number
+	for(auto segment = _rtp_segments.rbegin(); segment != _rtp_segments.rend(); ++segment)
+	{
+		if(static_cast<uint16_t>(sequence_number - segment->first_sequence_number) < 0x8000)
+		{
+			return &(*segment);
+		}
+	}
+
+	return nullptr;
+}
+
+void RtcSession::ProcessReceiverReport(const std::shared_ptr<RtcpInfo> &rtcp_info)
+{
+	if(_bandwidth_estimator == nullptr)
+	{
+		return;
+	}
+
+	auto receiver_report = std::dynamic_pointer_cast<ReceiverReport>(rtcp_info);
+	if(receiver_report == nullptr)
+	{
+		return;
+	}
+
+	for(size_t i=0; i<receiver_report->GetReportBlockCount(); i++)
+	{
+		auto report_block = receiver_report->GetReportBlock(i);
+		if(report_block != nullptr && report_block->GetSrcSsrc() == _video_ssrc)
+		{
+			_bandwidth_estimator->OnReceiverReport(report_block->GetFractionLost());
+			UpdateRendition();
+		}
+	}
+}
+
+void RtcSession::InitializeRenditions(const std::shared_ptr<const MediaDescription> &peer_media_desc, uint8_t payload_type)
+{
+	auto stream = std::dynamic_pointer_cast<RtcStream>(GetStream());
+	auto payload = peer_media_desc->GetPayload(payload_type);
+	if(stream == nullptr || payload == nullptr)
+	{
+		return;
+	}
+
+	// The feedbacks are offered only when the bandwidth estimation is enabled
+	bool transport_cc = payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::TransportCc);
+	bool remb = payload->IsRtcpFbEnabled(PayloadAttr::RtcpFbType::GoogRemb);
+	if(transport_cc == false && remb == false)
+	{
+		return;
+	}
+
+	// The video tracks of the stream are sent with the same SSRC in an m= line, so the session can switch between the tracks of the same codec
+	for(const auto &peer_payload : peer_media_desc->GetPayloadList())
+	{
+		if(peer_payload->GetCodec() != payload->GetCodec())
+		{
+			continue;
+		}
+
+		auto track = stream->GetTrackByPayloadType(peer_payload->GetId());
+		if(track == nullptr || track->GetBitrate() <= 0)
+		{
+			continue;
+		}
+
+		Rendition rendition;
+		rendition.payload_type = peer_payload->GetId();
+		rendition.bitrate = static_cast<uint64_t>(track->GetBitrate());
+		_renditions.push_back(rendition);
+	}
+
+	std::sort(_renditions.begin(), _renditions.end(), [](const Rendition &a, const Rendition &b) {
+		return a.bitrate < b.bitrate;
+	});
+
+	auto current = std::find_if(_renditions.begin(), _renditions.end(), [payload_type](const Rendition &rendition) {
+		return rendition.payload_type == payload_type;
+	});
+
+	if(current == _renditions.end() || _renditions.size() < 2)
+	{
+		_renditions.clear();
+	}
+	else
+	{
+		_rendition_index = static_cast<int>(current - _renditions.begin());
+
+		// The renditions share the SSRC, so they share the SR (RED packets have the same payload type already)
+		if(_red_block_pt == 0)
+		{
+			for(const auto &rendition : _renditions)
+			{
+				_rtp_rtcp->AddRtcpSRGenerator(rendition.payload_type, _video_ssrc);
+			}
+		}
+	}
+
+	_bandwidth_estimator = std::make_shared<RtcBandwidthEstimator>(_renditions.empty() ? RTC_BWE_MIN_BITRATE : _renditions[_rendition_index].bitrate);
+
+	// ULPFEC protects the header extensions, so the transport-wide sequence number isn't added to RED packets.
+	// The player sends REMB for the packets without the transport-wide sequence number.
+	if(transport_cc && _red_block_pt == 0)
+	{
+		_transport_cc_extension_id = peer_media_desc->GetExtmapId(TRANSPORT_CC_EXTENSION_URI);
+	}
+
+	logtd("Bandwidth estimation is enabled : session(%u) renditions(%zu) transport-cc(%d) remb(%d)",
+		  GetId(), _renditions.size(), _transport_cc_extension_id, remb);
+}
+
+void RtcSession::UpdateRendition()
+{
+	if(_renditions.size() < 2)
+	{
+		return;
+	}
+
+	auto estimated_bitrate = _bandwidth_estimator->GetEstimatedBitrate();
+	auto now = ov::Clock::NowMSec();
+
+	std::lock_guard<std::mutex> lock(_rendition_lock);
+
+	if(now - _last_switch_time < RTC_RENDITION_SWITCH_INTERVAL)
+	{
+		return;
+	}
+
+	auto pending_index = _pending_rendition_index.load();
+	int index = (pending_index >= 0) ? pending_index : _rendition_index.load();
+	int target_index = index;
+
+	if(estimated_bitrate < (_renditions[index].bitrate * RTC_RENDITION_SWITCH_DOWN_RATIO))
+	{
+		// The highest rendition under the estimated bitrate
+		target_index = 0;
+		for(int i = index - 1; i > 0; i--)
+		{
+			if(_renditions[i].bitrate <= estimated_bitrate)
+			{
+				target_index = i;
+				break;
+			}
+		}
+	}
+	else if((index + 1 < static_cast<int>(_renditions.size())) &&
+			(estimated_bitrate > (_renditions[index + 1].bitrate * RTC_RENDITION_SWITCH_UP_RATIO)) &&
+			(now - _last_switch_down_time >= RTC_RENDITION_SWITCH_UP_HOLD_TIME))
+	{
+		// Step up one by one
+		target_index = index + 1;
+	}
+
+	if(target_index == index)
+	{
+		return;
+	}
+
+	logtd("Session(%u) will switch the rendition at the next key frame : estimated bitrate(%" PRIu64 ") target bitrate(%" PRIu64 ")",
+		  GetId(), estimated_bitrate, _renditions[target_index].bitrate);
+
+	if(target_index < index)
+	{
+		_last_switch_down_time = now;
+	}
+
+	_last_switch_time = now;
+	// If the target is the rendition being sent, the pending switch is canceled
+	_pending_rendition_index = (target_index == _rendition_index) ? -1 : target_index;
+}
+
+void RtcSession::RefillRtxTokens()
+{
+	auto now = static_cast<int64_t>(ov::Clock::NowMSec());
+	uint64_t sent_bytes = _sent_media_bytes;
+
+	if(_rtx_last_measure_time == 0)
+	{
+		_rtx_last_measure_time = now;
+		_rtx_last_sent_bytes = sent_bytes;
+	}
+	else if(now - _rtx_last_measure_time >= RTC_RTX_BITRATE_WINDOW)
+	{
+		// Average send bitrate since the last measurement
+		auto send_bitrate = static_cast<int64_t>((sent_bytes - _rtx_last_sent_bytes) * 8 * 1000 / (now - _rtx_last_measure_time));
+
+		_rtx_bitrate = std::max<int64_t>(send_bitrate * RTC_RTX_BITRATE_RATIO, RTC_RTX_MIN_BITRATE);
+		_rtx_last_measure_time = now;
+		_rtx_last_sent_bytes = sent_bytes;
+	}
+
+	if(_rtx_last_refill_time != 0)
+	{
+		auto elapsed = std::max<int64_t>(now - _rtx_last_refill_time, 0);
+		auto burst_size = _rtx_bitrate / 8 * RTC_RTX_BURST_DURATION / 1000;
+
+		_rtx_tokens = std::min<int64_t>(_rtx_tokens + (elapsed * _rtx_bitrate / 8 / 1000), burst_size);
+	}
+
+	_rtx_last_refill_time = now;
 }
\ No newline at end of file
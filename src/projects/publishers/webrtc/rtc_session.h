@@ -9,8 +9,34 @@
 #include "modules/rtp_rtcp/rtp_rtcp.h"
 #include "modules/rtp_rtcp/rtp_packetizer_interface.h"
 #include "modules/dtls_srtp/dtls_transport.h"
+#include "modules/rtp_rtcp/rtx_rtp_packet.h"
+#include "modules/rtp_rtcp/transport_cc_rtp_packet.h"
+#include "rtc_bandwidth_estimator.h"
+#include "rtc_pacer.h"
+#include <deque>
 #include <unordered_set>
 
+// Retransmissions of a session are limited to (send bitrate of the session * ratio),
+// so that the repair traffic doesn't cause another loss burst
+#define RTC_RTX_BITRATE_RATIO			0.5
+// Retransmissions are allowed at least this bitrate, even if the session sends only a few packets (Unit: bits per second)
+#define RTC_RTX_MIN_BITRATE				(500 * 1000)
+// The send bitrate of the session is measured over this interval (Unit: milliseconds)
+#define RTC_RTX_BITRATE_WINDOW			1000
+// Retransmissions of this duration at the limited bitrate can be sent at once (Unit: milliseconds)
+#define RTC_RTX_BURST_DURATION			250
+
+// A session doesn't switch the rendition more often than this (Unit: milliseconds)
+#define RTC_RENDITION_SWITCH_INTERVAL		3000
+// After switching down, switching up is not tried for this time (Unit: milliseconds)
+#define RTC_RENDITION_SWITCH_UP_HOLD_TIME	10000
+// Switches down when the estimated bitrate is lower than (bitrate of the rendition * ratio)
+#define RTC_RENDITION_SWITCH_DOWN_RATIO		0.9
+// Switches up when the estimated bitrate is higher than (bitrate of the next rendition * ratio)
+#define RTC_RENDITION_SWITCH_UP_RATIO		1.3
+// The number of the sequence number segments kept to find the packets of NACK
+#define RTC_MAX_RTP_SEGMENTS				16
+
 /*
  *
  *
@@ -65,13 +91,45 @@ public:
 	const std::shared_ptr<WebSocketClient>& GetWSClient();
 
 	bool SendOutgoingData(const std::any &packet) override;
+	bool IsReadyToSend() override;
 	void OnPacketReceived(const std::shared_ptr<info::Session> &session_info, const std::shared_ptr<const ov::Data> &data) override;
 
 	void OnRtpFrameReceived(const std::vector<std::shared_ptr<RtpPacket>> &rtp_packets) override;
 	void OnRtcpReceived(const std::shared_ptr<RtcpInfo> &rtcp_info) override;
 
 private:
+	// A video track of the stream which the session can switch to
+	struct Rendition
+	{
+		uint8_t payload_type = 0;
+		// Unit: bits per second
+		uint64_t bitrate = 0;
+	};
+
+	// Video packets sent from a rendition since a switch.
+	// Sequence number in the session = Original sequence number + (first_sequence_number - first_original_sequence_number)
+	struct RtpSegment
+	{
+		// Payload type of the rendition (the block payload type if RED is used)
+		uint8_t payload_type = 0;
+		uint16_t first_sequence_number = 0;
+		uint16_t first_original_sequence_number = 0;
+	};
+
 	bool ProcessNACK(const std::shared_ptr<RtcpInfo> &rtcp_info);
+	void ProcessReceiverReport(const std::shared_ptr<RtcpInfo> &rtcp_info);
+
+	void InitializeRenditions(const std::shared_ptr<const MediaDescription> &peer_media_desc, uint8_t payload_type);
+	// Decides the rendition with the estimated bitrate, the stream worker switches at the next key frame
+	void UpdateRendition();
+	bool SendVideoPacket(const std::shared_ptr<RtpPacket> &packet, uint8_t media_payload_type);
+	// Sends the video packet through the pacer if pacing is enabled
+	// @param is_reused true if the packet is reused after this call (it is copied if the pacer holds the packet)
+	bool SendPacedPacket(const std::shared_ptr<RtpPacket> &packet, bool is_reused, int64_t *departure_time_us);
+	// Finds the segment of the sequence number in the session, _rtp_segments_lock must be held
+	const RtpSegment *FindRtpSegment(uint16_t sequence_number) const;
+	// Refills the token bucket of the retransmissions, _rtx_lock must be held
+	void RefillRtxTokens();
 
 	std::shared_ptr<WebRtcPublisher>	_publisher;
 
@@ -97,6 +155,51 @@ private:
 
 	uint16_t							_rtx_sequence_number = 1;
 
+	std::mutex							_rtx_lock;
+	// Retransmissions are built into this packet, it is reused for every retransmission of the session
+	std::shared_ptr<RtxRtpPacket>		_rtx_packet = std::make_shared<RtxRtpPacket>();
+	// Token bucket of the retransmissions (Unit: bytes)
+	int64_t								_rtx_tokens = RTC_RTX_MIN_BITRATE / 8 * RTC_RTX_BURST_DURATION / 1000;
+	int64_t								_rtx_last_refill_time = 0;
+	// Refill rate of the token bucket, derived from the send bitrate (Unit: bits per second)
+	int64_t								_rtx_bitrate = RTC_RTX_MIN_BITRATE;
+	// The point where the send bitrate was measured last
+	int64_t								_rtx_last_measure_time = 0;
+	uint64_t							_rtx_last_sent_bytes = 0;
+	// Bytes of the media packets sent to the session, written by the stream worker
+	std::atomic<uint64_t>				_sent_media_bytes{0};
+
+	// Bandwidth estimation (nullptr if the player doesn't send transport-cc or REMB)
+	std::shared_ptr<RtcBandwidthEstimator> _bandwidth_estimator;
+	// 0 if the transport-wide sequence number is not used
+	uint8_t								_transport_cc_extension_id = 0;
+
+	// Sorted by the bitrate, empty if the session doesn't switch the rendition
+	std::vector<Rendition>				_renditions;
+	std::mutex							_rendition_lock;
+	// Index of _renditions, the rendition being sent
+	std::atomic<int>					_rendition_index{0};
+	// Index of _renditions to switch at the next key frame, -1 if there is no switching
+	std::atomic<int>					_pending_rendition_index{-1};
+	uint64_t							_last_switch_time = 0;
+	uint64_t							_last_switch_down_time = 0;
+
+	// Used by the stream worker only
+	bool								_video_sent = false;
+	uint16_t							_last_video_sequence_number = 0;
+	uint16_t							_video_sequence_number_offset = 0;
+	// Original sequence number of the first packet since the last switch
+	uint16_t							_video_first_original_sequence_number = 0;
+	uint16_t							_transport_sequence_number = 1;
+	// The packets are copied into this packet to rewrite the sequence number or to add the transport-wide sequence number
+	std::shared_ptr<TransportCcRtpPacket>	_send_packet = std::make_shared<TransportCcRtpPacket>();
+
+	// nullptr if pacing is disabled
+	std::shared_ptr<RtcPacer>			_pacer;
+
+	std::mutex							_rtp_segments_lock;
+	std::deque<RtpSegment>				_rtp_segments;
+
 	uint64_t							_session_expired_time = 0;
 
 	std::shared_mutex					_start_stop_lock;
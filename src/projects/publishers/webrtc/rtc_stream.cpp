@@ -102,6 +102,8 @@ bool RtcStream::Start()
 
 	_rtx_enabled = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsRtxEnabled();
 	_ulpfec_enabled = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsUlpfecEnalbed();
+	SetGopCacheEnabled(GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsGopCacheEnabled());
+	_bandwidth_estimation_enabled = GetApplicationInfo().GetConfig().GetPublishers().GetWebrtcPublisher().IsBandwidthEstimationEnabled();
 
 	_offer_sdp = std::make_shared<SessionDescription>();
 	_offer_sdp->SetOrigin("OvenMediaEngine", ov::Random::GenerateUInt32(), 2, "IN", 4, "127.0.0.1");
@@ -213,6 +215,11 @@ bool RtcStream::Start()
 					{
 						video_media_desc->SetRtxSsrc(ov::Random::GenerateUInt32());
 					}
+					// Transport-wide sequence number for the bandwidth estimation
+					if (_bandwidth_estimation_enabled == true)
+					{
+						video_media_desc->AddExtmap(TRANSPORT_CC_EXTENSION_ID, TRANSPORT_CC_EXTENSION_URI);
+					}
 					_offer_sdp->AddMedia(video_media_desc);
 					first_video_desc = false;
 				}
@@ -224,7 +231,14 @@ bool RtcStream::Start()
 					payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
 				}
 
+				if (_bandwidth_estimation_enabled == true)
+				{
+					payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
+					payload->EnableRtcpFb(PayloadAttr::RtcpFbType::GoogRemb, true);
+				}
+
 				video_media_desc->AddPayload(payload);
+				_payload_track_map[payload->GetId()] = track;
 
 				// For RTX
 				if (_rtx_enabled == true)
@@ -315,6 +329,11 @@ bool RtcStream::Start()
 		{
 			red_payload->EnableRtcpFb(PayloadAttr::RtcpFbType::Nack, true);
 		}
+		if (_bandwidth_estimation_enabled == true)
+		{
+			red_payload->EnableRtcpFb(PayloadAttr::RtcpFbType::TransportCc, true);
+			red_payload->EnableRtcpFb(PayloadAttr::RtcpFbType::GoogRemb, true);
+		}
 		video_media_desc->AddPayload(red_payload);
 
 		// ULPFEC
@@ -438,6 +457,12 @@ void RtcStream::SendVideoFrame(const std::shared_ptr<MediaPacket> &media_packet)
 	auto data = media_packet->GetData();
 	auto fragmentation = media_packet->GetFragHeader();
 
+	if (frame_type == FrameType::VideoFrameKey)
+	{
+		// Callback OnRtpPacketized() is called synchronously, so the packets of this frame are the first of the cache
+		StartGopCache(media_track->GetId());
+	}
+
 	packetizer->Packetize(frame_type,
 						  timestamp,
 						  data->GetDataAs<uint8_t>(),
@@ -580,18 +605,13 @@ std::shared_ptr<RtpHistory> RtcStream::GetHistory(uint8_t origin_payload_type)
 	return _rtp_history_map[origin_payload_type];
 }
 
-std::shared_ptr<RtxRtpPacket> RtcStream::GetRtxRtpPacket(uint8_t origin_payload_type, uint16_t origin_sequence_number)
+std::shared_ptr<MediaTrack> RtcStream::GetTrackByPayloadType(uint8_t payload_type)
 {
-	if(GetState() != State::STARTED)
-	{
-		return nullptr;
-	}
-
-	auto history = GetHistory(origin_payload_type);
-	if (history == nullptr)
+	auto item = _payload_track_map.find(payload_type);
+	if (item == _payload_track_map.end())
 	{
 		return nullptr;
 	}
 
-	return history->GetRtxRtpPacket(origin_sequence_number);
-}
\ No newline at end of file
+	return item->second;
+}
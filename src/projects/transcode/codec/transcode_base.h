@@ -9,6 +9,7 @@
 #pragma once
 
 #include "../transcode_context.h"
+#include "../transcode_worker_pool.h"
 
 extern "C"
 {
@@ -79,7 +80,48 @@ public:
 		return _output_buffer.Size();
 	}
 
+	// Processes the inputs of _input_buffer until the queue is drained (Called by TranscodeWorkerPool)
+	virtual void ProcessInputBuffer() = 0;
+
+	// The stages of a stream prefer the same core if they have the same hint
+	void SetAffinityHint(uint32_t hint)
+	{
+		if (_worker != nullptr)
+		{
+			_worker->SetAffinityHint(hint);
+		}
+	}
+
 protected:
+	void CreateWorker(TranscodeStage stage)
+	{
+		_worker = std::make_shared<TranscodeWorker>(
+			stage,
+			[this]() {
+				ProcessInputBuffer();
+			},
+			[this]() -> bool {
+				return (_input_buffer.IsEmpty() == false);
+			});
+	}
+
+	// Schedules the worker if there is an input to process
+	void ScheduleWorker()
+	{
+		if (_worker != nullptr)
+		{
+			_worker->ScheduleIfNeeded();
+		}
+	}
+
+	void StopWorker()
+	{
+		if (_worker != nullptr)
+		{
+			_worker->Stop();
+		}
+	}
+
 	static bool IsPlanar(AVSampleFormat format)
 	{
 		switch(format)
@@ -105,7 +147,9 @@ protected:
 		}
 	}
 
-	ov::Queue<std::shared_ptr<const InputType>> _input_buffer;
-	ov::Queue<std::shared_ptr<OutputType>> _output_buffer;
+	ov::RingQueue<std::shared_ptr<const InputType>, ov::RingQueueProducer::Single> _input_buffer;
+	ov::RingQueue<std::shared_ptr<OutputType>, ov::RingQueueProducer::Single> _output_buffer;
+
+	std::shared_ptr<TranscodeWorker> _worker;
 };
 
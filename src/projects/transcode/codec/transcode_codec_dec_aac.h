@@ -30,7 +30,7 @@ public:
 	int64_t _last_pkt_pts = 0;
 	std::shared_ptr<MediaFrame> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadDecode() override;
+	void ProcessInputBuffer() override;
 
 protected:
 };
@@ -24,7 +24,7 @@ public:
         return AV_CODEC_ID_H265;
     }
 
-    void ThreadDecode() override;
+    void ProcessInputBuffer() override;
 
     std::shared_ptr<MediaFrame> RecvBuffer(TranscodeResult *result) override;
 };
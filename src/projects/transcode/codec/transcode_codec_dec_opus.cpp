@@ -11,7 +11,7 @@
 #include "../transcode_private.h"
 #include "base/info/application.h"
 
-void OvenCodecImplAvcodecDecOPUS::ThreadDecode()
+void OvenCodecImplAvcodecDecOPUS::ProcessInputBuffer()
 {
 	bool no_data_to_encode = false;
 
@@ -22,10 +22,11 @@ void OvenCodecImplAvcodecDecOPUS::ThreadDecode()
 		/////////////////////////////////////////////////////////////////////
 		if (_cur_pkt == nullptr && (_input_buffer.IsEmpty() == false || no_data_to_encode == true))
 		{
-			auto obj = _input_buffer.Dequeue();
+			auto obj = _input_buffer.Dequeue(0);
 			if (obj.has_value() == false)
 			{
-				continue;
+				// The input queue is drained, return the thread to the pool
+				break;
 			}
 
 			no_data_to_encode = false;
@@ -9,17 +9,18 @@
 #include "transcode_codec_dec_vp8.h"
 
 #include "../transcode_private.h"
+#include "transcode_frame_reference.h"
 #include "base/info/application.h"
 
-void OvenCodecImplAvcodecDecVP8::ThreadDecode()
+void OvenCodecImplAvcodecDecVP8::ProcessInputBuffer()
 {
 	while (!_kill_flag)
 	{
-		auto obj = _input_buffer.Dequeue();
+		auto obj = _input_buffer.Dequeue(0);
 		if (obj.has_value() == false)
 		{
-			// logte("An error occurred while dequeue : no data");
-			continue;
+			// The input queue is drained, return the thread to the pool
+			break;
 		}
 
 		auto buffer = std::move(obj.value());
@@ -156,21 +157,25 @@ void OvenCodecImplAvcodecDecVP8::ThreadDecode()
 				int64_t duration = (den == 0) ? 0LL : (float)den / _input_context->GetFrameRate();
 				decoded_frame->SetDuration(duration);
 
-				decoded_frame->SetStride(_frame->linesize[0], 0);
-				decoded_frame->SetStride(_frame->linesize[1], 1);
-				decoded_frame->SetStride(_frame->linesize[2], 2);
-
-				if (_frame->format == AV_PIX_FMT_YUV444P)
-				{
-					decoded_frame->SetBuffer(_frame->data[0], decoded_frame->GetStride(0) * decoded_frame->GetHeight(), 0);	 // Y-Plane 4
-					decoded_frame->SetBuffer(_frame->data[1], decoded_frame->GetStride(1) * decoded_frame->GetHeight(), 1);	 // Cb Plane 4
-					decoded_frame->SetBuffer(_frame->data[2], decoded_frame->GetStride(2) * decoded_frame->GetHeight(), 2);	 // Cr Plane 4
-				}
-				else
+				// Refer to the decoded frame instead of copying the planes
+				if (TranscodeFrameReference::Attach(decoded_frame.get(), _frame) == false)
 				{
-					decoded_frame->SetBuffer(_frame->data[0], decoded_frame->GetStride(0) * decoded_frame->GetHeight(), 0);		 // Y-Plane 4
-					decoded_frame->SetBuffer(_frame->data[1], decoded_frame->GetStride(1) * decoded_frame->GetHeight() / 2, 1);	 // Cb Plane 2
-					decoded_frame->SetBuffer(_frame->data[2], decoded_frame->GetStride(2) * decoded_frame->GetHeight() / 2, 2);	 // Cr Plane 2
+					decoded_frame->SetStride(_frame->linesize[0], 0);
+					decoded_frame->SetStride(_frame->linesize[1], 1);
+					decoded_frame->SetStride(_frame->linesize[2], 2);
+
+					if (_frame->format == AV_PIX_FMT_YUV444P)
+					{
+						decoded_frame->SetBuffer(_frame->data[0], decoded_frame->GetStride(0) * decoded_frame->GetHeight(), 0);	 // Y-Plane 4
+						decoded_frame->SetBuffer(_frame->data[1], decoded_frame->GetStride(1) * decoded_frame->GetHeight(), 1);	 // Cb Plane 4
+						decoded_frame->SetBuffer(_frame->data[2], decoded_frame->GetStride(2) * decoded_frame->GetHeight(), 2);	 // Cr Plane 4
+					}
+					else
+					{
+						decoded_frame->SetBuffer(_frame->data[0], decoded_frame->GetStride(0) * decoded_frame->GetHeight(), 0);		 // Y-Plane 4
+						decoded_frame->SetBuffer(_frame->data[1], decoded_frame->GetStride(1) * decoded_frame->GetHeight() / 2, 1);	 // Cb Plane 2
+						decoded_frame->SetBuffer(_frame->data[2], decoded_frame->GetStride(2) * decoded_frame->GetHeight() / 2, 2);	 // Cr Plane 2
+					}
 				}
 
 				::av_frame_unref(_frame);
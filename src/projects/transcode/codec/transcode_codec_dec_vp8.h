@@ -22,7 +22,7 @@ public:
 	{
 		return AV_CODEC_ID_VP8;
 	}
-	void ThreadDecode() override;
+	void ProcessInputBuffer() override;
 
 	std::shared_ptr<MediaFrame> RecvBuffer(TranscodeResult *result) override;
 };
@@ -61,45 +61,19 @@ bool OvenCodecImplAvcodecEncAAC::Configure(std::shared_ptr<TranscodeContext> out
 		return false;
 	}
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&OvenCodecImplAvcodecEncAAC::ThreadEncode, this);
-		pthread_setname_np(_thread_work.native_handle(), "EncAAC");
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode stream thread.");
-	}
-
 	return true;
 }
 
-void OvenCodecImplAvcodecEncAAC::Stop()
-{
-	_kill_flag = true;
-
-	_input_buffer.Stop();
-	_output_buffer.Stop();
-
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("AAC encoder thread has ended.");
-	}
-}
-
-void OvenCodecImplAvcodecEncAAC::ThreadEncode()
+void OvenCodecImplAvcodecEncAAC::ProcessInputBuffer()
 {
 	while (!_kill_flag)
 	{
-		auto obj = _input_buffer.Dequeue();
+		auto obj = _input_buffer.Dequeue(0);
 		if (obj.has_value() == false)
-			continue;
+		{
+			// The input queue is drained, return the thread to the pool
+			break;
+		}
 
 		auto buffer = std::move(obj.value());
 
@@ -24,7 +24,5 @@ public:
 
 	std::shared_ptr<MediaPacket> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadEncode() override;
-
-	void Stop() override;	
+	void ProcessInputBuffer() override;
 };
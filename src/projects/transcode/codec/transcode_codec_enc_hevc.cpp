@@ -11,6 +11,7 @@
 #include <unistd.h>
 
 #include "../transcode_private.h"
+#include "transcode_frame_reference.h"
 
 OvenCodecImplAvcodecEncHEVC::~OvenCodecImplAvcodecEncHEVC()
 {
@@ -93,82 +94,63 @@ bool OvenCodecImplAvcodecEncHEVC::Configure(std::shared_ptr<TranscodeContext> co
 		return false;
 	}
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&OvenCodecImplAvcodecEncHEVC::ThreadEncode, this);
-		pthread_setname_np(_thread_work.native_handle(), "EncHEVC");
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode stream thread.");
-	}
-
 	return true;
 }
 
-void OvenCodecImplAvcodecEncHEVC::Stop()
-{
-	_kill_flag = true;
-
-	_input_buffer.Stop();
-	_output_buffer.Stop();
-
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("AVC encoder thread has ended.");
-	}
-}
-
-void OvenCodecImplAvcodecEncHEVC::ThreadEncode()
+void OvenCodecImplAvcodecEncHEVC::ProcessInputBuffer()
 {
 	while (!_kill_flag)
 	{
-		auto obj = _input_buffer.Dequeue();
+		auto obj = _input_buffer.Dequeue(0);
 		if (obj.has_value() == false)
-			continue;
+		{
+			// The input queue is drained, return the thread to the pool
+			break;
+		}
 
 		auto frame = std::move(obj.value());
 
 		///////////////////////////////////////////////////
 		// Request frame encoding to codec
 		///////////////////////////////////////////////////
-		_frame->format = frame->GetFormat();
-		_frame->nb_samples = 1;
-		_frame->pts = frame->GetPts();
-		// The encoder will not pass this duration
-		_frame->pkt_duration = frame->GetDuration();
+		// If the frame refers to an AVFrame of the previous stage, encode it without copying
+		if (TranscodeFrameReference::Reference(_frame, frame.get()) == false)
+		{
+			_frame->format = frame->GetFormat();
+			_frame->nb_samples = 1;
+			_frame->pts = frame->GetPts();
+			// The encoder will not pass this duration
+			_frame->pkt_duration = frame->GetDuration();
 
-		_frame->width = frame->GetWidth();
-		_frame->height = frame->GetHeight();
-		_frame->linesize[0] = frame->GetStride(0);
-		_frame->linesize[1] = frame->GetStride(1);
-		_frame->linesize[2] = frame->GetStride(2);
+			_frame->width = frame->GetWidth();
+			_frame->height = frame->GetHeight();
+			_frame->linesize[0] = frame->GetStride(0);
+			_frame->linesize[1] = frame->GetStride(1);
+			_frame->linesize[2] = frame->GetStride(2);
 
-		// logte("hevc queue : %d / %lld", _input_buffer.size(), _frame->pts);
+			// logte("hevc queue : %d / %lld", _input_buffer.size(), _frame->pts);
 
-		if (::av_frame_get_buffer(_frame, 32) < 0)
-		{
-			logte("Could not allocate the video frame data");
-			// *result = TranscodeResult::DataError;
-			break;
-		}
+			if (::av_frame_get_buffer(_frame, 32) < 0)
+			{
+				logte("Could not allocate the video frame data");
+				// *result = TranscodeResult::DataError;
+				break;
+			}
 
-		if (::av_frame_make_writable(_frame) < 0)
-		{
-			logte("Could not make sure the frame data is writable");
-			// *result = TranscodeResult::DataError;
-			break;
+			if (::av_frame_make_writable(_frame) < 0)
+			{
+				logte("Could not make sure the frame data is writable");
+				// *result = TranscodeResult::DataError;
+				break;
+			}
+
+			::memcpy(_frame->data[0], frame->GetBuffer(0), frame->GetBufferSize(0));
+			::memcpy(_frame->data[1], frame->GetBuffer(1), frame->GetBufferSize(1));
+			::memcpy(_frame->data[2], frame->GetBuffer(2), frame->GetBufferSize(2));
 		}
 
-		::memcpy(_frame->data[0], frame->GetBuffer(0), frame->GetBufferSize(0));
-		::memcpy(_frame->data[1], frame->GetBuffer(1), frame->GetBufferSize(1));
-		::memcpy(_frame->data[2], frame->GetBuffer(2), frame->GetBufferSize(2));
+		// Both the referenced and the copied frame restart the rendition on a key frame if requested
+		ApplyKeyFrameRequest(_frame);
 
 		int ret = ::avcodec_send_frame(_context, _frame);
 		::av_frame_unref(_frame);
@@ -24,8 +24,7 @@ public:
 
 	std::shared_ptr<MediaPacket> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadEncode() override;
+	void ProcessInputBuffer() override;
 
-	void Stop() override;
 
 };
@@ -72,52 +72,25 @@ bool OvenCodecImplAvcodecEncOpus::Configure(std::shared_ptr<TranscodeContext> co
 	_format = cmn::AudioSample::Format::None;
 	_current_pts = -1;
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&OvenCodecImplAvcodecEncOpus::ThreadEncode, this);
-		pthread_setname_np(_thread_work.native_handle(), "EncOPUS");
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode stream thread.");
-	}
 
 	return true;
 }
 
-void OvenCodecImplAvcodecEncOpus::Stop()
-{
-	_kill_flag = true;
-
-	_input_buffer.Stop();
-	_output_buffer.Stop();
-
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("OPUS encoder thread has ended.");
-	}
-}
-
-void OvenCodecImplAvcodecEncOpus::ThreadEncode()
+void OvenCodecImplAvcodecEncOpus::ProcessInputBuffer()
 {
 	const unsigned int frame_count_to_encode = 480 * 2;
 	const unsigned int bytes_to_encode = frame_count_to_encode * _output_context->GetAudioChannel().GetCounts() * _output_context->GetAudioSample().GetSampleSize();
 
-	int64_t duration = 0LL;
-
 	while (!_kill_flag)
 	{
 		if (_buffer->GetLength() < bytes_to_encode)
 		{
-			auto obj = _input_buffer.Dequeue();
+			auto obj = _input_buffer.Dequeue(0);
 			if (obj.has_value() == false)
-				continue;
+			{
+				// The input queue is drained, return the thread to the pool
+				break;
+			}
 
 			auto frame_buffer = std::move(obj.value());
 
@@ -133,7 +106,7 @@ void OvenCodecImplAvcodecEncOpus::ThreadEncode()
 				_current_pts = frame->GetPts();
 			}
 
-			duration += frame->GetDuration();
+			_duration += frame->GetDuration();
 
 			// Append frame data into the buffer
 
@@ -234,7 +207,7 @@ void OvenCodecImplAvcodecEncOpus::ThreadEncode()
 		::memmove(buffer, buffer + bytes_to_encode, _buffer->GetLength() - bytes_to_encode);
 		_buffer->SetLength(_buffer->GetLength() - bytes_to_encode);
 
-		auto packet_buffer = std::make_shared<MediaPacket>(cmn::MediaType::Audio, 1, encoded, _current_pts, _current_pts, duration, MediaPacketFlag::Key);
+		auto packet_buffer = std::make_shared<MediaPacket>(cmn::MediaType::Audio, 1, encoded, _current_pts, _current_pts, _duration, MediaPacketFlag::Key);
 		packet_buffer->SetBitstreamFormat(cmn::BitstreamFormat::OPUS);
 		packet_buffer->SetPacketType(cmn::PacketType::RAW);
 
@@ -244,7 +217,7 @@ void OvenCodecImplAvcodecEncOpus::ThreadEncode()
 
 		SendOutputBuffer(std::move(packet_buffer));
 
-		duration = 0L;
+		_duration = 0L;
 	}
 }
 
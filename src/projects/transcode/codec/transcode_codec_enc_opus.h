@@ -27,15 +27,15 @@ public:
 
 	std::shared_ptr<MediaPacket> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadEncode() override;
-
-	void Stop() override;
+	void ProcessInputBuffer() override;
 
 protected:
 	std::shared_ptr<ov::Data> _buffer;
 
 	cmn::AudioSample::Format _format;
 	int64_t _current_pts;
+	// Sum of the durations of the frames in _buffer (ProcessInputBuffer() can return before encoding them)
+	int64_t _duration = 0LL;
 
 	OpusEncoder *_encoder;
 };
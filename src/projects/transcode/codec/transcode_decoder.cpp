@@ -138,20 +138,9 @@ bool TranscodeDecoder::Configure(std::shared_ptr<TranscodeContext> context)
 	_output_buffer.SetAlias(ov::String::FormatString("Output queue of transcode decoder. codec(%s/%d)", ::avcodec_get_name(GetCodecID()), GetCodecID()));
 	_output_buffer.SetThreshold(MAX_QUEUE_SIZE);
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&TranscodeDecoder::ThreadDecode, this);
-		pthread_setname_np(_thread_work.native_handle(), ov::String::FormatString("Decoder%s", avcodec_get_name(GetCodecID())).CStr());
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode stream thread.");
-	}
+	// The packets in the input_buffer queue are decoded by TranscodeWorkerPool and placed in the output queue.
+	_kill_flag = false;
+	CreateWorker(TranscodeStage::Decoder);
 
 	return true;
 }
@@ -159,6 +148,8 @@ bool TranscodeDecoder::Configure(std::shared_ptr<TranscodeContext> context)
 void TranscodeDecoder::SendBuffer(std::shared_ptr<const MediaPacket> packet)
 {
 	_input_buffer.Enqueue(std::move(packet));
+
+	ScheduleWorker();
 }
 
 void TranscodeDecoder::Stop()
@@ -168,11 +159,10 @@ void TranscodeDecoder::Stop()
 	_input_buffer.Stop();
 	_output_buffer.Stop();
 
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd(ov::String::FormatString("decoder %s thread has ended.", avcodec_get_name(GetCodecID())).CStr());
-	}
+	// Wait until the pool finishes decoding
+	StopWorker();
+
+	logtd("Decoder %s has stopped", ::avcodec_get_name(GetCodecID()));
 }
 
 const ov::String TranscodeDecoder::ShowCodecParameters(const AVCodecContext *context, const AVCodecParameters *parameters)
@@ -29,8 +29,6 @@ public:
 
 	cmn::Timebase GetTimebase() const;
 
-	virtual void ThreadDecode() = 0;
-
 	virtual void Stop();
 
 	typedef std::function<void(TranscodeResult, int32_t)> _cb_func;
@@ -60,5 +58,4 @@ protected:
 	info::Stream _stream_info;
 
 	bool _kill_flag = false;
-	std::thread _thread_work;
 };
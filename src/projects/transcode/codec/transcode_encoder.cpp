@@ -107,12 +107,18 @@ bool TranscodeEncoder::Configure(std::shared_ptr<TranscodeContext> context)
 	_output_buffer.SetAlias(ov::String::FormatString("Output queue of transcode encoder. codec(%s/%d)", ::avcodec_get_name(GetCodecID()), GetCodecID()));
 	_output_buffer.SetThreshold(MAX_QUEUE_SIZE);
 
+	// The frames in the input_buffer queue are encoded by TranscodeWorkerPool and placed in the output queue.
+	_kill_flag = false;
+	CreateWorker(TranscodeStage::Encoder);
+
 	return (_output_context != nullptr);
 }
 
 void TranscodeEncoder::SendBuffer(std::shared_ptr<const MediaFrame> frame)
 {
 	_input_buffer.Enqueue(std::move(frame));
+
+	ScheduleWorker();
 }
 
 void TranscodeEncoder::SendOutputBuffer(std::shared_ptr<MediaPacket> packet)
@@ -129,12 +135,28 @@ std::shared_ptr<TranscodeContext> &TranscodeEncoder::GetContext()
 	return _output_context;
 }
 
-void TranscodeEncoder::ThreadEncode()
+void TranscodeEncoder::RequestKeyFrame()
+{
+	_key_frame_requested = true;
+}
+
+void TranscodeEncoder::ApplyKeyFrameRequest(AVFrame *frame)
 {
-	// nothing...
+	if (_key_frame_requested.exchange(false))
+	{
+		frame->pict_type = AV_PICTURE_TYPE_I;
+	}
 }
 
 void TranscodeEncoder::Stop()
 {
-	// nothing...
+	_kill_flag = true;
+
+	_input_buffer.Stop();
+	_output_buffer.Stop();
+
+	// Wait until the pool finishes encoding
+	StopWorker();
+
+	logtd("Encoder %s has stopped", ::avcodec_get_name(GetCodecID()));
 }
\ No newline at end of file
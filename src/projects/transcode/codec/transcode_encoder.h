@@ -26,12 +26,13 @@ public:
 
 	std::shared_ptr<TranscodeContext>& GetContext();
 
-	virtual void ThreadEncode();
-
 	virtual void Stop();
 
 	cmn::Timebase GetTimebase() const;
 
+	// The next frame is encoded as a key frame (e.g. when the output is resumed)
+	void RequestKeyFrame();
+
 	// TODO(soulk): The encoder and decoder are also changed to the way callback is called 
 	// when the encoder and decoder are completed.
 	typedef std::function<TranscodeResult(int32_t)> _cb_func;
@@ -41,6 +42,9 @@ public:
 	}
 
 protected:
+	// Marks the frame as a key frame if RequestKeyFrame() was called
+	void ApplyKeyFrameRequest(AVFrame *frame);
+
 	std::shared_ptr<TranscodeContext> _output_context = nullptr;
 
 	int32_t _track_id;
@@ -57,6 +61,7 @@ protected:
 	int _decoded_frame_num = 0;
 
 	bool _kill_flag = false;
-	std::thread _thread_work;
+
+	std::atomic<bool> _key_frame_requested{false};
 
 };
@@ -0,0 +1,107 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Kwon Keuk Han
+//  Copyright (c) 2018 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+extern "C"
+{
+#include <libavutil/frame.h>
+#include <libavutil/pixdesc.h>
+}
+
+#include <base/mediarouter/media_buffer.h>
+
+// Passes the video frames between the decoder, the filters and the encoders by reference.
+//
+// MediaFrame holds a new reference of the AVFrame (av_frame_clone() only increases the reference count of AVBufferRef),
+// and the planes of MediaFrame point into the AVFrame.
+// So the next stage can use the AVFrame as it is instead of copying the planes into its own AVFrame.
+class TranscodeFrameReference
+{
+public:
+	// Attach the <frame> to the <media_frame> without copying the planes
+	//
+	// @return Returns false if the frame is not reference-counted or cannot be referenced
+	static bool Attach(MediaFrame *media_frame, const AVFrame *frame)
+	{
+		if ((media_frame == nullptr) || (frame == nullptr) || (frame->buf[0] == nullptr))
+		{
+			return false;
+		}
+
+		auto descriptor = ::av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format));
+
+		if (descriptor == nullptr)
+		{
+			return false;
+		}
+
+		AVFrame *reference = ::av_frame_clone(frame);
+
+		if (reference == nullptr)
+		{
+			return false;
+		}
+
+		std::shared_ptr<void> native_frame(reference, [](void *data) {
+			auto av_frame = static_cast<AVFrame *>(data);
+			::av_frame_free(&av_frame);
+		});
+
+		int plane_count = ::av_pix_fmt_count_planes(static_cast<AVPixelFormat>(frame->format));
+
+		for (int plane = 0; plane < 3; plane++)
+		{
+			if (plane < plane_count)
+			{
+				// Chroma planes are subsampled by log2_chroma_h
+				int height = (plane == 0) ? reference->height : AV_CEIL_RSHIFT(reference->height, descriptor->log2_chroma_h);
+
+				media_frame->SetStride(reference->linesize[plane], plane);
+				media_frame->SetBufferReference(reference->data[plane], reference->linesize[plane] * height, plane);
+			}
+			else
+			{
+				media_frame->SetStride(0, plane);
+				media_frame->SetBufferReference(nullptr, 0, plane);
+			}
+		}
+
+		media_frame->SetNativeFrame(std::move(native_frame));
+
+		return true;
+	}
+
+	// @return Returns the AVFrame which the planes of <media_frame> refer to, or nullptr if the planes are owned by <media_frame>
+	static const AVFrame *GetFrame(const MediaFrame *media_frame)
+	{
+		return (media_frame != nullptr) ? media_frame->GetNativeFrame<AVFrame>() : nullptr;
+	}
+
+	// Make <dst> refer to the AVFrame of <media_frame> and apply the timing information of <media_frame>
+	//
+	// @return Returns false if <media_frame> doesn't have an AVFrame. In this case, the caller must copy the planes.
+	static bool Reference(AVFrame *dst, const MediaFrame *media_frame)
+	{
+		auto frame = GetFrame(media_frame);
+
+		if ((frame == nullptr) || (::av_frame_ref(dst, frame) < 0))
+		{
+			return false;
+		}
+
+		dst->pts = media_frame->GetPts();
+		dst->pkt_duration = media_frame->GetDuration();
+
+		// Do not inherit the picture type of the source, so that the encoder decides the GOP
+		dst->pict_type = AV_PICTURE_TYPE_NONE;
+		dst->key_frame = 0;
+
+		return true;
+	}
+};
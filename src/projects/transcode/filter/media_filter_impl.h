@@ -11,8 +11,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <memory>
-#include <thread>
 #include <vector>
 
 #include "../codec/transcode_base.h"
@@ -43,6 +43,8 @@ public:
 	virtual int32_t SendBuffer(std::shared_ptr<MediaFrame> buffer) = 0;
 	virtual std::shared_ptr<MediaFrame> RecvBuffer(TranscodeResult *result) = 0;
 
+	virtual void Stop() = 0;
+
 	static AVRational TimebaseToAVRational(const cmn::Timebase &timebase)
 	{
 		return (AVRational){
@@ -71,9 +73,59 @@ public:
 		return _output_context->GetTimeBase();
 	}
 
+	// Processes the inputs of _input_buffer until the queue is drained (Called by TranscodeWorkerPool)
+	virtual void ProcessInputBuffer() = 0;
+
+	// The stages of a stream prefer the same core if they have the same hint
+	void SetAffinityHint(uint32_t hint)
+	{
+		if (_worker != nullptr)
+		{
+			_worker->SetAffinityHint(hint);
+		}
+	}
+
+	// Called when the filtered frames are placed in the output queue
+	typedef std::function<void()> _cb_func;
+	_cb_func OnCompleteHandler;
+	void SetOnCompleteHandler(_cb_func func)
+	{
+		OnCompleteHandler = std::move(func);
+	}
+
 protected:
-	ov::Queue<std::shared_ptr<MediaFrame>> _input_buffer;
-	ov::Queue<std::shared_ptr<MediaFrame>> _output_buffer;
+	void CreateWorker()
+	{
+		_worker = std::make_shared<TranscodeWorker>(
+			TranscodeStage::Filter,
+			[this]() {
+				ProcessInputBuffer();
+			},
+			[this]() -> bool {
+				return (_input_buffer.IsEmpty() == false);
+			});
+	}
+
+	// Schedules the worker if there is an input to process
+	void ScheduleWorker()
+	{
+		if (_worker != nullptr)
+		{
+			_worker->ScheduleIfNeeded();
+		}
+	}
+
+	void StopWorker()
+	{
+		if (_worker != nullptr)
+		{
+			_worker->Stop();
+		}
+	}
+
+
+	ov::RingQueue<std::shared_ptr<MediaFrame>, ov::RingQueueProducer::Single> _input_buffer;
+	ov::RingQueue<std::shared_ptr<MediaFrame>, ov::RingQueueProducer::Single> _output_buffer;
 
 	AVFrame *_frame = nullptr;
 	AVFilterContext *_buffersink_ctx = nullptr;
@@ -88,6 +140,6 @@ protected:
 	std::shared_ptr<TranscodeContext> _output_context;
 
 	bool _kill_flag = false;
-	std::thread _thread_work;
+	std::shared_ptr<TranscodeWorker> _worker;
 };
 
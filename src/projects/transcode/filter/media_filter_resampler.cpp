@@ -158,20 +158,9 @@ bool MediaFilterResampler::Configure(const std::shared_ptr<MediaTrack> &input_me
 	_input_context = input_context;
 	_output_context = output_context;
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&MediaFilterResampler::ThreadFilter, this);
-		pthread_setname_np(_thread_work.native_handle(), "Filter");
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode resample filter thread.");
-	}
+	// The frames in the input_buffer queue are filtered by TranscodeWorkerPool and placed in the output queue.
+	_kill_flag = false;
+	CreateWorker();
 
 	return true;
 }
@@ -187,23 +176,21 @@ void MediaFilterResampler::Stop()
 	_output_buffer.Stop();
 	
 
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("Terminated transcode resample filter thread.");
-	}
+	// Wait until the pool finishes filtering
+	StopWorker();
 }
 
 
-void MediaFilterResampler::ThreadFilter()
+void MediaFilterResampler::ProcessInputBuffer()
 {
-	logtd("Start transcode resampler filter thread.");
-
 	while (!_kill_flag)
 	{
-		auto obj = _input_buffer.Dequeue();
+		auto obj = _input_buffer.Dequeue(0);
 		if (obj.has_value() == false)
-			continue;
+		{
+			// The input queue is drained, return the thread to the pool
+			break;
+		}
 
 		auto frame = std::move(obj.value());
 
@@ -327,6 +314,11 @@ void MediaFilterResampler::ThreadFilter()
 				::av_frame_unref(_frame);
 
 				_output_buffer.Enqueue(std::move(output_frame));
+
+				if (OnCompleteHandler)
+				{
+					OnCompleteHandler();
+				}
 			}
 		}
 	}
@@ -336,6 +328,8 @@ int32_t MediaFilterResampler::SendBuffer(std::shared_ptr<MediaFrame> buffer)
 {
 	_input_buffer.Enqueue(std::move(buffer));
 
+	ScheduleWorker();
+
 	return 0;
 }
 
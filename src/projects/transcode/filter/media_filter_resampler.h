@@ -26,9 +26,9 @@ public:
 	int32_t SendBuffer(std::shared_ptr<MediaFrame> buffer) override;
 	std::shared_ptr<MediaFrame> RecvBuffer(TranscodeResult *result) override;
 
-	void ThreadFilter();
+	void ProcessInputBuffer() override;
 
-	void Stop();
+	void Stop() override;
 
 protected:
 	bool IsPlanar(AVSampleFormat format);
@@ -11,6 +11,7 @@
 
 #include <base/ovlibrary/ovlibrary.h>
 #include "../transcode_private.h"
+#include "../codec/transcode_frame_reference.h"
 
 
 MediaFilterRescaler::MediaFilterRescaler()
@@ -162,20 +163,9 @@ bool MediaFilterRescaler::Configure(const std::shared_ptr<MediaTrack> &input_med
 	_input_context = input_context;
 	_output_context = output_context;
 
-	// Generates a thread that reads and encodes frames in the input_buffer queue and places them in the output queue.
-	try
-	{
-		_kill_flag = false;
-
-		_thread_work = std::thread(&MediaFilterRescaler::ThreadFilter, this);
-		pthread_setname_np(_thread_work.native_handle(), "Rescaler");
-	}
-	catch (const std::system_error &e)
-	{
-		_kill_flag = true;
-
-		logte("Failed to start transcode rescale filter thread.");
-	}
+	// The frames in the input_buffer queue are filtered by TranscodeWorkerPool and placed in the output queue.
+	_kill_flag = false;
+	CreateWorker();
 
 	return true;
 }
@@ -184,6 +174,8 @@ int32_t MediaFilterRescaler::SendBuffer(std::shared_ptr<MediaFrame> buffer)
 {
 	_input_buffer.Enqueue(std::move(buffer));
 
+	ScheduleWorker();
+
 	return 0;
 }
 
@@ -194,56 +186,60 @@ void MediaFilterRescaler::Stop()
 	_input_buffer.Stop();
 	_output_buffer.Stop();
 
-	if (_thread_work.joinable())
-	{
-		_thread_work.join();
-		logtd("Terminated transcode rescale filter thread.");
-	}
+	// Wait until the pool finishes filtering
+	StopWorker();
 }
 
-void MediaFilterRescaler::ThreadFilter()
+void MediaFilterRescaler::ProcessInputBuffer()
 {
-	logtd("Start transcode rescaler filter thread.");
-
 	while (!_kill_flag)
 	{
-		auto obj = _input_buffer.Dequeue();
+		auto obj = _input_buffer.Dequeue(0);
 		if (obj.has_value() == false)
-			continue;
+		{
+			// The input queue is drained, return the thread to the pool
+			break;
+		}
 
 		auto frame = std::move(obj.value());
 
 		// logte("Filter Queue : %d / %d", _input_buffer.Size(), _output_buffer.Size());
 		// logtp("Dequeued data for rescaling: %lld (%.0f)\n%s", frame->GetPts(), frame->GetPts() * _output_context->GetTimeBase().GetExpr() * 1000.0f, ov::Dump(frame->GetBuffer(0), frame->GetBufferSize(0), 32).CStr());
 
-		_frame->format = frame->GetFormat();
-		_frame->width = frame->GetWidth();
-		_frame->height = frame->GetHeight();
-		_frame->pts = frame->GetPts();
-		_frame->pkt_duration = frame->GetDuration();
-
-		_frame->linesize[0] = frame->GetStride(0);
-		_frame->linesize[1] = frame->GetStride(1);
-		_frame->linesize[2] = frame->GetStride(2);
+		int ret = 0;
 
-		int ret = ::av_frame_get_buffer(_frame, 32);
-		if (ret < 0)
+		// If the decoder passed the frame by reference, feed it to the filter graph as it is
+		if (TranscodeFrameReference::Reference(_frame, frame.get()) == false)
 		{
-			logte("Could not allocate the video frame data\n");
-			break;
-		}
+			_frame->format = frame->GetFormat();
+			_frame->width = frame->GetWidth();
+			_frame->height = frame->GetHeight();
+			_frame->pts = frame->GetPts();
+			_frame->pkt_duration = frame->GetDuration();
+
+			_frame->linesize[0] = frame->GetStride(0);
+			_frame->linesize[1] = frame->GetStride(1);
+			_frame->linesize[2] = frame->GetStride(2);
+
+			ret = ::av_frame_get_buffer(_frame, 32);
+			if (ret < 0)
+			{
+				logte("Could not allocate the video frame data\n");
+				break;
+			}
 
-		ret = ::av_frame_make_writable(_frame);
-		if (ret < 0)
-		{
-			logte("Could not make writable frame. error(%d)", ret);
-			break;
-		}
+			ret = ::av_frame_make_writable(_frame);
+			if (ret < 0)
+			{
+				logte("Could not make writable frame. error(%d)", ret);
+				break;
+			}
 
-		// Copy data of frame to _frame
-		::memcpy(_frame->data[0], frame->GetBuffer(0), frame->GetBufferSize(0));
-		::memcpy(_frame->data[1], frame->GetBuffer(1), frame->GetBufferSize(1));
-		::memcpy(_frame->data[2], frame->GetBuffer(2), frame->GetBufferSize(2));
+			// Copy data of frame to _frame
+			::memcpy(_frame->data[0], frame->GetBuffer(0), frame->GetBufferSize(0));
+			::memcpy(_frame->data[1], frame->GetBuffer(1), frame->GetBufferSize(1));
+			::memcpy(_frame->data[2], frame->GetBuffer(2), frame->GetBufferSize(2));
+		}
 
 		ret = ::av_buffersrc_add_frame_flags(_buffersrc_ctx, _frame, AV_BUFFERSRC_FLAG_KEEP_REF);
 		::av_frame_unref(_frame);
@@ -282,19 +278,28 @@ void MediaFilterRescaler::ThreadFilter()
 				output_frame->SetPts((_frame->pts == AV_NOPTS_VALUE) ? -1LL : _frame->pts);
 				output_frame->SetDuration(_frame->pkt_duration);
 
-				output_frame->SetStride(_frame->linesize[0], 0);
-				output_frame->SetStride(_frame->linesize[1], 1);
-				output_frame->SetStride(_frame->linesize[2], 2);
+				// Pass the rescaled frame to the encoder by reference
+				if (TranscodeFrameReference::Attach(output_frame.get(), _frame) == false)
+				{
+					output_frame->SetStride(_frame->linesize[0], 0);
+					output_frame->SetStride(_frame->linesize[1], 1);
+					output_frame->SetStride(_frame->linesize[2], 2);
 
-				output_frame->SetBuffer(_frame->data[0], output_frame->GetStride(0) * output_frame->GetHeight(), 0);	  // Y-Plane
-				output_frame->SetBuffer(_frame->data[1], output_frame->GetStride(1) * output_frame->GetHeight() / 2, 1);  // Cb Plane
-				output_frame->SetBuffer(_frame->data[2], output_frame->GetStride(2) * output_frame->GetHeight() / 2, 2);  // Cr Plane
+					output_frame->SetBuffer(_frame->data[0], output_frame->GetStride(0) * output_frame->GetHeight(), 0);	  // Y-Plane
+					output_frame->SetBuffer(_frame->data[1], output_frame->GetStride(1) * output_frame->GetHeight() / 2, 1);  // Cb Plane
+					output_frame->SetBuffer(_frame->data[2], output_frame->GetStride(2) * output_frame->GetHeight() / 2, 2);  // Cr Plane
+				}
 
 				//logtp("Rescaled data: %lld (%.0f)\n%s", output_frame->GetPts(), output_frame->GetPts() * _output_context->GetTimeBase().GetExpr() * 1000.0f, ov::Dump(_frame->data[0], _frame->linesize[0], 32).CStr());
 
 				::av_frame_unref(_frame);
 
 				_output_buffer.Enqueue(std::move(output_frame));
+
+				if (OnCompleteHandler)
+				{
+					OnCompleteHandler();
+				}
 			}
 		}
 	}
@@ -59,6 +59,14 @@ std::shared_ptr<MediaFrame> TranscodeFilter::RecvBuffer(TranscodeResult *result)
 	return _impl->RecvBuffer(result);
 }
 
+void TranscodeFilter::Stop()
+{
+	if (_impl != nullptr)
+	{
+		_impl->Stop();
+	}
+}
+
 uint32_t TranscodeFilter::GetInputBufferSize()
 {
 	return _impl->GetInputBufferSize();
@@ -77,4 +85,14 @@ cmn::Timebase TranscodeFilter::GetInputTimebase() const
 cmn::Timebase TranscodeFilter::GetOutputTimebase() const
 {
 	return _impl->GetOutputTimebase();
-}
\ No newline at end of file
+}
+
+void TranscodeFilter::SetAffinityHint(uint32_t hint)
+{
+	_impl->SetAffinityHint(hint);
+}
+
+void TranscodeFilter::SetOnCompleteHandler(MediaFilterImpl::_cb_func func)
+{
+	_impl->SetOnCompleteHandler(std::move(func));
+}
@@ -30,12 +30,17 @@ public:
 	int32_t SendBuffer(std::shared_ptr<MediaFrame> buffer);
 	std::shared_ptr<MediaFrame> RecvBuffer(TranscodeResult *result);
 
+	void Stop();
+
 	uint32_t GetInputBufferSize();
 	uint32_t GetOutputBufferSize();
 
 	cmn::Timebase GetInputTimebase() const;
 	cmn::Timebase GetOutputTimebase() const;
 
+	void SetAffinityHint(uint32_t hint);
+	void SetOnCompleteHandler(MediaFilterImpl::_cb_func func);
+
 private:
 	MediaFilterImpl *_impl;
 };
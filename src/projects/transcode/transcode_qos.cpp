@@ -0,0 +1,99 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "transcode_qos.h"
+
+#include "transcode_private.h"
+
+TranscodeQos::TranscodeQos()
+{
+	_level_timer.Start();
+}
+
+void TranscodeQos::SetName(const ov::String &name)
+{
+	_name = name;
+}
+
+void TranscodeQos::SetDropLevel(int drop_level, int64_t lag)
+{
+	if (drop_level > _drop_level)
+	{
+		logtw("[%s] Transcoding is delayed (lag: %" PRId64 "ms), frame rate is lowered to 1/%d (dropped frames: %" PRIu64 ")",
+			  _name.CStr(), lag, drop_level + 1, _dropped_frame_count);
+	}
+	else
+	{
+		logti("[%s] Transcoding is recovered (lag: %" PRId64 "ms), frame rate is restored to 1/%d (dropped frames: %" PRIu64 ")",
+			  _name.CStr(), lag, drop_level + 1, _dropped_frame_count);
+	}
+
+	_drop_level = drop_level;
+	_level_timer.Start();
+}
+
+bool TranscodeQos::OnFrame(int64_t lag)
+{
+	// Drain the pending frames first if the lag is too large to be solved by lowering the frame rate
+	if (lag >= TRANSCODE_QOS_CRITICAL_LAG)
+	{
+		if (_is_draining == false)
+		{
+			logtw("[%s] Transcoding is overloaded (lag: %" PRId64 "ms), drop the frames until the pending frames are processed", _name.CStr(), lag);
+			_is_draining = true;
+		}
+	}
+	else if (_is_draining && (lag < TRANSCODE_QOS_HIGH_LAG))
+	{
+		_is_draining = false;
+
+		// Continue at the lowest frame rate, and restore it gradually
+		SetDropLevel(TRANSCODE_QOS_MAX_DROP_LEVEL, lag);
+	}
+
+	if (_is_draining == false)
+	{
+		if (lag >= TRANSCODE_QOS_HIGH_LAG)
+		{
+			_is_low_lag = false;
+
+			if ((_drop_level < TRANSCODE_QOS_MAX_DROP_LEVEL) && _level_timer.IsElapsed(TRANSCODE_QOS_DEGRADE_INTERVAL))
+			{
+				SetDropLevel(_drop_level + 1, lag);
+			}
+		}
+		else if (lag <= TRANSCODE_QOS_LOW_LAG)
+		{
+			if (_is_low_lag == false)
+			{
+				_is_low_lag = true;
+				_low_lag_timer.Start();
+			}
+
+			if ((_drop_level > 0) && _low_lag_timer.IsElapsed(TRANSCODE_QOS_RECOVER_INTERVAL) && _level_timer.IsElapsed(TRANSCODE_QOS_RECOVER_INTERVAL))
+			{
+				SetDropLevel(_drop_level - 1, lag);
+			}
+		}
+		else
+		{
+			_is_low_lag = false;
+		}
+	}
+
+	bool is_passed = (_is_draining == false) && ((_frame_count % (_drop_level + 1)) == 0);
+
+	_frame_count++;
+
+	if (is_passed == false)
+	{
+		_dropped_frame_count++;
+	}
+
+	return is_passed;
+}
@@ -0,0 +1,69 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+// If the lag of the filters/encoders exceeds this value, the frame rate is lowered by one level (in milliseconds)
+#define TRANSCODE_QOS_HIGH_LAG 500
+// If the lag stays below this value, the frame rate is restored by one level (in milliseconds)
+#define TRANSCODE_QOS_LOW_LAG 150
+// If the lag exceeds this value, all frames are dropped until the lag goes below TRANSCODE_QOS_HIGH_LAG (in milliseconds)
+#define TRANSCODE_QOS_CRITICAL_LAG 2000
+// The level is changed at most once per this time, so that the previous level takes effect (in milliseconds)
+#define TRANSCODE_QOS_DEGRADE_INTERVAL 1000
+#define TRANSCODE_QOS_RECOVER_INTERVAL 5000
+// At level N, 1 of (N + 1) frames is passed to the encoder
+#define TRANSCODE_QOS_MAX_DROP_LEVEL 3
+
+// Lowers the frame rate of a video encoder when the filters/encoders of a stream can't keep up.
+//
+// The frames are dropped at the input of the encoder, after the "fps" filter of the rescaler (which would fill the gap
+// of a frame dropped before it with a duplicate). The decoder still decodes all frames, so the reference chain of
+// the input is not broken, and the frames are decimated evenly, so the encoder keeps producing regular GOPs.
+class TranscodeQos
+{
+public:
+	TranscodeQos();
+
+	// @param name The name of the stage to use in the logs
+	void SetName(const ov::String &name);
+
+	// @param lag The time to process the frames pending in the encoder and the filters before it (in milliseconds)
+	// @return true if the frame should be passed to the encoder, false if it should be dropped
+	bool OnFrame(int64_t lag);
+
+	int GetDropLevel() const
+	{
+		return _drop_level;
+	}
+
+	uint64_t GetDroppedFrameCount() const
+	{
+		return _dropped_frame_count;
+	}
+
+private:
+	void SetDropLevel(int drop_level, int64_t lag);
+
+	ov::String _name;
+
+	int _drop_level = 0;
+	// All frames are dropped until the lag goes below TRANSCODE_QOS_HIGH_LAG
+	bool _is_draining = false;
+
+	uint64_t _frame_count = 0;
+	uint64_t _dropped_frame_count = 0;
+
+	// Elapsed time since the level was changed
+	ov::StopWatch _level_timer;
+	// Elapsed time since the lag went below TRANSCODE_QOS_LOW_LAG
+	ov::StopWatch _low_lag_timer;
+	bool _is_low_lag = false;
+};
@@ -10,6 +10,9 @@
 #include "transcode_stream.h"
 
 #include <config/config_manager.h>
+#include <monitoring/monitoring.h>
+
+#include <algorithm>
 
 #include "transcode_application.h"
 #include "transcode_private.h"
@@ -40,8 +43,7 @@ TranscodeStream::~TranscodeStream()
 	}
 
 	// Delete all encoders, filters, decodres
-	_encoders.clear();
-	_filters.clear();
+	std::atomic_store(&_stage_graph, std::make_shared<const StageGraph>());
 	_decoders.clear();
 
 	// Delete all map of stage
@@ -98,13 +100,17 @@ bool TranscodeStream::Start()
 		logti("No decoder generated");
 	}
 
+	// The on-demand output streams are not encoded until they're played
+	UpdateParkedEncoders();
+	_on_demand_timer.Start();
+
 	_kill_flag = false;
 
 	// Notify to create a new stream on the media router.
 	NotifyCreateStreams();
 
 	logti("[%s/%s(%u)] Transcoder input stream has been started. Status : (%d) Decoders, (%d) Encoders",
-		  _application_info.GetName().CStr(), _input_stream->GetName().CStr(), _input_stream->GetId(), _decoders.size(), _encoders.size());
+		  _application_info.GetName().CStr(), _input_stream->GetName().CStr(), _input_stream->GetId(), _decoders.size(), std::atomic_load(&_stage_graph)->encoders.size());
 
 	return true;
 }
@@ -115,26 +121,30 @@ bool TranscodeStream::Stop()
 
 	logtd("Wait for terminated trancode stream thread. kill_flag(%s)", _kill_flag ? "true" : "false");
 
-	// Stop all encoders
-	for (auto &iter : _encoders)
+	// Stop the stages from the upstream, so that a running stage doesn't pass the frames to the stopped stage
+
+	// Stop all decoder
+	for (auto &it : _decoders)
 	{
-		auto object = iter.second;
+		auto object = it.second;
 		object->Stop();
 		object.reset();
 	}
 
+	auto graph = std::atomic_load(&_stage_graph);
+
 	// Stop all filters
-	for (auto &it : _filters)
+	for (auto &it : graph->filters)
 	{
 		auto object = it.second;
-
+		object->Stop();
 		object.reset();
 	}
 
-	// Stop all decoder
-	for (auto &it : _decoders)
+	// Stop all encoders
+	for (auto &iter : graph->encoders)
 	{
-		auto object = it.second;
+		auto object = iter.second;
 		object->Stop();
 		object.reset();
 	}
@@ -151,6 +161,8 @@ bool TranscodeStream::Push(std::shared_ptr<MediaPacket> packet)
 {
 	int32_t track_id = packet->GetTrackId();
 
+	UpdateOnDemandStreams();
+
 	DecodePacket(track_id, std::move(packet));
 
 	return true;
@@ -487,6 +499,16 @@ int32_t TranscodeStream::CreateOutputStreams()
 		// Add to Output Stream List. The key is the output stream name.
 		_output_streams.insert(std::make_pair(output_stream->GetName(), output_stream));
 
+		if (cfg_output_profile.IsOnDemand())
+		{
+			OnDemandStream on_demand_stream;
+
+			on_demand_stream.stream = output_stream;
+			on_demand_stream.idle_timeout = cfg_output_profile.GetOnDemandIdleTimeout();
+
+			_on_demand_streams.push_back(on_demand_stream);
+		}
+
 		logti("[%s/%s(%u)] -> [%s/%s(%u)] Output stream has been created.",
 			  _application_info.GetName().CStr(), _input_stream->GetName().CStr(), _input_stream->GetId(),
 			  _application_info.GetName().CStr(), output_stream->GetName().CStr(), output_stream->GetId());
@@ -758,6 +780,7 @@ bool TranscodeStream::CreateDecoder(int32_t input_track_id, int32_t decoder_trac
 	}
 
 	decoder->SetTrackId(decoder_track_id);
+	decoder->SetAffinityHint(GetStreamId());
 	decoder->SetOnCompleteHandler(bind(&TranscodeStream::OnDecodedPacket, this, std::placeholders::_1, std::placeholders::_2));
 
 	_decoders[decoder_track_id] = std::move(decoder);
@@ -765,7 +788,7 @@ bool TranscodeStream::CreateDecoder(int32_t input_track_id, int32_t decoder_trac
 	return true;
 }
 
-int32_t TranscodeStream::CreateEncoders(MediaTrackId track_id)
+int32_t TranscodeStream::CreateEncoders(StageGraph &graph, MediaTrackId track_id)
 {
 	int32_t created_encoder_count = 0;
 
@@ -802,7 +825,7 @@ int32_t TranscodeStream::CreateEncoders(MediaTrackId track_id)
 					track->GetHeight(),
 					track->GetFrameRate());
 
-				CreateEncoder(encoder_track_id, encoder_context);
+				CreateEncoder(graph, encoder_track_id, encoder_context);
 				created_encoder_count++;
 			}
 			break;
@@ -813,7 +836,7 @@ int32_t TranscodeStream::CreateEncoders(MediaTrackId track_id)
 					track->GetBitrate(),
 					track->GetSampleRate());
 
-				CreateEncoder(encoder_track_id, encoder_context);
+				CreateEncoder(graph, encoder_track_id, encoder_context);
 				created_encoder_count++;
 			}
 			break;
@@ -827,7 +850,7 @@ int32_t TranscodeStream::CreateEncoders(MediaTrackId track_id)
 	return created_encoder_count;
 }
 
-bool TranscodeStream::CreateEncoder(int32_t encoder_track_id, std::shared_ptr<TranscodeContext> output_context)
+bool TranscodeStream::CreateEncoder(StageGraph &graph, int32_t encoder_track_id, std::shared_ptr<TranscodeContext> output_context)
 {
 	// create encoder for codec id
 	auto encoder = std::move(TranscodeEncoder::CreateEncoder(output_context->GetCodecId(), output_context));
@@ -838,9 +861,160 @@ bool TranscodeStream::CreateEncoder(int32_t encoder_track_id, std::shared_ptr<Tr
 	}
 
 	encoder->SetTrackId(encoder_track_id);
-	encoder->SetOnCompleteHandler(bind(&TranscodeStream::OnEncodedPacket, this, std::placeholders::_1));
+	encoder->SetAffinityHint(GetStreamId());
+	// The handler is owned by the encoder, so the raw pointer is valid while it is called
+	encoder->SetOnCompleteHandler(bind(&TranscodeStream::OnEncodedPacket, this, std::placeholders::_1, encoder.get()));
+
+	graph.encoders[encoder_track_id] = std::move(encoder);
+
+	if (output_context->GetMediaType() == cmn::MediaType::Video)
+	{
+		auto qos = std::make_shared<TranscodeQos>();
+
+		qos->SetName(ov::String::FormatString("%s/%s(%u) #%d", _application_info.GetName().CStr(), _input_stream->GetName().CStr(), _input_stream->GetId(), encoder_track_id));
+
+		graph.encoder_qos[encoder_track_id] = std::move(qos);
+	}
+
+	return true;
+}
+
+void TranscodeStream::UpdateOnDemandStreams()
+{
+	if (_on_demand_streams.empty() || (_on_demand_timer.IsElapsed(TRANSCODE_ON_DEMAND_CHECK_INTERVAL) == false))
+	{
+		return;
+	}
+
+	_on_demand_timer.Update();
+
+	bool is_changed = false;
+
+	for (auto &on_demand_stream : _on_demand_streams)
+	{
+		auto stream_metrics = StreamMetrics(*on_demand_stream.stream);
+		bool is_demanded = (stream_metrics != nullptr) && stream_metrics->IsDemanded(on_demand_stream.idle_timeout);
+
+		if (is_demanded == on_demand_stream.is_active)
+		{
+			continue;
+		}
+
+		on_demand_stream.is_active = is_demanded;
+		is_changed = true;
+
+		logti("[%s/%s(%u)] Output stream has been %s",
+			  _application_info.GetName().CStr(), on_demand_stream.stream->GetName().CStr(), on_demand_stream.stream->GetId(),
+			  is_demanded ? "resumed by a request" : "parked (idle)");
+	}
+
+	if (is_changed)
+	{
+		UpdateParkedEncoders();
+	}
+}
+
+void TranscodeStream::UpdateParkedEncoders()
+{
+	auto parked_encoders = std::make_shared<std::set<MediaTrackId>>();
+
+	for (auto &[encoder_id, output_list] : _stage_encoder_to_output)
+	{
+		// An encoder is parked only if none of its output streams is played
+		bool is_parked = std::all_of(output_list.begin(), output_list.end(), [this](const auto &output) {
+			for (auto &on_demand_stream : _on_demand_streams)
+			{
+				if (on_demand_stream.stream == output.first)
+				{
+					return (on_demand_stream.is_active == false);
+				}
+			}
+
+			return false;
+		});
+
+		if (is_parked && (output_list.empty() == false))
+		{
+			parked_encoders->insert(encoder_id);
+		}
+	}
+
+	auto prev_parked_encoders = std::atomic_load(&_parked_encoders);
+	std::atomic_store(&_parked_encoders, std::shared_ptr<const std::set<MediaTrackId>>(parked_encoders));
+
+	auto graph = std::atomic_load(&_stage_graph);
+
+	// The resumed encoders start with a key frame, so the new players don't wait for the next GOP
+	for (auto &encoder_id : *prev_parked_encoders)
+	{
+		if (parked_encoders->find(encoder_id) != parked_encoders->end())
+		{
+			continue;
+		}
+
+		auto encoder_item = graph->encoders.find(encoder_id);
+		if (encoder_item != graph->encoders.end())
+		{
+			encoder_item->second->RequestKeyFrame();
+		}
+	}
+}
+
+bool TranscodeStream::IsFilterParked(const StageGraph &graph, const std::set<MediaTrackId> &parked_encoders, MediaTrackId filter_id)
+{
+	auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+	if ((encoder_id_item != _stage_filter_to_encoder.end()) && (parked_encoders.find(encoder_id_item->second) == parked_encoders.end()))
+	{
+		return false;
+	}
 
-	_encoders[encoder_track_id] = std::move(encoder);
+	// The merged filters and the child filters use the output of this filter
+	auto merged_filter_item = graph.filter_to_merged_filter.find(filter_id);
+	if (merged_filter_item != graph.filter_to_merged_filter.end())
+	{
+		for (auto &merged_filter_id : merged_filter_item->second)
+		{
+			if (IsFilterParked(graph, parked_encoders, merged_filter_id) == false)
+			{
+				return false;
+			}
+		}
+	}
+
+	auto child_filter_item = graph.filter_to_child_filter.find(filter_id);
+	if (child_filter_item != graph.filter_to_child_filter.end())
+	{
+		for (auto &child_filter_id : child_filter_item->second)
+		{
+			if (IsFilterParked(graph, parked_encoders, child_filter_id) == false)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool TranscodeStream::IsDecoderParked(MediaTrackId decoder_id)
+{
+	auto filter_item = _stage_decoder_to_filter.find(decoder_id);
+	if ((filter_item == _stage_decoder_to_filter.end()) || filter_item->second.empty())
+	{
+		return false;
+	}
+
+	auto parked_encoders = std::atomic_load(&_parked_encoders);
+
+	// The scaler tree is built after the first frame is decoded, so check the encoders of all filters of the decoder instead
+	for (auto &filter_id : filter_item->second)
+	{
+		auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+		if ((encoder_id_item == _stage_filter_to_encoder.end()) || (parked_encoders->find(encoder_id_item->second) == parked_encoders->end()))
+		{
+			return false;
+		}
+	}
 
 	return true;
 }
@@ -974,11 +1148,54 @@ void TranscodeStream::ChangeOutputFormat(MediaFrame *buffer)
 	// Udpate Track of Output Stream
 	UpdateOutputTrack(buffer);
 
-	// Create Encoder
-	CreateEncoders(buffer->GetTrackId());
+	std::shared_ptr<const StageGraph> old_graph;
+	std::shared_ptr<const StageGraph> new_graph;
+
+	{
+		std::lock_guard<std::mutex> lock(_stage_graph_mutex);
+
+		// The workers of the filters/encoders keep using the current graph until the new one is published
+		old_graph = std::atomic_load(&_stage_graph);
+		auto graph = std::make_shared<StageGraph>(*old_graph);
+
+		// Create Encoder
+		CreateEncoders(*graph, buffer->GetTrackId());
 
-	// Craete Filter
-	CreateFilter(buffer);
+		// Craete Filter
+		CreateFilter(*graph, buffer);
+
+		new_graph = graph;
+		std::atomic_store(&_stage_graph, new_graph);
+	}
+
+	// Stop the replaced stages here (on the worker of the decoder), and wait until their workers finish.
+	// If a replaced stage were released by its own worker (the last reference of the old graph is dropped
+	// while the stage is running), its destructor would wait for the worker itself.
+	StopReplacedStages(*old_graph, *new_graph);
+}
+
+void TranscodeStream::StopReplacedStages(const StageGraph &old_graph, const StageGraph &new_graph)
+{
+	// Stop the filters first, so that a running filter doesn't pass the frames to the stopped encoder
+	for (auto &[filter_id, filter] : old_graph.filters)
+	{
+		auto filter_item = new_graph.filters.find(filter_id);
+
+		if ((filter_item == new_graph.filters.end()) || (filter_item->second != filter))
+		{
+			filter->Stop();
+		}
+	}
+
+	for (auto &[encoder_id, encoder] : old_graph.encoders)
+	{
+		auto encoder_item = new_graph.encoders.find(encoder_id);
+
+		if ((encoder_item == new_graph.encoders.end()) || (encoder_item->second != encoder))
+		{
+			encoder->Stop();
+		}
+	}
 }
 
 void TranscodeStream::DecodePacket(int32_t track_id, std::shared_ptr<MediaPacket> packet)
@@ -1035,6 +1252,27 @@ void TranscodeStream::DecodePacket(int32_t track_id, std::shared_ptr<MediaPacket
 	}
 	auto decoder = decoder_item->second.get();
 
+	if (IsDecoderParked(decoder_id))
+	{
+		// Nobody is playing the outputs of the decoder
+		_parked_decoders.insert(decoder_id);
+		return;
+	}
+
+	auto parked_decoder = _parked_decoders.find(decoder_id);
+	if (parked_decoder != _parked_decoders.end())
+	{
+		auto input_track = _input_stream->GetTrack(track_id);
+
+		// Resume decoding from a key frame, the decoder can't decode the frames that refer to the dropped frames
+		if ((input_track != nullptr) && (input_track->GetMediaType() == cmn::MediaType::Video) && (packet->GetFlag() != MediaPacketFlag::Key))
+		{
+			return;
+		}
+
+		_parked_decoders.erase(parked_decoder);
+	}
+
 	logtp("[#%3d] Decode In.  PTS: %lld, SIZE: %lld",
 		  track_id,
 		  (int64_t)(packet->GetPts() * decoder->GetTimebase().GetExpr() * 1000),
@@ -1089,16 +1327,21 @@ void TranscodeStream::OnDecodedPacket(TranscodeResult result, int32_t decoder_id
 	}
 }
 
-TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<MediaFrame> decoded_frame)
+TranscodeResult TranscodeStream::FilterFrame(const StageGraph &graph, int32_t track_id, std::shared_ptr<MediaFrame> decoded_frame)
 {
-	auto filter_item = _filters.find(track_id);
-	if (filter_item == _filters.end())
+	auto filter_item = graph.filters.find(track_id);
+	if (filter_item == graph.filters.end())
 	{
 		return TranscodeResult::NoData;
 	}
 
 	auto filter = filter_item->second.get();
 
+	if (IsFilterParked(graph, *std::atomic_load(&_parked_encoders), track_id))
+	{
+		return TranscodeResult::NoData;
+	}
+
 	logtp("[#%3d] Filter In.  PTS: %lld, SIZE: %lld",
 		  track_id,
 		  (int64_t)(decoded_frame->GetPts() * filter->GetInputTimebase().GetExpr() * 1000),
@@ -1106,6 +1349,23 @@ TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<M
 
 	filter->SendBuffer(std::move(decoded_frame));
 
+	// The filtered frames are passed to OnFilteredFrame() by the filter
+	return TranscodeResult::NoData;
+}
+
+// Callback is called from the filter for frames that have been filtered.
+TranscodeResult TranscodeStream::OnFilteredFrame(int32_t filter_id, TranscodeFilter *filter)
+{
+	auto graph = std::atomic_load(&_stage_graph);
+
+	// If the filter has been replaced by ChangeOutputFormat(), its frames are in the previous format and are dropped.
+	// The filter is stopped soon.
+	auto filter_item = graph->filters.find(filter_id);
+	if ((filter_item == graph->filters.end()) || (filter_item->second.get() != filter))
+	{
+		return TranscodeResult::NoData;
+	}
+
 	while (true)
 	{
 		TranscodeResult result;
@@ -1119,15 +1379,38 @@ TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<M
 		switch (result)
 		{
 			case TranscodeResult::DataReady: {
-				filtered_frame->SetTrackId(track_id);
+				filtered_frame->SetTrackId(filter_id);
 
 				logtp("[#%3d] Filter Out. PTS: %lld, SIZE: %lld",
-					  track_id,
+					  filter_id,
 					  (int64_t)(filtered_frame->GetPts() * filter->GetOutputTimebase().GetExpr() * 1000),
 					  filtered_frame->GetBufferSize());
 
-				int32_t filter_id = filtered_frame->GetTrackId();
-				EncodeFrame(filter_id, std::move(filtered_frame));
+				// Pass the frame to the filters that scale it down further
+				auto child_filter_item = graph->filter_to_child_filter.find(filter_id);
+				if (child_filter_item != graph->filter_to_child_filter.end())
+				{
+					for (auto &child_filter_id : child_filter_item->second)
+					{
+						auto frame_clone = filtered_frame->CloneFrame();
+						if (frame_clone != nullptr)
+						{
+							FilterFrame(*graph, child_filter_id, std::move(frame_clone));
+						}
+					}
+				}
+
+				// The encoders of the merged filters share the frame
+				auto merged_filter_item = graph->filter_to_merged_filter.find(filter_id);
+				if (merged_filter_item != graph->filter_to_merged_filter.end())
+				{
+					for (auto &merged_filter_id : merged_filter_item->second)
+					{
+						EncodeFrame(*graph, merged_filter_id, filtered_frame);
+					}
+				}
+
+				EncodeFrame(*graph, filter_id, std::move(filtered_frame));
 			}
 			break;
 
@@ -1137,18 +1420,39 @@ TranscodeResult TranscodeStream::FilterFrame(int32_t track_id, std::shared_ptr<M
 	}
 }
 
-TranscodeResult TranscodeStream::EncodeFrame(int32_t filter_id, std::shared_ptr<const MediaFrame> frame)
+TranscodeResult TranscodeStream::EncodeFrame(const StageGraph &graph, int32_t filter_id, std::shared_ptr<const MediaFrame> frame)
 {
-	auto encoder_id = _stage_filter_to_encoder[filter_id];
+	// This is called from the filters concurrently, so operator[] must not be used here
+	auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+	if (encoder_id_item == _stage_filter_to_encoder.end())
+	{
+		return TranscodeResult::NoData;
+	}
+
+	auto encoder_id = encoder_id_item->second;
+
+	auto parked_encoders = std::atomic_load(&_parked_encoders);
+	if (parked_encoders->find(encoder_id) != parked_encoders->end())
+	{
+		return TranscodeResult::NoData;
+	}
 
-	auto encoder_item = _encoders.find(encoder_id);
-	if (encoder_item == _encoders.end())
+	auto encoder_item = graph.encoders.find(encoder_id);
+	if (encoder_item == graph.encoders.end())
 	{
 		return TranscodeResult::NoData;
 	}
 
 	auto encoder = encoder_item->second.get();
 
+	// The frames are dropped here instead of before the rescaler, because the "fps" filter of the rescaler
+	// duplicates the previous frame to fill the gap of a dropped frame
+	auto qos_item = graph.encoder_qos.find(encoder_id);
+	if ((qos_item != graph.encoder_qos.end()) && (qos_item->second->OnFrame(GetPendingTime(graph, filter_id, encoder)) == false))
+	{
+		return TranscodeResult::NoData;
+	}
+
 	logtp("[#%3d] Encode In.  PTS: %lld, FLAGS: %d, SIZE: %d",
 		  encoder_id,
 		  (int64_t)(frame->GetPts() * encoder->GetTimebase().GetExpr() * 1000),
@@ -1162,16 +1466,9 @@ TranscodeResult TranscodeStream::EncodeFrame(int32_t filter_id, std::shared_ptr<
 
 // Callback is called from the encoder for packets that have been encoded.
 // @setEncodedHandler
-TranscodeResult TranscodeStream::OnEncodedPacket(int32_t encoder_id)
+TranscodeResult TranscodeStream::OnEncodedPacket(int32_t encoder_id, TranscodeEncoder *encoder)
 {
-	auto encoder_item = _encoders.find(encoder_id);
-	if (encoder_item == _encoders.end())
-	{
-		return TranscodeResult::NoData;
-	}
-
-	auto encoder = encoder_item->second.get();
-
+	// The packets of a replaced encoder are still valid, so they're sent until the encoder is stopped
 	while (true)
 	{
 		TranscodeResult result;
@@ -1254,7 +1551,7 @@ void TranscodeStream::SendFrame(std::shared_ptr<info::Stream> &stream, std::shar
 	}
 }
 
-void TranscodeStream::CreateFilter(MediaFrame *buffer)
+void TranscodeStream::CreateFilter(StageGraph &graph, MediaFrame *buffer)
 {
 	MediaTrackId track_id = buffer->GetTrackId();
 
@@ -1271,29 +1568,207 @@ void TranscodeStream::CreateFilter(MediaFrame *buffer)
 	}
 	auto filter_id_list = filter_item->second;
 
+	// Remove the filters of the previous format
+	for (auto &filter_id : filter_id_list)
+	{
+		graph.filters.erase(filter_id);
+		graph.filter_to_merged_filter.erase(filter_id);
+		graph.filter_to_child_filter.erase(filter_id);
+		graph.filter_to_parent_filter.erase(filter_id);
+	}
+	graph.decoder_to_root_filter.erase(track_id);
+
+	if (input_track->GetMediaType() == cmn::MediaType::Video)
+	{
+		CreateScalerTree(graph, track_id, input_track, input_transcode_context, filter_id_list);
+		return;
+	}
+
+	for (auto &filter_id : filter_id_list)
+	{
+		// The workers of the filters read _stage_filter_to_encoder concurrently, so operator[] must not be used here
+		auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+		if (encoder_id_item == _stage_filter_to_encoder.end())
+		{
+			continue;
+		}
+
+		auto encoder_item = graph.encoders.find(encoder_id_item->second);
+
+		if (encoder_item == graph.encoders.end())
+		{
+			logte("%d track encoder is not allocated", encoder_id_item->second);
+			continue;
+		}
+
+		if (CreateFilter(graph, filter_id, input_track, input_transcode_context, encoder_item->second->GetContext()))
+		{
+			graph.decoder_to_root_filter[track_id].push_back(filter_id);
+		}
+	}
+}
+
+bool TranscodeStream::CreateFilter(StageGraph &graph, MediaTrackId filter_id, const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<TranscodeContext> &input_context, const std::shared_ptr<TranscodeContext> &output_context)
+{
+	auto transcode_filter = std::make_shared<TranscodeFilter>();
+
+	bool ret = transcode_filter->Configure(input_track, input_context, output_context);
+	if (ret == false)
+	{
+		// TODO(soulk) : Create exception processing code if filter creation fails
+		logte("Failed to create filter");
+		return false;
+	}
+
+	transcode_filter->SetAffinityHint(GetStreamId());
+	// The handler is owned by the filter, so the raw pointer is valid while it is called
+	transcode_filter->SetOnCompleteHandler(bind(&TranscodeStream::OnFilteredFrame, this, filter_id, transcode_filter.get()));
+
+	graph.filters[filter_id] = transcode_filter;
+
+	return true;
+}
+
+// Pixel format of the frames that the rescaler outputs for the codec
+static AVPixelFormat GetRescalerPixelFormat(cmn::MediaCodecId codec_id)
+{
+	switch (codec_id)
+	{
+		case cmn::MediaCodecId::Jpeg:
+			return AV_PIX_FMT_YUVJ420P;
+
+		case cmn::MediaCodecId::Png:
+			return AV_PIX_FMT_RGBA;
+
+		default:
+			return AV_PIX_FMT_YUV420P;
+	}
+}
+
+// Returns true if the rescalers make the same frames for the contexts
+static bool IsSameRescalerOutput(const std::shared_ptr<TranscodeContext> &context1, const std::shared_ptr<TranscodeContext> &context2)
+{
+	return (context1->GetVideoWidth() == context2->GetVideoWidth()) &&
+		   (context1->GetVideoHeight() == context2->GetVideoHeight()) &&
+		   (context1->GetFrameRate() == context2->GetFrameRate()) &&
+		   (context1->GetTimeBase() == context2->GetTimeBase()) &&
+		   (GetRescalerPixelFormat(context1->GetCodecId()) == GetRescalerPixelFormat(context2->GetCodecId()));
+}
+
+// Returns true if the output of the parent can be used as the input of the child instead of the decoded frame
+static bool CanRescaleFrom(const std::shared_ptr<TranscodeContext> &parent_context, const std::shared_ptr<TranscodeContext> &child_context, const std::shared_ptr<MediaTrack> &input_track)
+{
+	auto parent_width = static_cast<int32_t>(parent_context->GetVideoWidth());
+	auto parent_height = static_cast<int32_t>(parent_context->GetVideoHeight());
+
+	return
+		// The frames dropped/duplicated by the "fps" filter of the parent must be the same
+		(parent_context->GetFrameRate() == child_context->GetFrameRate()) &&
+		(GetRescalerPixelFormat(parent_context->GetCodecId()) == AV_PIX_FMT_YUV420P) &&
+		// Only the downscaled frames are reused, so the quality doesn't become worse than scaling from the decoded frame
+		(parent_width <= input_track->GetWidth()) && (parent_height <= input_track->GetHeight()) &&
+		(parent_width >= static_cast<int32_t>(child_context->GetVideoWidth())) &&
+		(parent_height >= static_cast<int32_t>(child_context->GetVideoHeight()));
+}
+
+// Creates the rescalers of the decoder as a tree
+//
+// - The rescalers that make the same frames are merged into one rescaler
+// - A rescaler scales the output of the smallest larger rescaler instead of the decoded frame
+//
+// For example, 1080p input, 720p/480p/360p outputs:
+//     [Decoder] -> [720p] -> [480p] -> [360p]
+void TranscodeStream::CreateScalerTree(StageGraph &graph, MediaTrackId decoder_id, const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<TranscodeContext> &input_context, const std::vector<MediaTrackId> &filter_id_list)
+{
+	// [FILTER_ID, Output context]
+	std::vector<std::pair<MediaTrackId, std::shared_ptr<TranscodeContext>>> rescalers;
+
 	for (auto &filter_id : filter_id_list)
 	{
-		auto encoder_id = _stage_filter_to_encoder[filter_id];
+		auto encoder_id_item = _stage_filter_to_encoder.find(filter_id);
+		if (encoder_id_item == _stage_filter_to_encoder.end())
+		{
+			continue;
+		}
 
-		if (_encoders.find(encoder_id) == _encoders.end())
+		auto encoder_id = encoder_id_item->second;
+		auto encoder_item = graph.encoders.find(encoder_id);
+
+		if (encoder_item == graph.encoders.end())
 		{
 			logte("%d track encoder is not allocated", encoder_id);
 			continue;
 		}
 
-		auto output_transcode_context = _encoders[encoder_id]->GetContext();
+		auto &output_context = encoder_item->second->GetContext();
+
+		auto same_rescaler = std::find_if(rescalers.begin(), rescalers.end(), [&output_context](const auto &rescaler) -> bool {
+			return IsSameRescalerOutput(rescaler.second, output_context);
+		});
+
+		if (same_rescaler != rescalers.end())
+		{
+			logtd("Filter #%d is merged into filter #%d (%ux%u)", filter_id, same_rescaler->first, output_context->GetVideoWidth(), output_context->GetVideoHeight());
+
+			graph.filter_to_merged_filter[same_rescaler->first].push_back(filter_id);
+			graph.filter_to_parent_filter[filter_id] = same_rescaler->first;
+			continue;
+		}
+
+		rescalers.emplace_back(filter_id, output_context);
+	}
+
+	// Create the larger rescalers first, so that the parent is created before the children
+	std::stable_sort(rescalers.begin(), rescalers.end(), [](const auto &rescaler1, const auto &rescaler2) -> bool {
+		return (rescaler1.second->GetVideoWidth() * rescaler1.second->GetVideoHeight()) > (rescaler2.second->GetVideoWidth() * rescaler2.second->GetVideoHeight());
+	});
+
+	for (size_t index = 0; index < rescalers.size(); index++)
+	{
+		auto &[filter_id, output_context] = rescalers[index];
 
-		auto transcode_filter = std::make_shared<TranscodeFilter>();
+		// Find the smallest rescaler that can be the parent (The rescalers are sorted in descending order)
+		ssize_t parent_index = -1;
 
-		bool ret = transcode_filter->Configure(input_track, input_transcode_context, output_transcode_context);
-		if (ret == true)
+		for (size_t candidate_index = 0; candidate_index < index; candidate_index++)
 		{
-			_filters[filter_id] = transcode_filter;
+			auto &candidate = rescalers[candidate_index];
+
+			if ((graph.filters.find(candidate.first) != graph.filters.end()) && CanRescaleFrom(candidate.second, output_context, input_track))
+			{
+				parent_index = candidate_index;
+			}
 		}
-		else
+
+		if (parent_index < 0)
 		{
-			// TODO(soulk) : Create exception processing code if filter creation fails
-			logte("Failed to create filter");
+			if (CreateFilter(graph, filter_id, input_track, input_context, output_context))
+			{
+				graph.decoder_to_root_filter[decoder_id].push_back(filter_id);
+			}
+
+			continue;
+		}
+
+		auto &[parent_id, parent_context] = rescalers[parent_index];
+
+		// The output of the parent rescaler
+		auto parent_track = std::make_shared<MediaTrack>();
+		parent_track->SetId(input_track->GetId());
+		parent_track->SetMediaType(cmn::MediaType::Video);
+		parent_track->SetWidth(parent_context->GetVideoWidth());
+		parent_track->SetHeight(parent_context->GetVideoHeight());
+		parent_track->SetFormat(AV_PIX_FMT_YUV420P);
+		parent_track->SetTimeBase(parent_context->GetTimeBase());
+
+		if (CreateFilter(graph, filter_id, parent_track, parent_context, output_context))
+		{
+			logtd("Filter #%d (%ux%u) rescales the output of filter #%d (%ux%u)",
+				  filter_id, output_context->GetVideoWidth(), output_context->GetVideoHeight(),
+				  parent_id, parent_context->GetVideoWidth(), parent_context->GetVideoHeight());
+
+			graph.filter_to_child_filter[parent_id].push_back(filter_id);
+			graph.filter_to_parent_filter[filter_id] = parent_id;
 		}
 	}
 }
@@ -1303,9 +1778,11 @@ void TranscodeStream::SpreadToFilters(std::shared_ptr<MediaFrame> frame)
 	// Get decode id
 	int32_t decoder_id = frame->GetTrackId();
 
+	auto graph = std::atomic_load(&_stage_graph);
+
 	// Query filter list to forward decode frame
-	auto filter_item = _stage_decoder_to_filter.find(decoder_id);
-	if (filter_item == _stage_decoder_to_filter.end())
+	auto filter_item = graph->decoder_to_root_filter.find(decoder_id);
+	if (filter_item == graph->decoder_to_root_filter.end())
 	{
 		logtw("No filter list found");
 		return;
@@ -1320,10 +1797,45 @@ void TranscodeStream::SpreadToFilters(std::shared_ptr<MediaFrame> frame)
 			continue;
 		}
 
-		FilterFrame(filter_id, std::move(frame_clone));
+		FilterFrame(*graph, filter_id, std::move(frame_clone));
 	}
 }
 
+int64_t TranscodeStream::GetPendingTime(const StageGraph &graph, MediaTrackId filter_id, TranscodeEncoder *encoder)
+{
+	int64_t pending_frame_count = encoder->GetInputBufferSize();
+
+	// The frames pending in the filters up to the root of the scaler tree will be passed to the encoder.
+	// The merged filters are not created, their frames are pending in the filter that they're merged into.
+	auto current_filter_id = filter_id;
+
+	while (true)
+	{
+		auto transcode_filter_item = graph.filters.find(current_filter_id);
+		if (transcode_filter_item != graph.filters.end())
+		{
+			pending_frame_count += transcode_filter_item->second->GetInputBufferSize();
+		}
+
+		auto parent_filter_item = graph.filter_to_parent_filter.find(current_filter_id);
+		if (parent_filter_item == graph.filter_to_parent_filter.end())
+		{
+			break;
+		}
+
+		current_filter_id = parent_filter_item->second;
+	}
+
+	double frame_rate = encoder->GetContext()->GetFrameRate();
+	if (frame_rate <= 0.0)
+	{
+		// The frame rate is not known yet
+		frame_rate = 30.0;
+	}
+
+	return static_cast<int64_t>(pending_frame_count * 1000.0 / frame_rate);
+}
+
 uint8_t TranscodeStream::NewTrackId(cmn::MediaType media_type)
 {
 	uint8_t last_index = 0;
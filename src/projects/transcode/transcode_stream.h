@@ -12,7 +12,9 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <set>
 #include <vector>
 
 #include "base/info/stream.h"
@@ -22,9 +24,13 @@
 #include "codec/transcode_encoder.h"
 #include "transcode_context.h"
 #include "filter/transcode_filter.h"
+#include "transcode_qos.h"
 
 typedef int32_t MediaTrackId;
 
+// Interval of checking the demand of the on-demand output streams (in milliseconds)
+#define TRANSCODE_ON_DEMAND_CHECK_INTERVAL 1000
+
 class TranscodeApplication;
 
 class TranscodeTrackMapContext
@@ -95,17 +101,57 @@ private:
 	// DECODR_ID, DECODER
 	std::map<MediaTrackId, std::shared_ptr<TranscodeDecoder>> _decoders;
 
-	// Filter
-	// FILTER_ID, FILTER
-	std::map<MediaTrackId, std::shared_ptr<TranscodeFilter>> _filters;
-
-	// Encoder
-	// ENCODER_ID, ENCODER
-	std::map<MediaTrackId, std::shared_ptr<TranscodeEncoder>> _encoders;
+	// Filters, encoders and the scaler tree
+	//
+	// The worker of a decoder recreates them when the format of the decoded frames is changed, while the workers of
+	// the filters/encoders use them. So a graph is never modified once it is published. A new graph is built from
+	// a copy and replaces the current one atomically (std::atomic_load()/std::atomic_store()).
+	struct StageGraph
+	{
+		// Filter
+		// FILTER_ID, FILTER
+		std::map<MediaTrackId, std::shared_ptr<TranscodeFilter>> filters;
+
+		// Encoder
+		// ENCODER_ID, ENCODER
+		std::map<MediaTrackId, std::shared_ptr<TranscodeEncoder>> encoders;
+
+		// Scaler tree: the filters of a decoder that are actually created
+		// [DECODER_ID, FILTER_IDs] The filters that take the decoded frame
+		std::map<MediaTrackId, std::vector<MediaTrackId>> decoder_to_root_filter;
+		// [FILTER_ID, FILTER_IDs] The filters that take the output of the filter
+		std::map<MediaTrackId, std::vector<MediaTrackId>> filter_to_child_filter;
+		// [FILTER_ID, FILTER_IDs] The filters that make the same output as the filter (they're not created, and their encoders share the output of the filter)
+		std::map<MediaTrackId, std::vector<MediaTrackId>> filter_to_merged_filter;
+		// [FILTER_ID, FILTER_ID] The filter whose output is used by the filter (the parent of a child filter, or the filter that a merged filter is merged into)
+		std::map<MediaTrackId, MediaTrackId> filter_to_parent_filter;
+
+		// QoS of the video encoders (used by the worker of the filter that passes the frames to the encoder only)
+		// ENCODER_ID, QOS
+		std::map<MediaTrackId, std::shared_ptr<TranscodeQos>> encoder_qos;
+	};
+	std::shared_ptr<const StageGraph> _stage_graph = std::make_shared<StageGraph>();
+	// Held while a new graph is built, the decoders of the stream may change the format at the same time
+	std::mutex _stage_graph_mutex;
 
 	// last generated output track id.
 	uint8_t _last_track_index = 0;
 
+	// The output streams of <OnDemand> profiles, they're encoded only while they're played
+	struct OnDemandStream
+	{
+		std::shared_ptr<info::Stream> stream;
+		int64_t idle_timeout = 0;
+		bool is_active = false;
+	};
+	std::vector<OnDemandStream> _on_demand_streams;
+	ov::StopWatch _on_demand_timer;
+
+	// ENCODER_IDs that have no active output stream. Replaced atomically (std::atomic_load()/std::atomic_store()).
+	std::shared_ptr<const std::set<MediaTrackId>> _parked_encoders = std::make_shared<std::set<MediaTrackId>>();
+	// DECODER_IDs that are not decoding now. Decoding is resumed from the next key frame.
+	std::set<MediaTrackId> _parked_decoders;
+
 	volatile bool _kill_flag;
 
 	TranscodeApplication *GetParent();
@@ -127,13 +173,25 @@ private:
 	int32_t CreateDecoders();
 	bool CreateDecoder(int32_t input_track_id, int32_t decoder_track_id, std::shared_ptr<TranscodeContext> input_context);
 
-	void CreateFilter(MediaFrame *buffer);
+	// The filters/encoders are created in the graph which is not published yet
+	void CreateFilter(StageGraph &graph, MediaFrame *buffer);
+	bool CreateFilter(StageGraph &graph, MediaTrackId filter_id, const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<TranscodeContext> &input_context, const std::shared_ptr<TranscodeContext> &output_context);
+	void CreateScalerTree(StageGraph &graph, MediaTrackId decoder_id, const std::shared_ptr<MediaTrack> &input_track, const std::shared_ptr<TranscodeContext> &input_context, const std::vector<MediaTrackId> &filter_id_list);
+
+	int32_t CreateEncoders(StageGraph &graph, MediaTrackId track_id);
+	bool CreateEncoder(StageGraph &graph, int32_t encoder_track_id, std::shared_ptr<TranscodeContext> output_context);
 
-	int32_t CreateEncoders(MediaTrackId track_id);
-	bool CreateEncoder(int32_t encoder_track_id, std::shared_ptr<TranscodeContext> output_context);
+	// Parks/resumes the encoders according to the demand of the on-demand output streams
+	void UpdateOnDemandStreams();
+	void UpdateParkedEncoders();
+	// A filter is parked if all encoders that use the output of the filter are parked
+	bool IsFilterParked(const StageGraph &graph, const std::set<MediaTrackId> &parked_encoders, MediaTrackId filter_id);
+	bool IsDecoderParked(MediaTrackId decoder_id);
 
 	// Called when formatting of decoded frames is analyzed or changed.
 	void ChangeOutputFormat(MediaFrame *buffer);
+	// Stops the filters/encoders of the old graph which are not in the new graph
+	void StopReplacedStages(const StageGraph &old_graph, const StageGraph &new_graph);
 	void UpdateInputTrack(MediaFrame *buffer);
 	void UpdateOutputTrack(MediaFrame *buffer);
 	void UpdateDecoderContext(MediaTrackId track_id);
@@ -146,11 +204,15 @@ private:
 
 	// Step 2: Filter (resample/rescale the decoded frame)
 	void SpreadToFilters(std::shared_ptr<MediaFrame> frame);
-	TranscodeResult FilterFrame(int32_t track_id, std::shared_ptr<MediaFrame> frame);
+	// @return The time to process the frames pending in the encoder of the filter and in the filters of the scaler tree
+	//         that the frames pass through (in milliseconds)
+	int64_t GetPendingTime(const StageGraph &graph, MediaTrackId filter_id, TranscodeEncoder *encoder);
+	TranscodeResult FilterFrame(const StageGraph &graph, int32_t track_id, std::shared_ptr<MediaFrame> frame);
+	TranscodeResult OnFilteredFrame(int32_t filter_id, TranscodeFilter *filter);
 
 	// Step 3: Encode (Encode the filtered frame to packets)
-	TranscodeResult EncodeFrame(int32_t track_id, std::shared_ptr<const MediaFrame> frame);
-	TranscodeResult OnEncodedPacket(int32_t encoder_id);
+	TranscodeResult EncodeFrame(const StageGraph &graph, int32_t track_id, std::shared_ptr<const MediaFrame> frame);
+	TranscodeResult OnEncodedPacket(int32_t encoder_id, TranscodeEncoder *encoder);
 
 
 	// Send frame with output stream's information
@@ -0,0 +1,202 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#include "transcode_worker_pool.h"
+
+#include "transcode_private.h"
+
+static int64_t GetNowUs()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void UpdateMax(std::atomic<int64_t> &target, int64_t value)
+{
+	auto current = target.load();
+
+	while ((value > current) && (target.compare_exchange_weak(current, value) == false))
+	{
+	}
+}
+
+TranscodeWorker::TranscodeWorker(TranscodeStage stage, std::function<void()> process, std::function<bool()> has_pending_input)
+	: _stage(stage),
+	  _process(std::move(process)),
+	  _has_pending_input(std::move(has_pending_input))
+{
+}
+
+void TranscodeWorker::ScheduleIfNeeded()
+{
+	if (_is_stopped)
+	{
+		return;
+	}
+
+	if (_is_scheduled.exchange(true) == false)
+	{
+		_scheduled_time = GetNowUs();
+
+		TranscodeWorkerPool::GetInstance()->Schedule(GetSharedPtr());
+	}
+}
+
+void TranscodeWorker::Stop()
+{
+	_is_stopped = true;
+
+	// Wait until the pool finishes running this worker
+	std::lock_guard<std::mutex> process_lock(_process_mutex);
+}
+
+void TranscodeWorker::Process()
+{
+	bool has_pending_input = false;
+
+	{
+		std::lock_guard<std::mutex> process_lock(_process_mutex);
+
+		if (_is_stopped)
+		{
+			_is_scheduled = false;
+			return;
+		}
+
+		_process();
+
+		_is_scheduled = false;
+
+		// If inputs are queued after the last dequeue, ScheduleIfNeeded() may have seen _is_scheduled == true.
+		// This must be checked while holding the lock, because the stage can be released right after Stop() returns.
+		has_pending_input = _has_pending_input();
+	}
+
+	if (has_pending_input)
+	{
+		ScheduleIfNeeded();
+	}
+}
+
+TranscodeWorkerPool::TranscodeWorkerPool()
+	: ov::WorkerPool("Transcoder", TRANSCODE_WORKER_POOL_QUEUE_SIZE)
+{
+	_stats_timer.Start();
+}
+
+TranscodeWorkerPool::~TranscodeWorkerPool()
+{
+	// Run() must not be called after this object is destroyed
+	Stop();
+}
+
+const char *TranscodeWorkerPool::StringFromStage(TranscodeStage stage)
+{
+	switch (stage)
+	{
+		case TranscodeStage::Decoder:
+			return "Decoder";
+
+		case TranscodeStage::Filter:
+			return "Filter";
+
+		case TranscodeStage::Encoder:
+			return "Encoder";
+
+		case TranscodeStage::Count:
+			break;
+	}
+
+	return "Unknown";
+}
+
+void TranscodeWorkerPool::Schedule(const std::shared_ptr<TranscodeWorker> &worker)
+{
+	_stage_counters[static_cast<size_t>(worker->GetStage())].queue_depth++;
+
+	ov::WorkerPool::Schedule(worker, worker->GetAffinityHint());
+}
+
+void TranscodeWorkerPool::Run(size_t index, const std::shared_ptr<ov::WorkerPoolJob> &job)
+{
+	if (index == 0)
+	{
+		LogStatsIfNeeded();
+	}
+
+	auto worker = std::static_pointer_cast<TranscodeWorker>(job);
+	auto &counter = _stage_counters[static_cast<size_t>(worker->GetStage())];
+	auto start_time = GetNowUs();
+	auto wait_time = start_time - worker->GetScheduledTime();
+
+	counter.queue_depth--;
+
+	counter.total_wait_time += wait_time;
+	UpdateMax(counter.max_wait_time, wait_time);
+
+	worker->Process();
+
+	auto process_time = GetNowUs() - start_time;
+
+	counter.total_process_time += process_time;
+	UpdateMax(counter.max_process_time, process_time);
+
+	counter.run_count++;
+}
+
+TranscodeStageStats TranscodeWorkerPool::GetStageStats(TranscodeStage stage) const
+{
+	TranscodeStageStats stats;
+
+	if (stage >= TranscodeStage::Count)
+	{
+		OV_ASSERT2(false);
+		return stats;
+	}
+
+	auto &counter = _stage_counters[static_cast<size_t>(stage)];
+
+	stats.queue_depth = counter.queue_depth;
+	stats.run_count = counter.run_count;
+
+	stats.max_wait_time = counter.max_wait_time;
+	stats.max_process_time = counter.max_process_time;
+
+	if (stats.run_count > 0)
+	{
+		stats.average_wait_time = counter.total_wait_time / static_cast<int64_t>(stats.run_count);
+		stats.average_process_time = counter.total_process_time / static_cast<int64_t>(stats.run_count);
+	}
+
+	return stats;
+}
+
+void TranscodeWorkerPool::LogStatsIfNeeded()
+{
+	if (_stats_timer.IsElapsed(TRANSCODE_WORKER_POOL_STATS_INTERVAL) == false)
+	{
+		return;
+	}
+
+	_stats_timer.Update();
+
+	ov::String message;
+
+	for (size_t index = 0; index < static_cast<size_t>(TranscodeStage::Count); index++)
+	{
+		auto stage = static_cast<TranscodeStage>(index);
+		auto stats = GetStageStats(stage);
+
+		message.AppendFormat(
+			"\n\t%s: queue depth: %" PRId64 ", run: %" PRIu64 ", wait: %" PRId64 "us (max: %" PRId64 "us), process: %" PRId64 "us (max: %" PRId64 "us)",
+			StringFromStage(stage), stats.queue_depth, stats.run_count,
+			stats.average_wait_time, stats.max_wait_time,
+			stats.average_process_time, stats.max_process_time);
+	}
+
+	logtd("Transcode worker pool statistics (threads: %zu):%s", _threads.size(), message.CStr());
+}
@@ -0,0 +1,147 @@
+//==============================================================================
+//
+//  Transcode
+//
+//  Created by Hyunjun Jang
+//  Copyright (c) 2021 AirenSoft. All rights reserved.
+//
+//==============================================================================
+#pragma once
+
+#include <base/ovlibrary/ovlibrary.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// The capacity of the ring of each pool thread. A stage is queued at most once, and a core can't keep up with
+// more than a few hundred pending stages anyway. Beyond that, the stages wait in the overflow list.
+#define TRANSCODE_WORKER_POOL_QUEUE_SIZE 256
+// Interval of logging the statistics of the stages (in milliseconds)
+#define TRANSCODE_WORKER_POOL_STATS_INTERVAL (60 * 1000)
+
+enum class TranscodeStage : uint8_t
+{
+	Decoder,
+	Filter,
+	Encoder,
+
+	Count
+};
+
+struct TranscodeStageStats
+{
+	// The number of workers waiting for a pool thread
+	int64_t queue_depth = 0;
+	// The number of times the workers were run
+	uint64_t run_count = 0;
+
+	// Time from the worker was scheduled until it started running (Unit: microseconds)
+	int64_t average_wait_time = 0;
+	int64_t max_wait_time = 0;
+
+	// Time taken to process the queued inputs of a worker (Unit: microseconds)
+	int64_t average_process_time = 0;
+	int64_t max_process_time = 0;
+};
+
+// A decoder, filter or encoder which is run by TranscodeWorkerPool.
+//
+// The stage enqueues an input to its own queue, and calls ScheduleIfNeeded(). A worker is run by only one thread at a time,
+// so the stage doesn't need to care about the concurrency of its codec context.
+class TranscodeWorker : public ov::EnableSharedFromThis<TranscodeWorker>, public ov::WorkerPoolJob
+{
+public:
+	// @param process Processes the queued inputs
+	// @param has_pending_input Returns true if there are inputs to process
+	TranscodeWorker(TranscodeStage stage, std::function<void()> process, std::function<bool()> has_pending_input);
+	~TranscodeWorker() override = default;
+
+	TranscodeStage GetStage() const
+	{
+		return _stage;
+	}
+
+	// The workers with the same hint (the stages of a stream) prefer to run on the same thread (core)
+	void SetAffinityHint(uint32_t hint)
+	{
+		_affinity_hint = hint;
+	}
+
+	uint32_t GetAffinityHint() const
+	{
+		return _affinity_hint;
+	}
+
+	void ScheduleIfNeeded();
+
+	// Waits until the running job is finished. The worker is not run anymore after Stop() is called.
+	void Stop();
+
+	//--------------------------------------------------------------------
+	// Called by TranscodeWorkerPool
+	//--------------------------------------------------------------------
+	void Process() override;
+
+	int64_t GetScheduledTime() const
+	{
+		return _scheduled_time;
+	}
+
+private:
+	TranscodeStage _stage;
+
+	std::function<void()> _process;
+	std::function<bool()> _has_pending_input;
+
+	std::atomic<uint32_t> _affinity_hint{0};
+
+	// Whether the worker is queued to (or being run by) TranscodeWorkerPool
+	std::atomic<bool> _is_scheduled{false};
+	std::atomic<bool> _is_stopped{false};
+	// Held while the worker is being run
+	std::mutex _process_mutex;
+
+	// Unit: microseconds (steady clock)
+	std::atomic<int64_t> _scheduled_time{0};
+};
+
+// A process-wide thread pool which runs the decoders, filters and encoders of all transcode streams.
+//
+// The workers of a stream have the same affinity hint, so a frame goes decode -> filter -> encode on a warm core
+// (See ov::WorkerPool for the scheduling)
+class TranscodeWorkerPool : public ov::WorkerPool, public ov::Singleton<TranscodeWorkerPool>
+{
+public:
+	TranscodeWorkerPool();
+	~TranscodeWorkerPool() override;
+
+	void Schedule(const std::shared_ptr<TranscodeWorker> &worker);
+
+	TranscodeStageStats GetStageStats(TranscodeStage stage) const;
+
+	static const char *StringFromStage(TranscodeStage stage);
+
+protected:
+	struct StageCounter
+	{
+		std::atomic<int64_t> queue_depth{0};
+		std::atomic<uint64_t> run_count{0};
+
+		std::atomic<int64_t> total_wait_time{0};
+		std::atomic<int64_t> max_wait_time{0};
+
+		std::atomic<int64_t> total_process_time{0};
+		std::atomic<int64_t> max_process_time{0};
+	};
+
+	void Run(size_t index, const std::shared_ptr<ov::WorkerPoolJob> &job) override;
+
+	void LogStatsIfNeeded();
+
+	StageCounter _stage_counters[static_cast<size_t>(TranscodeStage::Count)];
+
+	// Used by the first thread only
+	ov::StopWatch _stats_timer;
+};